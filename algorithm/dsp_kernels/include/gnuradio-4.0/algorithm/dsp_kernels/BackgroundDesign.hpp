@@ -0,0 +1,127 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace gr::incubator::dsp_kernels {
+
+// Runs filter (re)designs on a background thread, so a retune does not stall the streaming thread. The design builds
+// the complete Result (taps, polyphase banks, FFT spectra, ...) off-thread, and the streaming thread takes over the
+// newest finished one at its next chunk boundary with poll(), which is a move. One worker per instance, started by the
+// first request(), always builds the newest request: requests arriving while it is busy replace each other, so a burst
+// of retunes costs at most one stale design. A design that throws (e.g. for settings applied in stages) is dropped
+// and the current filter stays.
+//
+// Not thread-safe itself: request(), poll() and cancel() belong to the block's own thread. Copies start with nothing
+// pending; destruction waits for a running design.
+template<typename Result>
+class BackgroundDesign {
+public:
+    BackgroundDesign() = default;
+    BackgroundDesign(const BackgroundDesign&) noexcept {}
+    BackgroundDesign(BackgroundDesign&& other) noexcept : _state(std::move(other._state)), _pending(std::exchange(other._pending, 0U)), _worker(std::move(other._worker)) {}
+    BackgroundDesign& operator=(const BackgroundDesign&) noexcept {
+        cancel();
+        return *this;
+    }
+    BackgroundDesign& operator=(BackgroundDesign&& other) noexcept {
+        _worker  = std::move(other._worker); // joins our own worker first
+        _state   = std::move(other._state);
+        _pending = std::exchange(other._pending, 0U);
+        return *this;
+    }
+
+    template<typename Design>
+    void request(Design&& design) {
+        if (_state == nullptr) {
+            _state = std::make_shared<State>();
+        }
+        {
+            std::lock_guard lock(_state->mutex);
+            _state->next = std::forward<Design>(design);
+            _pending     = ++_state->requested;
+        }
+        _state->changed.notify_all();
+        if (!_worker.joinable()) {
+            _worker = std::jthread([state = _state](std::stop_token stopToken) { run(*state, stopToken); });
+        }
+    }
+
+    // The newest requested design once it has finished successfully, without blocking.
+    [[nodiscard]] std::optional<Result> poll() noexcept {
+        if (_pending == 0U) {
+            return std::nullopt;
+        }
+        std::lock_guard lock(_state->mutex);
+        if (_state->finished < _pending) {
+            return std::nullopt;
+        }
+        _pending = 0U;
+        return std::exchange(_state->result, std::nullopt);
+    }
+
+    // Blocks until the newest requested design has finished; mainly for tests and orderly shutdown.
+    void wait() const noexcept {
+        if (_pending != 0U) {
+            std::unique_lock lock(_state->mutex);
+            _state->changed.wait(lock, [this] { return _state->finished >= _pending; });
+        }
+    }
+
+    // Forgets the pending design, e.g. after a synchronous redesign made it stale.
+    void cancel() noexcept {
+        if (_pending == 0U) {
+            return;
+        }
+        std::lock_guard lock(_state->mutex);
+        _state->next = nullptr; // not started yet: skip it altogether
+        _state->result.reset();
+        _pending = 0U;
+    }
+
+    [[nodiscard]] bool pending() const noexcept { return _pending != 0U; }
+
+private:
+    struct State {
+        std::mutex                  mutex;
+        std::condition_variable_any changed;
+        std::function<Result()>     next;           // newest request the worker has not started yet
+        std::uint64_t               requested = 0U; // number of the newest request
+        std::uint64_t               finished  = 0U; // number of the newest request the worker is done with
+        std::optional<Result>       result;         // of request `finished`, if that one succeeded
+    };
+
+    std::shared_ptr<State> _state;
+    std::uint64_t          _pending = 0U; // number of the request poll() waits for, 0 if none
+    std::jthread           _worker;       // last: stopped and joined before the rest is destroyed
+
+    static void run(State& state, std::stop_token stopToken) {
+        std::unique_lock lock(state.mutex);
+        while (state.changed.wait(lock, stopToken, [&state] { return state.next != nullptr; }) && !stopToken.stop_requested()) {
+            auto                design = std::exchange(state.next, nullptr);
+            const std::uint64_t number = state.requested;
+            lock.unlock();
+            std::optional<Result> result;
+            try {
+                result.emplace(std::invoke(design));
+            } catch (...) {
+                // dropped: the streaming thread keeps its current filter
+            }
+            lock.lock();
+            if (state.next == nullptr) { // otherwise superseded while running: build the newer request first
+                state.result   = std::move(result);
+                state.finished = number;
+            }
+            state.changed.notify_all();
+        }
+    }
+};
+
+} // namespace gr::incubator::dsp_kernels
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GR4I_DSP_KERNELS_X86 1
+#elif defined(__aarch64__) // the kernels use AArch64-only intrinsics (vfmaq_f32, vaddvq_*); ARMv7 takes the scalar path
+#include <arm_neon.h>
+#define GR4I_DSP_KERNELS_NEON 1
+#endif
+
+namespace gr::incubator::dsp_kernels {
+
+// Storage for taps: every kernel may load them with aligned vector loads from the first element on.
+inline constexpr std::size_t kTapAlignment = 64UZ;
+
+template<typename T, std::size_t Alignment = kTapAlignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment})); }
+    void             deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+    template<typename U>
+    constexpr bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+        return true;
+    }
+};
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+enum class SimdLevel { Scalar, Neon, Avx2, Avx512 };
+
+[[nodiscard]] constexpr std::string_view toString(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Neon: return "neon";
+    case SimdLevel::Avx2: return "avx2";
+    case SimdLevel::Avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+// Kernels take `n` contiguous samples and `n` taps, both running forward in memory (i.e. FIR taps stored reversed).
+// The int16 kernels accumulate exactly in 32 bits, in any order; the caller keeps sum |x[j] * h[j]| below 2^31 (see
+// FixedPoint.hpp).
+struct DotKernels {
+    float (*real)(const float* x, const float* h, std::size_t n) noexcept;
+    std::complex<float> (*complex)(const std::complex<float>* x, const float* h, std::size_t n) noexcept;
+    std::int32_t (*realInt16)(const std::int16_t* x, const std::int16_t* h, std::size_t n) noexcept;
+    std::complex<std::int32_t> (*complexInt16)(const std::complex<std::int16_t>* x, const std::int16_t* h, std::size_t n) noexcept;
+};
+
+namespace detail {
+
+// independent partial sums break the floating-point dependency chain
+template<typename T, typename C>
+[[nodiscard]] inline T dotScalar(const T* x, const C* h, std::size_t n) noexcept {
+    std::array<T, 4UZ> acc{};
+    std::size_t        j = 0UZ;
+    for (; j + 4UZ <= n; j += 4UZ) {
+        for (std::size_t lane = 0UZ; lane < 4UZ; ++lane) {
+            acc[lane] += x[j + lane] * h[j + lane];
+        }
+    }
+    for (; j < n; ++j) {
+        acc[0] += x[j] * h[j];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template<typename C>
+[[nodiscard]] inline std::complex<C> dotScalar(const std::complex<C>* x, const C* h, std::size_t n) noexcept {
+    std::array<C, 4UZ> re{};
+    std::array<C, 4UZ> im{};
+    std::size_t        j = 0UZ;
+    for (; j + 4UZ <= n; j += 4UZ) {
+        for (std::size_t lane = 0UZ; lane < 4UZ; ++lane) {
+            re[lane] += x[j + lane].real() * h[j + lane];
+            im[lane] += x[j + lane].imag() * h[j + lane];
+        }
+    }
+    for (; j < n; ++j) {
+        re[0] += x[j].real() * h[j];
+        im[0] += x[j].imag() * h[j];
+    }
+    return {(re[0] + re[1]) + (re[2] + re[3]), (im[0] + im[1]) + (im[2] + im[3])};
+}
+
+[[nodiscard]] inline std::int32_t dotRealInt16Scalar(const std::int16_t* x, const std::int16_t* h, std::size_t n) noexcept {
+    std::int32_t acc = 0;
+    for (std::size_t j = 0UZ; j < n; ++j) {
+        acc += static_cast<std::int32_t>(x[j]) * static_cast<std::int32_t>(h[j]);
+    }
+    return acc;
+}
+
+[[nodiscard]] inline std::complex<std::int32_t> dotComplexInt16Scalar(const std::complex<std::int16_t>* x, const std::int16_t* h, std::size_t n) noexcept {
+    std::int32_t re = 0;
+    std::int32_t im = 0;
+    for (std::size_t j = 0UZ; j < n; ++j) {
+        re += static_cast<std::int32_t>(x[j].real()) * static_cast<std::int32_t>(h[j]);
+        im += static_cast<std::int32_t>(x[j].imag()) * static_cast<std::int32_t>(h[j]);
+    }
+    return {re, im};
+}
+
+#if defined(GR4I_DSP_KERNELS_X86)
+
+__attribute__((target("avx2"))) inline std::int32_t horizontalSum(__m256i v) noexcept {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    sum         = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum         = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+// pmaddwd: 16 int16 products per instruction, summed pairwise into 8 int32 lanes
+__attribute__((target("avx2"))) inline std::int32_t dotRealInt16Avx2(const std::int16_t* x, const std::int16_t* h, std::size_t n) noexcept {
+    __m256i     acc0 = _mm256_setzero_si256();
+    __m256i     acc1 = _mm256_setzero_si256();
+    std::size_t j    = 0UZ;
+    for (; j + 32UZ <= n; j += 32UZ) {
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + j))));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j + 16UZ)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + j + 16UZ))));
+    }
+    if (j + 16UZ <= n) {
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + j))));
+        j += 16UZ;
+    }
+    std::int32_t sum = horizontalSum(_mm256_add_epi32(acc0, acc1));
+    for (; j < n; ++j) {
+        sum += static_cast<std::int32_t>(x[j]) * static_cast<std::int32_t>(h[j]);
+    }
+    return sum;
+}
+
+// complex x real: every tap widened to the int16 pairs (h, 0) and (0, h), so that pmaddwd on interleaved (re, im)
+// samples yields re * h and im * h in separate accumulators
+__attribute__((target("avx2"))) inline std::complex<std::int32_t> dotComplexInt16Avx2(const std::complex<std::int16_t>* x, const std::int16_t* h, std::size_t n) noexcept {
+    const std::int16_t* xs    = reinterpret_cast<const std::int16_t*>(x);
+    __m256i             accRe = _mm256_setzero_si256();
+    __m256i             accIm = _mm256_setzero_si256();
+    std::size_t         j     = 0UZ;
+    for (; j + 8UZ <= n; j += 8UZ) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + 2UZ * j));
+        const __m256i tapsRe  = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + j)));
+        accRe                 = _mm256_add_epi32(accRe, _mm256_madd_epi16(samples, tapsRe));
+        accIm                 = _mm256_add_epi32(accIm, _mm256_madd_epi16(samples, _mm256_slli_epi32(tapsRe, 16)));
+    }
+    std::int32_t re = horizontalSum(accRe);
+    std::int32_t im = horizontalSum(accIm);
+    for (; j < n; ++j) {
+        re += static_cast<std::int32_t>(x[j].real()) * static_cast<std::int32_t>(h[j]);
+        im += static_cast<std::int32_t>(x[j].imag()) * static_cast<std::int32_t>(h[j]);
+    }
+    return {re, im};
+}
+
+__attribute__((target("avx2,fma"))) inline float horizontalSum(__m256 v) noexcept {
+    const __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    const __m128 sum2 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 0x1)));
+}
+
+__attribute__((target("avx2,fma"))) inline float dotRealAvx2(const float* x, const float* h, std::size_t n) noexcept {
+    __m256      acc0 = _mm256_setzero_ps();
+    __m256      acc1 = _mm256_setzero_ps();
+    std::size_t j    = 0UZ;
+    for (; j + 16UZ <= n; j += 16UZ) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j), _mm256_loadu_ps(h + j), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j + 8UZ), _mm256_loadu_ps(h + j + 8UZ), acc1);
+    }
+    for (; j + 8UZ <= n; j += 8UZ) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j), _mm256_loadu_ps(h + j), acc0);
+    }
+    float sum = horizontalSum(_mm256_add_ps(acc0, acc1));
+    for (; j < n; ++j) {
+        sum += x[j] * h[j];
+    }
+    return sum;
+}
+
+// complex x real: 4 interleaved samples per register, each tap duplicated into the real and imaginary lane
+__attribute__((target("avx2,fma"))) inline std::complex<float> dotComplexAvx2(const std::complex<float>* x, const float* h, std::size_t n) noexcept {
+    const float*  xf   = reinterpret_cast<const float*>(x);
+    const __m256i dup  = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    __m256        acc0 = _mm256_setzero_ps();
+    __m256        acc1 = _mm256_setzero_ps();
+    std::size_t   j    = 0UZ;
+    for (; j + 8UZ <= n; j += 8UZ) {
+        const __m256 taps = _mm256_loadu_ps(h + j);
+        acc0              = _mm256_fmadd_ps(_mm256_loadu_ps(xf + 2UZ * j), _mm256_permutevar8x32_ps(taps, dup), acc0);
+        acc1              = _mm256_fmadd_ps(_mm256_loadu_ps(xf + 2UZ * j + 8UZ), _mm256_permutevar8x32_ps(_mm256_permute2f128_ps(taps, taps, 0x11), dup), acc1);
+    }
+    for (; j + 4UZ <= n; j += 4UZ) {
+        const __m256 taps = _mm256_castps128_ps256(_mm_loadu_ps(h + j));
+        acc0              = _mm256_fmadd_ps(_mm256_loadu_ps(xf + 2UZ * j), _mm256_permutevar8x32_ps(taps, dup), acc0);
+    }
+    alignas(32) std::array<float, 8UZ> lanes{};
+    _mm256_store_ps(lanes.data(), _mm256_add_ps(acc0, acc1));
+    float re = (lanes[0] + lanes[2]) + (lanes[4] + lanes[6]);
+    float im = (lanes[1] + lanes[3]) + (lanes[5] + lanes[7]);
+    for (; j < n; ++j) {
+        re += x[j].real() * h[j];
+        im += x[j].imag() * h[j];
+    }
+    return {re, im};
+}
+
+// adds the upper 256 bits onto the lower ones, keeping the (re, im) lane pairing of interleaved complex data
+__attribute__((target("avx512f,avx2,fma"))) inline __m256 foldHalves(__m512 v) noexcept {
+    const __m512d bits = _mm512_castps_pd(v);
+    return _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, bits, 0)), _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, bits, 1)));
+}
+
+__attribute__((target("avx512f,avx2,fma"))) inline float dotRealAvx512(const float* x, const float* h, std::size_t n) noexcept {
+    __m512      acc0 = _mm512_setzero_ps();
+    __m512      acc1 = _mm512_setzero_ps();
+    std::size_t j    = 0UZ;
+    for (; j + 32UZ <= n; j += 32UZ) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + j), _mm512_loadu_ps(h + j), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + j + 16UZ), _mm512_loadu_ps(h + j + 16UZ), acc1);
+    }
+    if (j + 16UZ <= n) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + j), _mm512_loadu_ps(h + j), acc0);
+        j += 16UZ;
+    }
+    if (j < n) { // masked tail
+        const __mmask16 mask = static_cast<__mmask16>((1U << (n - j)) - 1U);
+        acc1                 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, x + j), _mm512_maskz_loadu_ps(mask, h + j), acc1);
+    }
+    return horizontalSum(foldHalves(_mm512_add_ps(acc0, acc1)));
+}
+
+__attribute__((target("avx512f,avx2,fma"))) inline std::complex<float> dotComplexAvx512(const std::complex<float>* x, const float* h, std::size_t n) noexcept {
+    const float*  xf   = reinterpret_cast<const float*>(x);
+    const __m512i dup     = _mm512_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const __m512i dupHigh = _mm512_add_epi32(dup, _mm512_set1_epi32(8));
+    __m512        acc0    = _mm512_setzero_ps();
+    __m512        acc1    = _mm512_setzero_ps();
+    std::size_t   j       = 0UZ;
+    for (; j + 16UZ <= n; j += 16UZ) {
+        const __m512 taps = _mm512_loadu_ps(h + j);
+        acc0              = _mm512_fmadd_ps(_mm512_loadu_ps(xf + 2UZ * j), _mm512_maskz_permutexvar_ps(0xFFFF, dup, taps), acc0);
+        acc1              = _mm512_fmadd_ps(_mm512_loadu_ps(xf + 2UZ * j + 16UZ), _mm512_maskz_permutexvar_ps(0xFFFF, dupHigh, taps), acc1);
+    }
+    if (j < n) { // masked tail of up to 15 samples
+        const std::size_t rest     = n - j;
+        const __mmask16   tapMask  = static_cast<__mmask16>((1U << rest) - 1U);
+        const __m512      taps     = _mm512_maskz_loadu_ps(tapMask, h + j);
+        const std::size_t lowCount = rest < 8UZ ? rest : 8UZ;
+        const __mmask16   lowMask  = static_cast<__mmask16>((1U << (2UZ * lowCount)) - 1U);
+        acc0                       = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(lowMask, xf + 2UZ * j), _mm512_maskz_permutexvar_ps(0xFFFF, dup, taps), acc0);
+        if (rest > 8UZ) {
+            const __mmask16 highMask = static_cast<__mmask16>((1U << (2UZ * (rest - 8UZ))) - 1U);
+            acc1                     = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(highMask, xf + 2UZ * j + 16UZ), _mm512_maskz_permutexvar_ps(0xFFFF, dupHigh, taps), acc1);
+        }
+    }
+    const __m256 sum8 = foldHalves(_mm512_add_ps(acc0, acc1));
+    const __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+    const __m128 sum2 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4)); // (re, im) in the two lowest lanes
+    return {_mm_cvtss_f32(sum2), _mm_cvtss_f32(_mm_shuffle_ps(sum2, sum2, 0x1))};
+}
+
+#endif // GR4I_DSP_KERNELS_X86
+
+#if defined(GR4I_DSP_KERNELS_NEON)
+
+inline float dotRealNeon(const float* x, const float* h, std::size_t n) noexcept {
+    float32x4_t acc0 = vdupq_n_f32(0.F);
+    float32x4_t acc1 = vdupq_n_f32(0.F);
+    std::size_t j    = 0UZ;
+    for (; j + 8UZ <= n; j += 8UZ) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(x + j), vld1q_f32(h + j));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(x + j + 4UZ), vld1q_f32(h + j + 4UZ));
+    }
+    float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; j < n; ++j) {
+        sum += x[j] * h[j];
+    }
+    return sum;
+}
+
+inline std::complex<float> dotComplexNeon(const std::complex<float>* x, const float* h, std::size_t n) noexcept {
+    const float* xf = reinterpret_cast<const float*>(x);
+    float32x4_t  re = vdupq_n_f32(0.F);
+    float32x4_t  im = vdupq_n_f32(0.F);
+    std::size_t  j  = 0UZ;
+    for (; j + 4UZ <= n; j += 4UZ) {
+        const float32x4x2_t samples = vld2q_f32(xf + 2UZ * j); // de-interleaves into real and imaginary parts
+        const float32x4_t   taps    = vld1q_f32(h + j);
+        re                          = vfmaq_f32(re, samples.val[0], taps);
+        im                          = vfmaq_f32(im, samples.val[1], taps);
+    }
+    float sumRe = vaddvq_f32(re);
+    float sumIm = vaddvq_f32(im);
+    for (; j < n; ++j) {
+        sumRe += x[j].real() * h[j];
+        sumIm += x[j].imag() * h[j];
+    }
+    return {sumRe, sumIm};
+}
+
+inline std::int32_t dotRealInt16Neon(const std::int16_t* x, const std::int16_t* h, std::size_t n) noexcept {
+    int32x4_t   acc0 = vdupq_n_s32(0);
+    int32x4_t   acc1 = vdupq_n_s32(0);
+    std::size_t j    = 0UZ;
+    for (; j + 8UZ <= n; j += 8UZ) {
+        const int16x8_t samples = vld1q_s16(x + j);
+        const int16x8_t taps    = vld1q_s16(h + j);
+        acc0                    = vmlal_s16(acc0, vget_low_s16(samples), vget_low_s16(taps));
+        acc1                    = vmlal_s16(acc1, vget_high_s16(samples), vget_high_s16(taps));
+    }
+    std::int32_t sum = vaddvq_s32(vaddq_s32(acc0, acc1));
+    for (; j < n; ++j) {
+        sum += static_cast<std::int32_t>(x[j]) * static_cast<std::int32_t>(h[j]);
+    }
+    return sum;
+}
+
+inline std::complex<std::int32_t> dotComplexInt16Neon(const std::complex<std::int16_t>* x, const std::int16_t* h, std::size_t n) noexcept {
+    const std::int16_t* xs = reinterpret_cast<const std::int16_t*>(x);
+    int32x4_t           re = vdupq_n_s32(0);
+    int32x4_t           im = vdupq_n_s32(0);
+    std::size_t         j  = 0UZ;
+    for (; j + 4UZ <= n; j += 4UZ) {
+        const int16x4x2_t samples = vld2_s16(xs + 2UZ * j); // de-interleaves into real and imaginary parts
+        const int16x4_t   taps    = vld1_s16(h + j);
+        re                        = vmlal_s16(re, samples.val[0], taps);
+        im                        = vmlal_s16(im, samples.val[1], taps);
+    }
+    std::int32_t sumRe = vaddvq_s32(re);
+    std::int32_t sumIm = vaddvq_s32(im);
+    for (; j < n; ++j) {
+        sumRe += static_cast<std::int32_t>(x[j].real()) * static_cast<std::int32_t>(h[j]);
+        sumIm += static_cast<std::int32_t>(x[j].imag()) * static_cast<std::int32_t>(h[j]);
+    }
+    return {sumRe, sumIm};
+}
+
+#endif // GR4I_DSP_KERNELS_NEON
+
+} // namespace detail
+
+[[nodiscard]] inline bool isSupported(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Scalar: return true;
+#if defined(GR4I_DSP_KERNELS_X86)
+    case SimdLevel::Avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case SimdLevel::Avx512: return __builtin_cpu_supports("avx512f");
+#elif defined(GR4I_DSP_KERNELS_NEON)
+    case SimdLevel::Neon: return true;
+#endif
+    default: return false;
+    }
+}
+
+[[nodiscard]] inline DotKernels kernelsFor(SimdLevel level) noexcept {
+    switch (level) {
+#if defined(GR4I_DSP_KERNELS_X86)
+    case SimdLevel::Avx2: return {detail::dotRealAvx2, detail::dotComplexAvx2, detail::dotRealInt16Avx2, detail::dotComplexInt16Avx2};
+    case SimdLevel::Avx512: return {detail::dotRealAvx512, detail::dotComplexAvx512, detail::dotRealInt16Avx2, detail::dotComplexInt16Avx2}; // int16 stays on AVX2: AVX-512F has no 16-bit multiply-add
+#elif defined(GR4I_DSP_KERNELS_NEON)
+    case SimdLevel::Neon: return {detail::dotRealNeon, detail::dotComplexNeon, detail::dotRealInt16Neon, detail::dotComplexInt16Neon};
+#endif
+    default: return {detail::dotScalar<float, float>, detail::dotScalar<float>, detail::dotRealInt16Scalar, detail::dotComplexInt16Scalar};
+    }
+}
+
+// Widest supported level, capped by GR4_SIMD_LEVEL=scalar|neon|avx2|avx512 (e.g. to compare kernels in benchmarks).
+[[nodiscard]] inline SimdLevel detectSimdLevel() noexcept {
+    SimdLevel        cap = SimdLevel::Avx512;
+    const char*      env = std::getenv("GR4_SIMD_LEVEL");
+    std::string_view requested(env != nullptr ? env : "");
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Neon, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (requested == toString(level)) {
+            cap = level;
+        }
+    }
+    for (SimdLevel level : {SimdLevel::Avx512, SimdLevel::Avx2, SimdLevel::Neon}) {
+        if (level <= cap && isSupported(level)) {
+            return level;
+        }
+    }
+    return SimdLevel::Scalar;
+}
+
+[[nodiscard]] inline const DotKernels& activeKernels() noexcept {
+    static const DotKernels kernels = kernelsFor(detectSimdLevel());
+    return kernels;
+}
+
+// Sample and tap types without a vector kernel (e.g. double) use the portable loop.
+template<typename T, typename C>
+[[nodiscard]] inline T dot(const T* x, const C* h, std::size_t n) noexcept {
+    return detail::dotScalar(x, h, n);
+}
+
+[[nodiscard]] inline float dot(const float* x, const float* h, std::size_t n) noexcept { return activeKernels().real(x, h, n); }
+
+[[nodiscard]] inline std::complex<float> dot(const std::complex<float>* x, const float* h, std::size_t n) noexcept { return activeKernels().complex(x, h, n); }
+
+[[nodiscard]] inline std::int32_t dot(const std::int16_t* x, const std::int16_t* h, std::size_t n) noexcept { return activeKernels().realInt16(x, h, n); }
+
+[[nodiscard]] inline std::complex<std::int32_t> dot(const std::complex<std::int16_t>* x, const std::int16_t* h, std::size_t n) noexcept { return activeKernels().complexInt16(x, h, n); }
+
+} // namespace gr::incubator::dsp_kernels
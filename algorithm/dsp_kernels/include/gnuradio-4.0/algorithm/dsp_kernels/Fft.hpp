@@ -0,0 +1,98 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace gr::incubator::dsp_kernels {
+
+// Power-of-two complex FFT on split real/imaginary arrays, meant for fast convolution. forward() takes natural order
+// and leaves the spectrum in bit-reversed order; inverse() takes bit-reversed order and returns natural order. A
+// pointwise product of two forward() spectra is therefore valid input to inverse() without any permutation pass.
+// inverse() is unscaled, i.e. inverse(forward(x)) == size() * x.
+class Radix2Fft {
+public:
+    Radix2Fft() = default;
+
+    explicit Radix2Fft(std::size_t size) : _size(size) {
+        if (size == 0UZ || !std::has_single_bit(size)) {
+            throw std::invalid_argument("Radix2Fft size must be a power of two");
+        }
+        // twiddles of the stage with butterfly span `half` are stored contiguously from index half - 1
+        _twiddleRe.resize(size > 1UZ ? size - 1UZ : 0UZ);
+        _twiddleIm.resize(_twiddleRe.size());
+        for (std::size_t half = 1UZ; half < size; half *= 2UZ) {
+            for (std::size_t j = 0UZ; j < half; ++j) {
+                const double angle         = -std::numbers::pi * static_cast<double>(j) / static_cast<double>(half);
+                _twiddleRe[half - 1UZ + j] = static_cast<float>(std::cos(angle));
+                _twiddleIm[half - 1UZ + j] = static_cast<float>(std::sin(angle));
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+    // decimation in frequency: natural order in, bit-reversed order out
+    void forward(float* re, float* im) const noexcept {
+        for (std::size_t half = _size / 2UZ; half >= 1UZ; half /= 2UZ) {
+            const float* wRe = _twiddleRe.data() + (half - 1UZ);
+            const float* wIm = _twiddleIm.data() + (half - 1UZ);
+            for (std::size_t start = 0UZ; start < _size; start += 2UZ * half) {
+                float* aRe = re + start;
+                float* aIm = im + start;
+                float* bRe = aRe + half;
+                float* bIm = aIm + half;
+                for (std::size_t j = 0UZ; j < half; ++j) {
+                    const float dRe = aRe[j] - bRe[j];
+                    const float dIm = aIm[j] - bIm[j];
+                    aRe[j] += bRe[j];
+                    aIm[j] += bIm[j];
+                    bRe[j] = dRe * wRe[j] - dIm * wIm[j];
+                    bIm[j] = dRe * wIm[j] + dIm * wRe[j];
+                }
+            }
+        }
+    }
+
+    // decimation in time with conjugate twiddles: bit-reversed order in, natural order out, unscaled
+    void inverse(float* re, float* im) const noexcept {
+        for (std::size_t half = 1UZ; half < _size; half *= 2UZ) {
+            const float* wRe = _twiddleRe.data() + (half - 1UZ);
+            const float* wIm = _twiddleIm.data() + (half - 1UZ);
+            for (std::size_t start = 0UZ; start < _size; start += 2UZ * half) {
+                float* aRe = re + start;
+                float* aIm = im + start;
+                float* bRe = aRe + half;
+                float* bIm = aIm + half;
+                for (std::size_t j = 0UZ; j < half; ++j) {
+                    const float tRe = bRe[j] * wRe[j] + bIm[j] * wIm[j];
+                    const float tIm = bIm[j] * wRe[j] - bRe[j] * wIm[j];
+                    bRe[j]          = aRe[j] - tRe;
+                    bIm[j]          = aIm[j] - tIm;
+                    aRe[j] += tRe;
+                    aIm[j] += tIm;
+                }
+            }
+        }
+    }
+
+private:
+    std::size_t        _size{0UZ};
+    std::vector<float> _twiddleRe;
+    std::vector<float> _twiddleIm;
+};
+
+// x *= h for split complex arrays of length n
+inline void multiplySpectra(float* xRe, float* xIm, const float* hRe, const float* hIm, std::size_t n) noexcept {
+    for (std::size_t k = 0UZ; k < n; ++k) {
+        const float re = xRe[k] * hRe[k] - xIm[k] * hIm[k];
+        const float im = xRe[k] * hIm[k] + xIm[k] * hRe[k];
+        xRe[k]         = re;
+        xIm[k]         = im;
+    }
+}
+
+} // namespace gr::incubator::dsp_kernels
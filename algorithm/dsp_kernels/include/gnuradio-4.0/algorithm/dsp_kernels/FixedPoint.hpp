@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace gr::incubator::dsp_kernels {
+
+// int16 taps with a power-of-two scale, h[j] ~ taps[j] * 2^-shift, for the 32-bit int16 dot kernels. The sample
+// scale convention follows SoapySDR's CS16 <-> CF32 conversion: int16 full scale is 1.0 in floating point.
+inline constexpr double kInt16FullScale = 32768.0;
+
+// Sum of the largest possible |x[j] * h[j]| for int16 samples, which the kernels must keep below 2^31.
+[[nodiscard]] inline std::int64_t int16AccumulationBound(std::span<const std::int16_t> quantised) noexcept {
+    std::int64_t bound = 0;
+    for (const std::int16_t tap : quantised) {
+        bound += 32768 * static_cast<std::int64_t>(tap < 0 ? -static_cast<std::int32_t>(tap) : tap);
+    }
+    return bound;
+}
+
+// Rounds taps * 2^shift to int16; values beyond the int16 range saturate.
+template<typename C>
+void quantiseInt16(std::span<const C> taps, int shift, std::span<std::int16_t> out) noexcept {
+    for (std::size_t j = 0UZ; j < taps.size(); ++j) {
+        const double scaled = std::round(std::ldexp(static_cast<double>(taps[j]), shift));
+        out[j]              = static_cast<std::int16_t>(std::clamp(scaled, -32767.0, 32767.0));
+    }
+}
+
+// Largest shift (at most 30) for which quantiseInt16(taps, shift) keeps every dot product with int16 samples exact in
+// 32 bits, i.e. int16AccumulationBound() < 2^31. Filters processed as separate dot products with a common scale (e.g.
+// polyphase branches) take the minimum over their branches.
+template<typename C>
+[[nodiscard]] int int16TapShift(std::span<const C> taps) {
+    double sum     = 0.0;
+    double largest = 0.0;
+    for (const C tap : taps) {
+        sum += std::abs(static_cast<double>(tap));
+        largest = std::max(largest, std::abs(static_cast<double>(tap)));
+    }
+    if (!(sum > 0.0)) {
+        return 30;
+    }
+    // sum * 2^shift <= 65535 bounds the accumulator by 32768 * 65535 < 2^31; rounding may add up to half an LSB per
+    // tap, so the candidate is verified on the quantised taps
+    int shift = std::min(30, static_cast<int>(std::floor(std::log2(std::min(65535.0 / sum, 32767.0 / largest)))));
+    std::vector<std::int16_t> quantised(taps.size());
+    for (;; --shift) {
+        quantiseInt16(taps, shift, std::span<std::int16_t>(quantised));
+        if (int16AccumulationBound(quantised) <= std::numeric_limits<std::int32_t>::max()) {
+            return shift;
+        }
+    }
+}
+
+// 32-bit accumulator of int16 samples and taps quantised at `shift`, scaled back to the sample scale: int16 outputs
+// are rounded and saturated, float outputs use the kInt16FullScale convention.
+template<typename R>
+[[nodiscard]] inline R fromFixedPoint(std::int32_t acc, int shift) noexcept {
+    if constexpr (std::same_as<R, std::int16_t>) {
+        std::int64_t value = acc;
+        if (shift > 0) {
+            value = (value + (std::int64_t{1} << (shift - 1))) >> shift; // round half up
+        } else {
+            value *= std::int64_t{1} << -shift;
+        }
+        return static_cast<std::int16_t>(std::clamp<std::int64_t>(value, std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max()));
+    } else {
+        return static_cast<R>(std::ldexp(static_cast<double>(acc), -shift) / kInt16FullScale);
+    }
+}
+
+// A value on the int16 sample scale (e.g. a combination of several fixed-point dot products) converted like
+// fromFixedPoint().
+template<typename R>
+[[nodiscard]] inline R fromInt16Scale(double value) noexcept {
+    if constexpr (std::same_as<R, std::int16_t>) {
+        return static_cast<std::int16_t>(std::clamp(std::floor(value + 0.5), -32768.0, 32767.0)); // round half up
+    } else {
+        return static_cast<R>(value / kInt16FullScale);
+    }
+}
+
+template<typename R>
+[[nodiscard]] inline std::complex<R> fromFixedPoint(std::complex<std::int32_t> acc, int shift) noexcept {
+    return {fromFixedPoint<R>(acc.real(), shift), fromFixedPoint<R>(acc.imag(), shift)};
+}
+
+} // namespace gr::incubator::dsp_kernels
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace gr::incubator::dsp_kernels {
+
+// Cache key made of a design name and version followed by the raw bytes of every parameter, so keys differ whenever any
+// parameter differs, even by one ulp. Pass scalars (not structs, whose padding bytes are unspecified). Bump the design's
+// version whenever its algorithm changes the taps for the same parameters, so stale files in GR4_TAP_CACHE_DIR miss.
+template<typename... Args>
+requires(std::is_trivially_copyable_v<Args> && ...)
+[[nodiscard]] std::string tapCacheKey(std::string_view design, std::uint32_t designVersion, const Args&... parameters) {
+    std::string key(design);
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(&designVersion), sizeof(designVersion));
+    (key.append(reinterpret_cast<const char*>(&parameters), sizeof(Args)), ...);
+    return key;
+}
+
+// Process-wide cache of designed filter taps, shared by all blocks that design the same filter. Retunes back to an
+// earlier design and graph restarts then skip the design (e.g. the Remez iterations of large PFB prototypes).
+//
+// When GR4_TAP_CACHE_DIR names a directory, misses are also looked up in and written to that directory, one file per
+// design, so the cache survives process restarts. The files are raw host-endian dumps tagged with the full key; a
+// missing, foreign or corrupt file is treated as a miss. Design errors propagate and are not cached.
+template<typename TapT>
+requires std::is_trivially_copyable_v<TapT>
+class TapCache {
+public:
+    using Taps = std::shared_ptr<const std::vector<TapT>>;
+
+    static constexpr std::size_t kMaxEntries = 256UZ; // oldest designs are evicted first
+
+    [[nodiscard]] static TapCache& instance() {
+        static TapCache cache;
+        return cache;
+    }
+
+    // Returns the taps cached under `key`, or runs `design()` (outside the lock) and caches its result.
+    template<typename Design>
+    [[nodiscard]] Taps getOrDesign(const std::string& key, Design&& design) {
+        std::filesystem::path directory;
+        {
+            std::lock_guard lock(_mutex);
+            if (auto it = _entries.find(key); it != _entries.end()) {
+                return it->second;
+            }
+            directory = _directory;
+        }
+
+        Taps taps = directory.empty() ? nullptr : load(directory, key);
+        if (taps == nullptr) {
+            taps = std::make_shared<const std::vector<TapT>>(std::invoke(std::forward<Design>(design)));
+            if (!directory.empty()) {
+                store(directory, key, *taps);
+            }
+        }
+
+        std::lock_guard lock(_mutex);
+        const auto [it, inserted] = _entries.try_emplace(key, std::move(taps)); // a concurrent design of the same key may have won
+        if (inserted) {
+            _order.push_back(key);
+            if (_order.size() > kMaxEntries) {
+                _entries.erase(_order.front());
+                _order.pop_front();
+            }
+        }
+        return it->second;
+    }
+
+    // Empty disables the on-disk cache; the directory is created on the first store.
+    void setDirectory(std::filesystem::path directory) {
+        std::lock_guard lock(_mutex);
+        _directory = std::move(directory);
+    }
+
+    [[nodiscard]] std::filesystem::path directory() const {
+        std::lock_guard lock(_mutex);
+        return _directory;
+    }
+
+    void clear() {
+        std::lock_guard lock(_mutex);
+        _entries.clear();
+        _order.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::lock_guard lock(_mutex);
+        return _entries.size();
+    }
+
+private:
+    static constexpr std::array<char, 8UZ> kMagic{'G', 'R', '4', 'T', 'A', 'P', 'S', '1'};
+
+    mutable std::mutex                    _mutex;
+    std::unordered_map<std::string, Taps> _entries;
+    std::deque<std::string>               _order;
+    std::filesystem::path                 _directory;
+
+    TapCache() {
+        if (const char* env = std::getenv("GR4_TAP_CACHE_DIR"); env != nullptr) {
+            _directory = env;
+        }
+    }
+
+    [[nodiscard]] static std::filesystem::path fileFor(const std::filesystem::path& directory, std::string_view key) {
+        std::uint64_t hash = 14695981039346656037ULL; // FNV-1a
+        for (const char c : key) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        std::string name = "taps-0000000000000000.bin";
+        for (std::size_t i = 0UZ; i < 16UZ; ++i) {
+            name[20UZ - i] = "0123456789abcdef"[(hash >> (4UZ * i)) & 0xFU];
+        }
+        return directory / name;
+    }
+
+    [[nodiscard]] static Taps load(const std::filesystem::path& directory, const std::string& key) {
+        std::ifstream file(fileFor(directory, key), std::ios::binary);
+        if (!file) {
+            return nullptr;
+        }
+        std::array<char, kMagic.size()> magic{};
+        std::uint64_t                   keySize = 0U;
+        file.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+        file.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+        if (!file || magic != kMagic || keySize != key.size()) {
+            return nullptr;
+        }
+        std::string   storedKey(key.size(), '\0');
+        std::uint64_t tapSize = 0U;
+        std::uint64_t count   = 0U;
+        file.read(storedKey.data(), static_cast<std::streamsize>(storedKey.size()));
+        file.read(reinterpret_cast<char*>(&tapSize), sizeof(tapSize));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file || storedKey != key || tapSize != sizeof(TapT) || count > (1ULL << 32U)) {
+            return nullptr;
+        }
+        std::vector<TapT> taps(static_cast<std::size_t>(count));
+        file.read(reinterpret_cast<char*>(taps.data()), static_cast<std::streamsize>(taps.size() * sizeof(TapT)));
+        if (!file || file.peek() != std::ifstream::traits_type::eof()) {
+            return nullptr;
+        }
+        return std::make_shared<const std::vector<TapT>>(std::move(taps));
+    }
+
+    // best effort: a failed write only costs a redesign in the next process
+    static void store(const std::filesystem::path& directory, const std::string& key, const std::vector<TapT>& taps) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        const auto target    = fileFor(directory, key);
+        auto       temporary = target;
+        temporary += std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            const auto    keySize = static_cast<std::uint64_t>(key.size());
+            const auto    tapSize = static_cast<std::uint64_t>(sizeof(TapT));
+            const auto    count   = static_cast<std::uint64_t>(taps.size());
+            file.write(kMagic.data(), static_cast<std::streamsize>(kMagic.size()));
+            file.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+            file.write(key.data(), static_cast<std::streamsize>(key.size()));
+            file.write(reinterpret_cast<const char*>(&tapSize), sizeof(tapSize));
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            file.write(reinterpret_cast<const char*>(taps.data()), static_cast<std::streamsize>(taps.size() * sizeof(TapT)));
+            if (!file.flush()) {
+                file.close();
+                std::filesystem::remove(temporary, error);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary, target, error); // atomic, so concurrent readers see either no file or a whole one
+        if (error) {
+            std::filesystem::remove(temporary, error);
+        }
+    }
+};
+
+} // namespace gr::incubator::dsp_kernels
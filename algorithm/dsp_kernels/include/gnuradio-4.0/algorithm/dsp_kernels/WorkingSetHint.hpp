@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace gr::incubator::dsp_kernels {
+
+// meta_information keys through which blocks describe the memory they touch per work() call, for cache-fitted chunk
+// planners: `fixed + bytesPerSample * nInputSamples` (taps, history, and input plus output spans).
+inline constexpr std::string_view kWorkingSetFixedBytes     = "working_set_fixed_bytes";
+inline constexpr std::string_view kWorkingSetBytesPerSample = "working_set_bytes_per_sample";
+
+// Stores `value` under `key` in a pmr property map. An existing entry is overwritten in place, so once the key was
+// published (e.g. from start()) later updates on the streaming thread do not allocate.
+template<typename Map>
+void setMetaEntry(Map& meta, std::string_view key, double value) {
+    using Value = typename Map::mapped_type;
+    if (auto entry = std::ranges::find_if(meta, [key](const auto& item) { return std::string_view(item.first) == key; }); entry != meta.end()) {
+        entry->second = Value(value);
+        return;
+    }
+    meta.insert_or_assign(std::pmr::string(key, meta.get_allocator().resource()), Value(value));
+}
+
+// Publishes a block's working-set hint into its meta_information.
+template<typename Map>
+void publishWorkingSetHint(Map& meta, double fixedBytes, double bytesPerSample) {
+    setMetaEntry(meta, kWorkingSetFixedBytes, fixedBytes);
+    setMetaEntry(meta, kWorkingSetBytesPerSample, bytesPerSample);
+}
+
+} // namespace gr::incubator::dsp_kernels
@@ -1,55 +1,130 @@
-// bench_AGCChain.cpp — AGC + carrier recovery pipeline throughput
-// Chain: VectorSource → MultiplyConst(0.05) → AGC → CostasLoop → VectorSink
+// bench_AGCChain.cpp — AGC pipeline throughput
+// Chain: VectorSource → MultiplyConst(0.05) → DCBlocker → AGC → VectorSink
+// Runs the chain under the Simple scheduler and under BlockingBackoff with the
+// round-robin and traffic-aware job list partitions, then compares the
+// VectorSource → DCBlocker → AGC → VectorSink front-end as separate blocks
+// against the same stages fused into one FusedChain block.
 #include <gnuradio-4.0/basic/AGC.hpp>
-#include <gnuradio-4.0/basic/MultiplyConst.hpp>
+#include <gnuradio-4.0/basic/DCBlocker.hpp>
+#include <gnuradio-4.0/basic/FusedChain.hpp>
 #include <gnuradio-4.0/basic/VectorSource.hpp>
 #include <gnuradio-4.0/basic/VectorSink.hpp>
-#include <gnuradio-4.0/sync/CostasLoop.hpp>
 #include <gnuradio-4.0/Graph.hpp>
 #include <gnuradio-4.0/Scheduler.hpp>
+#include <gnuradio-4.0/math/Math.hpp>
+#include <gnuradio-4.0/scheduler/BlockingBackoff.hpp>
 
 #include <chrono>
 #include <complex>
 #include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <string>
 #include <vector>
 
-int main() {
-    constexpr std::size_t N_IN = 1'000'000UZ;
-    constexpr float kA = 0.70710678118f;
+namespace {
 
-    std::vector<std::complex<float>> input(N_IN);
-    for (std::size_t i = 0u; i < N_IN; ++i) {
-        const float re = (i & 1u) ? kA : -kA;
-        const float im = (i & 2u) ? kA : -kA;
-        input[i] = {re, im};
+// A benchmark of a graph that did not run measures nothing: report the error and abort.
+template<typename TResult>
+void requireOk(const TResult& result, const char* what) {
+    if (!result) {
+        std::fprintf(stderr, "%s failed: %s\n", what, std::format("{}", result.error()).c_str());
+        std::abort();
+    }
+}
+
+void requireConnected(gr::ConnectionResult result) {
+    if (result != gr::ConnectionResult::SUCCESS) {
+        std::fputs("connecting the chain failed\n", stderr);
+        std::abort();
     }
+}
 
-    gr::Graph graph;
-    auto& src  = graph.emplaceBlock<gr::incubator::basic::VectorSource<std::complex<float>>>({{"data", input}});
-    auto& att  = graph.emplaceBlock<gr::incubator::basic::MultiplyConst<std::complex<float>>>(
-        gr::property_map{{"k", 0.05f}});
-    auto& agc  = graph.emplaceBlock<gr::incubator::basic::AGC<float>>(
+struct ChainHandles {
+    gr::incubator::basic::VectorSink<std::complex<float>>* sink = nullptr;
+};
+
+ChainHandles buildChain(gr::Graph& graph, const std::vector<std::complex<float>>& input) {
+    auto& src = graph.emplaceBlock<gr::incubator::basic::VectorSource<std::complex<float>>>({{"data", input}});
+    auto& att = graph.emplaceBlock<gr::blocks::math::MultiplyConst<std::complex<float>>>(
+        gr::property_map{{"value", std::complex<float>(0.05f)}});
+    auto& dc  = graph.emplaceBlock<gr::incubator::basic::DCBlocker<std::complex<float>>>(gr::property_map{{"alpha", 0.999f}});
+    auto& agc = graph.emplaceBlock<gr::incubator::basic::AGC<std::complex<float>>>(
         gr::property_map{{"reference_power", 1.f}, {"rate", 1e-3f},
                          {"max_gain", 100.f},      {"min_gain", 1e-4f}});
-    auto& loop = graph.emplaceBlock<gr::incubator::basic::CostasLoop<float>>(
-        gr::property_map{{"loop_bw", 0.01f}, {"damping", 0.707f}});
-    auto& snk  = graph.emplaceBlock<gr::incubator::basic::VectorSink<std::complex<float>>>({});
+    auto& snk = graph.emplaceBlock<gr::incubator::basic::VectorSink<std::complex<float>>>({});
+
+    requireConnected(graph.connect<"out">(src).to<"in">(att));
+    requireConnected(graph.connect<"out">(att).to<"in">(dc));
+    requireConnected(graph.connect<"out">(dc).to<"in">(agc));
+    requireConnected(graph.connect<"out">(agc).to<"in">(snk));
+    return {&snk};
+}
+
+ChainHandles buildFrontEnd(gr::Graph& graph, const std::vector<std::complex<float>>& input) {
+    auto& src = graph.emplaceBlock<gr::incubator::basic::VectorSource<std::complex<float>>>({{"data", input}});
+    auto& dc  = graph.emplaceBlock<gr::incubator::basic::DCBlocker<std::complex<float>>>(gr::property_map{{"alpha", 0.999f}});
+    auto& agc = graph.emplaceBlock<gr::incubator::basic::AGC<std::complex<float>>>(gr::property_map{{"rate", 1e-3f}});
+    auto& snk = graph.emplaceBlock<gr::incubator::basic::VectorSink<std::complex<float>>>({});
+
+    requireConnected(graph.connect<"out">(src).to<"in">(dc));
+    requireConnected(graph.connect<"out">(dc).to<"in">(agc));
+    requireConnected(graph.connect<"out">(agc).to<"in">(snk));
+    return {&snk};
+}
 
-    graph.connect<"out">(src).to<"in">(att);
-    graph.connect<"out">(att).to<"in">(agc);
-    graph.connect<"out">(agc).to<"in">(loop);
-    graph.connect<"out">(loop).to<"in">(snk);
+ChainHandles buildFusedFrontEnd(gr::Graph& graph, const std::vector<std::complex<float>>& input) {
+    using FrontEnd = gr::incubator::basic::FusedChain<gr::incubator::basic::DCBlocker<std::complex<float>>, gr::incubator::basic::AGC<std::complex<float>>>;
 
-    gr::scheduler::Simple sched;
-    sched.exchange(std::move(graph));
+    auto& src   = graph.emplaceBlock<gr::incubator::basic::VectorSource<std::complex<float>>>({{"data", input}});
+    auto& fused = graph.emplaceBlock<FrontEnd>();
+    auto& snk   = graph.emplaceBlock<gr::incubator::basic::VectorSink<std::complex<float>>>({});
+    fused.stage<0>().alpha = 0.999f;
+    fused.stage<1>().rate  = 1e-3f;
+
+    requireConnected(graph.connect<"out">(src).to<"in">(fused));
+    requireConnected(graph.connect<"out">(fused).to<"in">(snk));
+    return {&snk};
+}
+
+template<typename TScheduler, typename TConfigure>
+void runChain(const char* config, const std::vector<std::complex<float>>& input, TConfigure&& configure, ChainHandles (*build)(gr::Graph&, const std::vector<std::complex<float>>&) = buildChain, const char* chain = "AGCChain") {
+    TScheduler sched;
+    configure(sched);
+
+    gr::Graph          graph;
+    const ChainHandles handles = build(graph, input);
+    requireOk(sched.exchange(std::move(graph)), "exchange()");
 
     const auto t0 = std::chrono::steady_clock::now();
-    sched.runAndWait();
+    requireOk(sched.runAndWait(), "runAndWait()");
     const auto t1 = std::chrono::steady_clock::now();
     const double dt = std::chrono::duration<double>(t1 - t0).count();
 
-    const std::size_t nOut = snk.data().size();
-    std::printf("MultiplyConst + AGC + CostasLoop: %.2f MSamples/s (output=%zu from %zu input)\n",
-                static_cast<double>(nOut) / dt / 1e6,
-                nOut, N_IN);
+    const std::size_t nOut = handles.sink->data().size();
+    std::printf("%s,%s,%zu,%.2f\n", chain, config, input.size(), static_cast<double>(nOut) / dt / 1e6);
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t N_IN = 1'000'000UZ;
+    constexpr float kA = 0.70710678118f;
+
+    std::vector<std::complex<float>> input(N_IN);
+    for (std::size_t i = 0u; i < N_IN; ++i) {
+        const float re = (i & 1u) ? kA : -kA;
+        const float im = (i & 2u) ? kA : -kA;
+        input[i] = {re, im};
+    }
+
+    std::puts("chain,config,N,throughput_MSas");
+    using BlockingBackoff = gr::incubator::scheduler::BlockingBackoff<>;
+    runChain<gr::scheduler::Simple<>>("simple", input, [](auto&) {});
+    runChain<BlockingBackoff>("blocking_backoff_round_robin", input, [](BlockingBackoff& sched) { sched.partition_strategy = std::string("round_robin"); });
+    runChain<BlockingBackoff>("blocking_backoff_traffic_aware", input, [](BlockingBackoff& sched) { sched.partition_strategy = std::string("traffic_aware"); });
+    runChain<gr::scheduler::Simple<>>("simple_unfused", input, [](auto&) {}, buildFrontEnd, "DCBlockerAGC");
+    runChain<gr::scheduler::Simple<>>("simple_fused", input, [](auto&) {}, buildFusedFrontEnd, "DCBlockerAGC");
+    runChain<BlockingBackoff>("blocking_backoff_unfused", input, [](BlockingBackoff&) {}, buildFrontEnd, "DCBlockerAGC");
+    runChain<BlockingBackoff>("blocking_backoff_fused", input, [](BlockingBackoff&) {}, buildFusedFrontEnd, "DCBlockerAGC");
 }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <gnuradio-4.0/Block.hpp>
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace gr::incubator::basic {
+using namespace gr;
+
+namespace fused_chain_detail {
+template<typename TStage>
+using input_type = typename std::remove_cvref_t<decltype(std::declval<TStage&>().in)>::value_type;
+
+template<typename TStage>
+using output_type = typename std::remove_cvref_t<decltype(std::declval<TStage&>().out)>::value_type;
+
+template<typename TStage, typename TInput>
+concept ProcessOneStage = requires(TStage& stage, TInput sample) {
+    { stage.processOne(sample) } -> std::convertible_to<output_type<TStage>>;
+};
+
+template<typename... TStages>
+struct chain_traits;
+
+template<typename TFirst>
+struct chain_traits<TFirst> {
+    static constexpr bool linked = ProcessOneStage<TFirst, input_type<TFirst>>;
+};
+
+template<typename TFirst, typename TSecond, typename... TRest>
+struct chain_traits<TFirst, TSecond, TRest...> {
+    static constexpr bool linked = ProcessOneStage<TFirst, input_type<TFirst>> && std::is_convertible_v<output_type<TFirst>, input_type<TSecond>> && chain_traits<TSecond, TRest...>::linked;
+};
+} // namespace fused_chain_detail
+
+template<typename... TStages>
+    requires(sizeof...(TStages) > 0UZ && fused_chain_detail::chain_traits<TStages...>::linked)
+struct FusedChain : Block<FusedChain<TStages...>> {
+    using First  = std::tuple_element_t<0UZ, std::tuple<TStages...>>;
+    using Last   = std::tuple_element_t<sizeof...(TStages) - 1UZ, std::tuple<TStages...>>;
+    using TIn    = fused_chain_detail::input_type<First>;
+    using TOut   = fused_chain_detail::output_type<Last>;
+    using Stages = std::tuple<TStages...>;
+
+    using Description = Doc<"Runs a linear chain of single-input/single-output processOne blocks (e.g. DCBlocker -> AGC -> "
+                            "QuadratureDemod) as one block: every sample passes through all stages in a single loop, "
+                            "without intermediate buffers or per-stage scheduling. "
+                            "Stages are configured through stage<I>() before the graph starts; their start() is called on start. "
+                            "Stage tags, settings messages and processBulk overrides are not forwarded.">;
+
+    PortIn<TIn>   in;
+    PortOut<TOut> out;
+
+    GR_MAKE_REFLECTABLE(FusedChain, in, out);
+
+    Stages _stages{};
+
+    template<std::size_t I>
+    [[nodiscard]] constexpr std::tuple_element_t<I, Stages>& stage() noexcept {
+        return std::get<I>(_stages);
+    }
+
+    void start() {
+        std::apply(
+            [](auto&... stages) {
+                (
+                    [](auto& stage) {
+                        if constexpr (requires { stage.start(); }) {
+                            stage.start();
+                        }
+                    }(stages),
+                    ...);
+            },
+            _stages);
+    }
+
+    [[nodiscard]] constexpr TOut processOne(TIn sample) noexcept { return processFrom<0UZ>(sample); }
+
+private:
+    template<std::size_t I, typename TSample>
+    [[nodiscard]] constexpr TOut processFrom(TSample sample) noexcept {
+        auto result = std::get<I>(_stages).processOne(sample);
+        if constexpr (I + 1UZ == sizeof...(TStages)) {
+            return static_cast<TOut>(result);
+        } else {
+            return processFrom<I + 1UZ>(result);
+        }
+    }
+};
+
+} // namespace gr::incubator::basic
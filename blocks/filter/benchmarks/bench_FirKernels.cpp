@@ -0,0 +1,112 @@
+// bench_FirKernels.cpp — FIR dot-product kernels across SIMD levels and tap counts
+// For every kernel level the CPU supports (scalar, NEON, AVX2, AVX-512) and tap counts 16..1024, filters a
+// float and a complex<float> signal with real taps (stride 1, i.e. one dot product per input sample), and the same
+// for int16 samples with quantised int16 taps, and reports nanoseconds per output and the speedup over the scalar
+// kernel. Output is CSV.
+// The level used by FirDecimator and PfbArbResampler is the widest supported one; GR4_SIMD_LEVEL caps it.
+// Usage: bench_FirKernels [--samples N]
+#include <gnuradio-4.0/algorithm/dsp_kernels/DotProduct.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/FixedPoint.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <print>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+using namespace gr::incubator::dsp_kernels;
+
+template<typename T, typename Tap, typename Acc>
+double nsPerOutput(Acc (*kernel)(const T*, const Tap*, std::size_t) noexcept, const std::vector<T>& signal, const AlignedVector<Tap>& taps) {
+    const std::size_t nOutputs = signal.size() - taps.size() + 1UZ;
+    Acc               sink{};
+    double            best = 0.0;
+    for (int repeat = 0; repeat < 5; ++repeat) { // best of five against frequency scaling and scheduling noise
+        const clock::time_point start = clock::now();
+        for (std::size_t i = 0UZ; i < nOutputs; ++i) {
+            sink += kernel(signal.data() + i, taps.data(), taps.size());
+        }
+        const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / static_cast<double>(nOutputs);
+        best            = repeat == 0 ? ns : std::min(best, ns);
+    }
+    if (sink == Acc{-1}) { // keeps the loop from being optimised away
+        std::puts("");
+    }
+    return best;
+}
+
+inline std::size_t parseCount(std::string_view text, std::size_t fallback) {
+    std::size_t value    = 0UZ;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && value > 0UZ ? value : fallback;
+}
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    using namespace gr::incubator::dsp_kernels;
+
+    std::size_t nSamples = 1UZ << 16UZ;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--samples" && i + 1 < argc) {
+            nSamples = bench::parseCount(argv[++i], nSamples);
+        }
+    }
+
+    std::vector<float>               real(nSamples + 1024UZ);
+    std::vector<std::complex<float>> complex(nSamples + 1024UZ);
+    std::vector<std::int16_t>               real16(real.size());
+    std::vector<std::complex<std::int16_t>> complex16(real.size());
+    for (std::size_t n = 0UZ; n < real.size(); ++n) {
+        real[n]      = static_cast<float>((n * 7919UZ) % 1000UZ) * 1e-3F - 0.5F;
+        complex[n]   = {real[n], 0.25F - real[n]};
+        real16[n]    = static_cast<std::int16_t>(real[n] * 32767.F);
+        complex16[n] = {real16[n], static_cast<std::int16_t>(complex[n].imag() * 32767.F)};
+    }
+
+    std::println("kernel,taps,level,ns_per_output,speedup");
+    for (const std::size_t nTaps : {16UZ, 32UZ, 64UZ, 128UZ, 256UZ, 512UZ, 1024UZ}) {
+        AlignedVector<float> taps(nTaps);
+        for (std::size_t j = 0UZ; j < nTaps; ++j) {
+            taps[j] = 1.F / static_cast<float>(j + 1UZ);
+        }
+        const std::vector<float>               realSignal(real.begin(), real.begin() + static_cast<std::ptrdiff_t>(nSamples + nTaps - 1UZ));
+        const std::vector<std::complex<float>> complexSignal(complex.begin(), complex.begin() + static_cast<std::ptrdiff_t>(nSamples + nTaps - 1UZ));
+        AlignedVector<std::int16_t>            taps16(nTaps);
+        quantiseInt16(std::span<const float>(taps), int16TapShift(std::span<const float>(taps)), std::span<std::int16_t>(taps16));
+        const std::vector<std::int16_t>               real16Signal(real16.begin(), real16.begin() + static_cast<std::ptrdiff_t>(nSamples + nTaps - 1UZ));
+        const std::vector<std::complex<std::int16_t>> complex16Signal(complex16.begin(), complex16.begin() + static_cast<std::ptrdiff_t>(nSamples + nTaps - 1UZ));
+
+        const DotKernels scalar        = kernelsFor(SimdLevel::Scalar);
+        const double     realScalar    = bench::nsPerOutput(scalar.real, realSignal, taps);
+        const double     complexScalar = bench::nsPerOutput(scalar.complex, complexSignal, taps);
+        const double     real16Scalar    = bench::nsPerOutput(scalar.realInt16, real16Signal, taps16);
+        const double     complex16Scalar = bench::nsPerOutput(scalar.complexInt16, complex16Signal, taps16);
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::Neon, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (!isSupported(level)) {
+                continue;
+            }
+            const DotKernels kernels   = kernelsFor(level);
+            const double     realNs    = level == SimdLevel::Scalar ? realScalar : bench::nsPerOutput(kernels.real, realSignal, taps);
+            const double     complexNs = level == SimdLevel::Scalar ? complexScalar : bench::nsPerOutput(kernels.complex, complexSignal, taps);
+            std::println("real_x_real,{},{},{:.3f},{:.2f}", nTaps, toString(level), realNs, realScalar / realNs);
+            std::println("complex_x_real,{},{},{:.3f},{:.2f}", nTaps, toString(level), complexNs, complexScalar / complexNs);
+
+            const double real16Ns    = level == SimdLevel::Scalar ? real16Scalar : bench::nsPerOutput(kernels.realInt16, real16Signal, taps16);
+            const double complex16Ns = level == SimdLevel::Scalar ? complex16Scalar : bench::nsPerOutput(kernels.complexInt16, complex16Signal, taps16);
+            std::println("int16_x_int16,{},{},{:.3f},{:.2f}", nTaps, toString(level), real16Ns, real16Scalar / real16Ns);
+            std::println("cint16_x_int16,{},{},{:.3f},{:.2f}", nTaps, toString(level), complex16Ns, complex16Scalar / complex16Ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <format>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gnuradio-4.0/Block.hpp>
+#include <gnuradio-4.0/BlockRegistry.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/WorkingSetHint.hpp>
+#include <gnuradio-4.0/algorithm/filter/FilterTool.hpp>
+
+#include <gnuradio-4.0/filter/detail/FirKernels.hpp>
+
+namespace gr::incubator::filter {
+
+namespace detail {
+
+// Magnitude response of an order-N CIC decimator (decimation R, differential delay M) at `frequency` in cycles per
+// input sample, normalised to 1 at DC.
+[[nodiscard]] inline double cicMagnitude(double frequency, std::size_t order, std::size_t decim, std::size_t delay) noexcept {
+    const double x = std::numbers::pi * std::abs(frequency);
+    if (x < 1e-12) {
+        return 1.0;
+    }
+    const double length = static_cast<double>(decim * delay);
+    return std::pow(std::abs(std::sin(x * length) / (length * std::sin(x))), static_cast<double>(order));
+}
+
+// integer component type, number of components and float output type of a CIC stream
+template<typename T>
+struct cic_traits {
+    using value_type                         = T;
+    using output_type                        = float;
+    static constexpr std::size_t kComponents = 1UZ;
+};
+
+template<typename T>
+struct cic_traits<std::complex<T>> {
+    using value_type                         = T;
+    using output_type                        = std::complex<float>;
+    static constexpr std::size_t kComponents = 2UZ;
+};
+
+} // namespace detail
+
+GR_REGISTER_BLOCK("gr::incubator::filter::CicDecimator", gr::incubator::filter::CicDecimator, ([T]), [ int16_t, std::complex<int16_t> ])
+
+template<typename T>
+requires std::signed_integral<typename detail::cic_traits<T>::value_type>
+struct CicDecimator : Block<CicDecimator<T>, Resampling<1UZ, 1UZ, false>> {
+    using TParent     = Block<CicDecimator<T>, Resampling<1UZ, 1UZ, false>>;
+    using Description = Doc<R""(@brief CIC decimator followed by a droop-compensating FIR decimator
+
+Decimates fixed-point samples (e.g. from SoapyRx<int16_t> or the CS16 stream of
+SoapyRx<std::complex<int16_t>>) by decim with an
+order-N cascaded integrator-comb filter, which needs only additions: N integrators
+run at the input rate and N combs at the decimated rate, in 64-bit integer
+registers that wrap on overflow. Wrap-around is harmless for a CIC as long as the
+final result fits, which is checked against 8 * sizeof(T) + N * log2(decim * M)
+bits. Samples are converted to float only at the CIC output, scaled by the DC
+gain (decim * M)^N so that the output keeps the units of the input. Complex
+streams run the CIC on the real and imaginary parts and output std::complex<float>.
+
+The following FIR stage decimates by another compensation_decim. Its taps are
+designed from windowed low-passes (cutoff f_low, transition_width) so that the
+pass band inverts the sinc^N droop of the CIC; gain sets the overall DC gain,
+e.g. 1 / 32768 for int16 full scale to 1.0.
+
+Total decimation is decim * compensation_decim. CIC stages are exact only in
+modular integer arithmetic, so floating-point streams should use
+MultiStageDecimator instead.
+)"">;
+
+    using TValue = typename detail::cic_traits<T>::value_type;
+    using TOut   = typename detail::cic_traits<T>::output_type;
+
+    static constexpr std::size_t kMaxOrder   = 8UZ;
+    static constexpr std::size_t kComponents = detail::cic_traits<T>::kComponents;
+
+    PortIn<T>     in;
+    PortOut<TOut> out;
+
+    Annotated<uint32_t, "decimation factor", Doc<"CIC decimation factor">, Visible> decim{100U};
+    Annotated<uint32_t, "order", Doc<"Number of integrator and comb stages (1 to 8)">, Visible> order{4U};
+    Annotated<uint32_t, "differential_delay", Doc<"Comb differential delay in decimated samples, usually 1 or 2">> differential_delay{1U};
+    Annotated<uint32_t, "compensation_decim", Doc<"Decimation factor of the compensation FIR; total decimation is decim * compensation_decim">, Visible> compensation_decim{2U};
+    Annotated<float, "f_low", Doc<"Pass-band edge in Hz of the compensation low-pass">, Visible> f_low{2000.F};
+    Annotated<float, "sample_rate", Doc<"Input stream sample rate in Hz used for compensation FIR design">, Visible> sample_rate{1000000.F};
+    Annotated<float, "transition_width", Doc<"Transition width in Hz of the compensation low-pass; also sets its number of tap steps">, Visible> transition_width{1000.F};
+    Annotated<uint32_t, "num_taps", Doc<"Number of compensation FIR taps. Set 0 or 1 to estimate from transition_width and attenuation_db.">, Visible> num_taps{0U};
+    Annotated<float, "gain", Doc<"DC gain of the decimator">> gain{1.F};
+    Annotated<float, "attenuation_db", Doc<"Stop-band attenuation used for automatic order estimation">> attenuation_db{60.F};
+    Annotated<float, "beta", Doc<"Kaiser beta used by GNU Radio 4's FIR designer">> beta{6.76F};
+    Annotated<gr::algorithm::window::Type, "window", Doc<"Window used for designed taps">> window{gr::algorithm::window::Type::Kaiser};
+
+    GR_MAKE_REFLECTABLE(CicDecimator, in, out, decim, order, differential_delay, compensation_decim, f_low, sample_rate, transition_width, num_taps, gain, attenuation_db, beta, window);
+
+    std::vector<std::uint64_t>        _integrators; // two's complement, wrapping modulo 2^64, component-major
+    std::vector<std::uint64_t>        _combDelay;   // last differential_delay inputs of every comb, component- and stage-major
+    std::size_t                       _combPos{0UZ};
+    std::size_t                       _cicPhase{0UZ};
+    double                            _cicScale{1.0};
+    std::vector<TOut>                 _cicOutput; // input of the compensation FIR
+    std::vector<float>                _taps{1.F};
+    dsp_kernels::AlignedVector<float> _reversedTaps{1.F};
+    std::vector<TOut>                 _tail;
+    std::size_t                       _compPhase{0UZ};
+
+    void start() { updateFilter(); }
+
+    void settingsChanged(const property_map& /*oldSettings*/, const property_map& newSettings) {
+        validateSettings();
+        this->input_chunk_size  = static_cast<gr::Size_t>(decim) * static_cast<gr::Size_t>(compensation_decim);
+        this->output_chunk_size = 1UZ;
+        if (newSettings.size() == 1UZ && newSettings.contains("sample_rate")) {
+            return;
+        }
+
+        try {
+            updateFilter();
+        } catch (...) {
+            // Settings may be applied in stages. start() performs the final
+            // validation once all staged parameters have been committed.
+        }
+    }
+
+    [[nodiscard]] work::Status processBulk(std::span<const T> input, std::span<TOut> output) noexcept {
+        assert(output.size() >= requiredOutputCount(input.size()));
+
+        const std::size_t nCic = detail::decimatedOutputCount(input.size(), _cicPhase, static_cast<std::size_t>(decim));
+        if (_cicOutput.size() < nCic) {
+            _cicOutput.resize(nCic); // grows to the largest span seen, then stays allocated
+        }
+        [&]<std::size_t... N>(std::index_sequence<N...>) { // dispatch to the kernel of the configured order
+            ((_integrators.size() == kComponents * (N + 1UZ) ? integrateAndComb<N + 1UZ>(input) : void()), ...);
+        }(std::make_index_sequence<kMaxOrder>{});
+
+        const std::size_t           decimation = static_cast<std::size_t>(compensation_decim);
+        const std::size_t           history    = _reversedTaps.size() - 1UZ;
+        const std::span<const TOut> cicOutput(_cicOutput.data(), nCic);
+        detail::stageHead<TOut>(_tail, cicOutput, history);
+        detail::firDecimateSpan<TOut, float>(_tail, cicOutput, _reversedTaps, (decimation - _compPhase) % decimation, decimation, output);
+        detail::advanceHistory<TOut>(_tail, cicOutput, history);
+        _compPhase = (_compPhase + nCic) % decimation;
+        return work::Status::OK;
+    }
+
+    [[nodiscard]] std::size_t requiredOutputCount(std::size_t input_size) const noexcept {
+        const std::size_t nCic = detail::decimatedOutputCount(input_size, _cicPhase, static_cast<std::size_t>(decim));
+        return detail::decimatedOutputCount(nCic, _compPhase, static_cast<std::size_t>(compensation_decim));
+    }
+
+    // Integrators for every input sample and combs for every decim-th one, the first of the stream included. The order
+    // is a template parameter so that the integrator state stays in registers.
+    template<std::size_t N>
+    void integrateAndComb(std::span<const T> input) noexcept {
+        const std::size_t                                     decimation = static_cast<std::size_t>(decim);
+        std::array<std::array<std::uint64_t, N>, kComponents> acc;
+        for (std::size_t c = 0UZ; c < kComponents; ++c) {
+            std::copy_n(_integrators.begin() + static_cast<std::ptrdiff_t>(c * N), N, acc[c].begin());
+        }
+        std::size_t phase = _cicPhase;
+        std::size_t nOut  = 0UZ;
+        for (const T sample : input) {
+            std::array<std::uint64_t, kComponents> values;
+            if constexpr (kComponents == 2UZ) {
+                values = {static_cast<std::uint64_t>(static_cast<std::int64_t>(sample.real())), static_cast<std::uint64_t>(static_cast<std::int64_t>(sample.imag()))};
+            } else {
+                values = {static_cast<std::uint64_t>(static_cast<std::int64_t>(sample))};
+            }
+            for (std::size_t c = 0UZ; c < kComponents; ++c) {
+                for (std::size_t j = 0UZ; j < N; ++j) {
+                    acc[c][j] += values[c];
+                    values[c] = acc[c][j];
+                }
+            }
+            if (phase == 0UZ) {
+                _cicOutput[nOut++] = comb(values);
+            }
+            phase = phase + 1UZ == decimation ? 0UZ : phase + 1UZ;
+        }
+        for (std::size_t c = 0UZ; c < kComponents; ++c) {
+            std::ranges::copy(acc[c], _integrators.begin() + static_cast<std::ptrdiff_t>(c * N));
+        }
+        _cicPhase = phase;
+    }
+
+    [[nodiscard]] TOut comb(std::array<std::uint64_t, kComponents> values) noexcept {
+        const std::size_t delay  = static_cast<std::size_t>(differential_delay);
+        const std::size_t stages = _integrators.size() / kComponents;
+        for (std::size_t c = 0UZ; c < kComponents; ++c) {
+            for (std::size_t j = 0UZ; j < stages; ++j) {
+                std::uint64_t&      slot    = _combDelay[(c * stages + j) * delay + _combPos];
+                const std::uint64_t delayed = slot;
+                slot                        = values[c];
+                values[c] -= delayed;
+            }
+        }
+        _combPos           = _combPos + 1UZ == delay ? 0UZ : _combPos + 1UZ;
+        const auto toFloat = [this](std::uint64_t value) { return static_cast<float>(static_cast<double>(static_cast<std::int64_t>(value)) * _cicScale); };
+        if constexpr (kComponents == 2UZ) {
+            return {toFloat(values[0]), toFloat(values[1])};
+        } else {
+            return toFloat(values[0]);
+        }
+    }
+
+    void updateFilter() {
+        validateSettings();
+        this->input_chunk_size  = static_cast<gr::Size_t>(decim) * static_cast<gr::Size_t>(compensation_decim);
+        this->output_chunk_size = 1UZ;
+
+        const std::size_t N            = static_cast<std::size_t>(order);
+        const double      length       = static_cast<double>(decim) * static_cast<double>(differential_delay);
+        const double      registerBits = static_cast<double>(8UZ * sizeof(TValue)) + static_cast<double>(N) * std::log2(length);
+        if (registerBits > 64.0) {
+            throw std::invalid_argument(std::format("CicDecimator needs {:.1f} register bits for order {} and decim * differential_delay = {}, but has 64", registerBits, N, length));
+        }
+
+        _taps = designCompensationTaps();
+        _reversedTaps.assign(_taps.crbegin(), _taps.crend());
+        _tail.assign(2UZ * (_taps.size() - 1UZ), TOut{});
+        _integrators.assign(kComponents * N, 0U);
+        _combDelay.assign(kComponents * N * static_cast<std::size_t>(differential_delay), 0U);
+        _combPos   = 0UZ;
+        _cicPhase  = 0UZ;
+        _compPhase = 0UZ;
+        _cicScale  = std::pow(length, -static_cast<double>(N));
+        publishWorkingSetHint();
+    }
+
+    // Sum of nested windowed low-passes whose pass bands form a staircase approximation of 1 / droop up to f_low. The
+    // window smooths the steps, which are kept to a quarter of the transition width, into a continuous response.
+    [[nodiscard]] std::vector<float> designCompensationTaps() const {
+        if (!(sample_rate > 0.F)) {
+            throw std::invalid_argument("CicDecimator sample_rate must be greater than zero");
+        }
+        const double inputRate = static_cast<double>(sample_rate);
+        const double cicRate   = inputRate / static_cast<double>(decim);
+        if (!(f_low > 0.F) || !(static_cast<double>(f_low) < 0.5 * cicRate)) {
+            throw std::invalid_argument(std::format("CicDecimator f_low must lie in (0, {}) Hz, the Nyquist range after the CIC", 0.5 * cicRate));
+        }
+
+        std::size_t nTaps = num_taps > 1U ? static_cast<std::size_t>(num_taps) : estimateNumTaps(cicRate);
+        nTaps += 1UZ - nTaps % 2UZ; // odd, for a symmetric response around a centre tap
+
+        const double      edge  = static_cast<double>(f_low);
+        const std::size_t steps = std::clamp<std::size_t>(static_cast<std::size_t>(std::ceil(4.0 * edge / static_cast<double>(transition_width))), 1UZ, 64UZ);
+        const auto        level = [&](std::size_t k) { // inverse droop in the middle of step k
+            return 1.0 / detail::cicMagnitude(edge * (static_cast<double>(k) - 0.5) / static_cast<double>(steps) / inputRate, static_cast<std::size_t>(order), static_cast<std::size_t>(decim), static_cast<std::size_t>(differential_delay));
+        };
+
+        gr::filter::FilterCoefficients<float> compensation;
+        compensation.b.assign(nTaps, 0.F);
+        double previous = 0.0;
+        for (std::size_t k = steps; k >= 1UZ; --k) { // widest first: every narrower step adds the rise to its level
+            auto step = gr::filter::fir::generateCoefficients<float>(nTaps, window, static_cast<float>(edge * static_cast<double>(k) / static_cast<double>(steps) / cicRate), static_cast<float>(beta));
+            normaliseOrThrow(step, 1.F);
+            const double current = level(k);
+            const float  weight  = static_cast<float>(current - previous);
+            for (std::size_t i = 0UZ; i < nTaps; ++i) {
+                compensation.b[i] += weight * step.b[i];
+            }
+            previous = current;
+        }
+        normaliseOrThrow(compensation, gain);
+        return std::move(compensation.b);
+    }
+
+    [[nodiscard]] std::size_t estimateNumTaps(double cicRate) const {
+        const double normalised_transition = static_cast<double>(transition_width) / cicRate;
+        return std::max<std::size_t>(3UZ, gr::filter::fir::estimateNumberOfTapsKaiser(static_cast<double>(attenuation_db), 2.0 * std::numbers::pi * normalised_transition));
+    }
+
+    static void normaliseOrThrow(gr::filter::FilterCoefficients<float>& coeffs, float targetGain) {
+        const auto [ok, magnitude] = gr::filter::normaliseFilterCoefficients(coeffs, 0.F, targetGain);
+        if (!ok) {
+            throw std::invalid_argument(std::format("CicDecimator gain correction failed with magnitude {}", magnitude));
+        }
+    }
+
+    // checks that hold for any combination of staged settings; rejects the offending setting from settingsChanged()
+    void validateSettings() const {
+        if (decim == 0U || differential_delay == 0U || compensation_decim == 0U) {
+            throw std::invalid_argument("CicDecimator decim, differential_delay and compensation_decim must be greater than zero");
+        }
+        if (order == 0U || order > kMaxOrder) {
+            throw std::invalid_argument(std::format("CicDecimator order must lie in [1, {}]", kMaxOrder));
+        }
+        if (!(transition_width > 0.F)) { // sets the compensation steps even when num_taps is given
+            throw std::invalid_argument("CicDecimator transition_width must be greater than zero");
+        }
+    }
+
+    // working set per work() call for cache-fitted chunk planners: CIC state + FIR taps and tail + input span + CIC
+    // output + decimated output span
+    void publishWorkingSetHint() {
+        const double cicDecim       = static_cast<double>(decim);
+        const double fixedBytes     = static_cast<double>((_integrators.size() + _combDelay.size()) * sizeof(std::uint64_t) + _reversedTaps.size() * sizeof(float) + _tail.size() * sizeof(TOut));
+        const double bytesPerSample = static_cast<double>(sizeof(T)) + static_cast<double>(sizeof(TOut)) * (1.0 + 1.0 / static_cast<double>(compensation_decim)) / cicDecim;
+        dsp_kernels::publishWorkingSetHint(this->meta_information.value, fixedBytes, bytesPerSample);
+    }
+};
+
+} // namespace gr::incubator::filter
@@ -1,25 +1,34 @@
 #pragma once
 
 #include <algorithm>
-#include <bit>
+#include <array>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <cstdlib>
 #include <execution>
 #include <format>
 #include <numeric>
 #include <numbers>
+#include <optional>
 #include <print>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 #include <string_view>
 #include <vector>
 
 #include <gnuradio-4.0/Block.hpp>
 #include <gnuradio-4.0/BlockRegistry.hpp>
-#include <gnuradio-4.0/HistoryBuffer.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/BackgroundDesign.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/FixedPoint.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/WorkingSetHint.hpp>
 #include <gnuradio-4.0/algorithm/filter/FilterTool.hpp>
 
+#include <gnuradio-4.0/filter/detail/FirDesign.hpp>
+#include <gnuradio-4.0/filter/detail/FirKernels.hpp>
+#include <gnuradio-4.0/filter/detail/OverlapSave.hpp>
+
 namespace gr::incubator::filter {
 
 namespace detail {
@@ -34,28 +43,97 @@ struct fir_decimator_coeff_type<std::complex<T>> {
     using type = T;
 };
 
+// int16 streams are filtered with int16 taps quantised from a float design (or float configured taps)
+template<>
+struct fir_decimator_coeff_type<std::int16_t> {
+    using type = float;
+};
+
+template<>
+struct fir_decimator_coeff_type<std::complex<std::int16_t>> {
+    using type = float;
+};
+
 template<typename T>
 using fir_decimator_coeff_type_t = typename fir_decimator_coeff_type<T>::type;
 
+template<typename T>
+inline constexpr bool fir_decimator_int16_v = std::same_as<T, std::int16_t> || std::same_as<T, std::complex<std::int16_t>>;
+
+template<typename T>
+struct fir_decimator_value_type {
+    using type = T;
+};
+
+template<typename T>
+struct fir_decimator_value_type<std::complex<T>> {
+    using type = T;
+};
+
+template<typename T>
+using fir_decimator_value_type_t = typename fir_decimator_value_type<T>::type;
+
+// T with its scalar type replaced by R, e.g. std::complex<int16_t> with float gives std::complex<float>
+template<typename T, typename R>
+struct fir_decimator_output_type {
+    using type = R;
+};
+
+template<typename T, typename R>
+struct fir_decimator_output_type<std::complex<T>, R> {
+    using type = std::complex<R>;
+};
+
+template<typename T, typename R>
+using fir_decimator_output_type_t = typename fir_decimator_output_type<T, R>::type;
+
 } // namespace detail
 
 GR_REGISTER_BLOCK("gr::incubator::filter::FirDecimator", gr::incubator::filter::FirDecimator, ([T]), [ float, std::complex<float> ])
+GR_REGISTER_BLOCK("gr::incubator::filter::FirDecimator", gr::incubator::filter::FirDecimator, ([T], [R]), [ int16_t, std::complex<int16_t> ], [ int16_t, float ])
 
-template<typename T>
-requires(std::floating_point<T> || gr::meta::complex_like<T>)
-struct FirDecimator : Block<FirDecimator<T>, Resampling<1UZ, 1UZ, false>> {
-    using TParent     = Block<FirDecimator<T>, Resampling<1UZ, 1UZ, false>>;
+// R is the scalar type of the output samples: the input's for floating-point streams, int16_t or float for int16 ones.
+template<typename T, typename R = detail::fir_decimator_value_type_t<T>>
+requires((std::floating_point<detail::fir_decimator_value_type_t<T>> && std::same_as<R, detail::fir_decimator_value_type_t<T>>) || (detail::fir_decimator_int16_v<T> && (std::same_as<R, std::int16_t> || std::same_as<R, float>)))
+struct FirDecimator : Block<FirDecimator<T, R>, Resampling<1UZ, 1UZ, false>> {
+    using TParent     = Block<FirDecimator<T, R>, Resampling<1UZ, 1UZ, false>>;
     using Description = Doc<R""(@brief FIR decimator with optional automatic filter design
 
 This block filters and decimates a stream by an integer factor. By default it
 designs low-pass FIR taps using GNU Radio 4 filter routines, which is useful
 before reducing RF/IQ sample rates. Provide non-empty taps to bypass automatic
 tap design.
+
+Only the retained outputs are computed, each as one contiguous dot product over
+the input span; the last taps-1 samples are carried over between calls.
+
+Long filters (taps / decim >= fft_tap_threshold) are applied by overlap-save FFT
+convolution instead, whose cost per input sample grows only logarithmically with
+the tap count. Both modes produce the same outputs (up to rounding), sample and
+tag alignment.
+
+Once started, changes of the design parameters alone (e.g. f_low or
+transition_width) are designed on a background thread while the current taps
+keep filtering; the new taps take over at a chunk boundary with the filter
+history and decimation phase kept, so retunes neither stall nor glitch the stream.
+New taps longer than the current ones wait until their history is filled with
+actual input samples.
+
+int16_t and std::complex<int16_t> streams (e.g. SoapySDR S16/CS16) are filtered
+natively, without a conversion pass: the float taps are quantised to int16 with
+a power-of-two scale that keeps the 32-bit accumulation exact for any input. The
+output is either int16 (R = int16_t, same scale as the input, rounded and
+saturated) or float (R = float, int16 full scale mapped to 1.0 as SoapySDR's
+CS16 to CF32 conversion does). The int16 path always filters in direct form.
 )"">;
     using CoeffType = detail::fir_decimator_coeff_type_t<T>;
+    using TOut      = detail::fir_decimator_output_type_t<T, R>;
+
+    static constexpr bool kFixedPoint = detail::fir_decimator_int16_v<T>;
+    static constexpr bool kFftCapable = !kFixedPoint && std::same_as<CoeffType, float>; // the FFT path works in single precision
 
-    PortIn<T>  in;
-    PortOut<T> out;
+    PortIn<T>     in;
+    PortOut<TOut> out;
 
     Annotated<uint32_t, "decimation factor", Doc<"Factor by which to downsample after filtering">, Visible> decim{1U};
     Annotated<Tensor<CoeffType>, "taps", Doc<"Optional FIR taps. Empty taps mean design taps from the filter parameters.">, Visible> taps{};
@@ -70,20 +148,45 @@ tap design.
     Annotated<float, "attenuation_db", Doc<"Stop-band attenuation used for automatic order estimation">> attenuation_db{60.F};
     Annotated<float, "beta", Doc<"Kaiser beta used by GNU Radio 4's FIR designer">> beta{6.76F};
     Annotated<gr::algorithm::window::Type, "window", Doc<"Window used for designed taps">> window{gr::algorithm::window::Type::Kaiser};
-
-    GR_MAKE_REFLECTABLE(FirDecimator, in, out, decim, taps, filter_response, f_low, f_high, sample_rate, transition_width, num_taps, gain, attenuation_db, beta, window);
-
-    std::vector<CoeffType> _taps{CoeffType{1}};
-    HistoryBuffer<T>       _history{32UZ};
-    uint32_t               _decimPhase{0U};
-    std::size_t            _debugProcessCalls{0UZ};
-    float                  _designSampleRate{1000000.F};
+    Annotated<uint32_t, "fft_tap_threshold", Doc<"Use overlap-save FFT filtering once taps / decim reaches this value. 0 always filters in direct form.">> fft_tap_threshold{256U};
+
+    GR_MAKE_REFLECTABLE(FirDecimator, in, out, decim, taps, filter_response, f_low, f_high, sample_rate, transition_width, num_taps, gain, attenuation_db, beta, window, fft_tap_threshold);
+
+    // settings that only change the designed taps and can therefore be redesigned in the background
+    static constexpr std::array<std::string_view, 9UZ> kRetuneSettings{"filter_response", "f_low", "f_high", "transition_width", "num_taps", "gain", "attenuation_db", "beta", "window"};
+
+    struct PreparedFilter { // everything derived from the taps, so that a background redesign leaves only a swap
+        std::vector<CoeffType>                   taps;
+        dsp_kernels::AlignedVector<CoeffType>    reversedTaps;
+        dsp_kernels::AlignedVector<std::int16_t> reversedTapsInt16; // int16 path only, reversedTaps * 2^tapShift
+        int                                      tapShift{0};
+        detail::OverlapSave<T>                   overlapSave;
+        bool                                     useFft{false};
+        std::vector<T>                           tail; // zeros, sized for the taps so that the swap does not allocate
+    };
+
+    std::vector<CoeffType>                        _taps{CoeffType{1}};
+    dsp_kernels::AlignedVector<CoeffType>         _reversedTaps{CoeffType{1}};
+    dsp_kernels::AlignedVector<std::int16_t>      _reversedTapsInt16;
+    int                                           _tapShift{0};
+    std::vector<T>                                _tail; // last taps-1 input samples, followed by room for the head of the next input span
+    uint32_t                                      _decimPhase{0U};
+    detail::OverlapSave<T>                        _overlapSave;
+    bool                                          _useFft{false};
+    std::size_t                                   _debugProcessCalls{0UZ};
+    float                                         _designSampleRate{1000000.F};
+    dsp_kernels::BackgroundDesign<PreparedFilter> _redesign;
+    std::optional<PreparedFilter>                 _staged;             // designed taps waiting for their history to fill
+    std::size_t                                   _stagedMissing{0UZ}; // input samples the staged taps still lack
+    std::size_t                                   _streamed{0UZ};      // input samples since the last history reset
+    bool                                          _started{false};
 
     void start() {
         if (sample_rate > 0.F) {
             _designSampleRate = sample_rate;
         }
         updateFilter();
+        _started = true;
     }
 
     void settingsChanged(const property_map& /*oldSettings*/, const property_map& newSettings) {
@@ -103,6 +206,10 @@ tap design.
         if (!canUpdateFilter()) {
             return;
         }
+        if (_started && isRetune(newSettings)) {
+            requestRedesign();
+            return;
+        }
 
         try {
             updateFilter();
@@ -112,64 +219,59 @@ tap design.
         }
     }
 
-    [[nodiscard]] work::Status processBulk(std::span<const T> input, std::span<T> output) noexcept {
+    [[nodiscard]] work::Status processBulk(std::span<const T> input, std::span<TOut> output) noexcept {
         assert(decim > 0U);
         assert(output.size() >= requiredOutputCount(input.size()));
 
+        if (auto retuned = _redesign.poll()) {
+            stageFilter(std::move(*retuned));
+        }
+        if (_staged && _stagedMissing == 0UZ) { // chunk boundary: swap in the taps designed in the background
+            installFilter(std::move(*_staged));
+            _staged.reset();
+            publishWorkingSetHint();
+            debugPrintTapStats();
+        }
+
+        const std::size_t decimation = static_cast<std::size_t>(decim);
+        const std::size_t history    = _reversedTaps.size() - 1UZ;
+        const std::size_t first      = (decimation - static_cast<std::size_t>(_decimPhase)) % decimation;
+
+        detail::stageHead<T>(_tail, input, history);
         std::size_t out_sample_idx = 0UZ;
-        const bool  collectDebugStats = debugEnabled();
-        float       maxInputMagnitude = 0.F;
-        float       maxOutputMagnitude = 0.F;
-        bool        sawNonFiniteInput = false;
-        bool        sawNonFiniteOutput = false;
-        for (const auto& sample : input) {
-            if (collectDebugStats) {
+        if constexpr (kFixedPoint) {
+            out_sample_idx = detail::visitDecimatedWindows<T>(_tail, input, history, first, decimation, output.size(), [&](std::size_t m, const T* window) { output[m] = dsp_kernels::fromFixedPoint<R>(dsp_kernels::dot(window, _reversedTapsInt16.data(), _reversedTapsInt16.size()), _tapShift); });
+        } else if (kFftCapable && _useFft) {
+            out_sample_idx = _overlapSave.process(std::span<const T>(_tail).first(history), input, first, decimation, output);
+        } else {
+            out_sample_idx = detail::firDecimateSpan<T, CoeffType>(_tail, input, _reversedTaps, first, decimation, output);
+        }
+        detail::advanceHistory<T>(_tail, input, history);
+        if (_staged) {
+            detail::pushHistory<T>(_staged->tail, _staged->reversedTaps.size() - 1UZ, input);
+            _stagedMissing -= std::min(_stagedMissing, input.size());
+        }
+        _streamed += input.size();
+        _decimPhase = static_cast<uint32_t>((static_cast<std::size_t>(_decimPhase) + input.size()) % decimation);
+
+        if (debugEnabled()) {
+            float maxInputMagnitude  = 0.F;
+            float maxOutputMagnitude = 0.F;
+            bool  sawNonFiniteInput  = false;
+            bool  sawNonFiniteOutput = false;
+            for (const auto& sample : input) {
                 updateDebugSampleStats(sample, maxInputMagnitude, sawNonFiniteInput);
             }
-            _history.push_front(sample);
-            if (_decimPhase == 0U) {
-                auto filtered = filterCurrent();
-                if (collectDebugStats) {
-                    updateDebugSampleStats(filtered, maxOutputMagnitude, sawNonFiniteOutput);
-                }
-                output[out_sample_idx++] = filtered;
+            for (const auto& sample : output.first(out_sample_idx)) {
+                updateDebugSampleStats(sample, maxOutputMagnitude, sawNonFiniteOutput);
             }
-            _decimPhase = (_decimPhase + 1U) % decim;
-        }
-        if (collectDebugStats) {
             debugPrintProcessStats(input.size(), out_sample_idx, output.size(), maxInputMagnitude, maxOutputMagnitude, sawNonFiniteInput, sawNonFiniteOutput);
         }
         return work::Status::OK;
     }
 
     [[nodiscard]] std::size_t requiredOutputCount(std::size_t input_size) const noexcept {
-        if (input_size == 0UZ) {
-            return 0UZ;
-        }
-        return (input_size + (static_cast<std::size_t>(decim) - 1UZ - static_cast<std::size_t>(_decimPhase))) / static_cast<std::size_t>(decim);
-    }
-
-    [[nodiscard]] T filterCurrent() noexcept {
-        if constexpr (gr::meta::complex_like<T>) {
-            CoeffType real{};
-            CoeffType imag{};
-            auto      historyIt = _history.cbegin();
-            const auto nTaps = std::min(_taps.size(), _history.size());
-            for (std::size_t i = 0UZ; i < nTaps; ++i) {
-                const auto tap = _taps[i];
-                real += historyIt[i].real() * tap;
-                imag += historyIt[i].imag() * tap;
-            }
-            return T{real, imag};
-        } else {
-            CoeffType acc{};
-            auto      historyIt = _history.cbegin();
-            const auto nTaps = std::min(_taps.size(), _history.size());
-            for (std::size_t i = 0UZ; i < nTaps; ++i) {
-                acc += historyIt[i] * _taps[i];
-            }
-            return acc;
-        }
+        return detail::decimatedOutputCount(input_size, static_cast<std::size_t>(_decimPhase), static_cast<std::size_t>(decim));
     }
 
     void updateFilter() {
@@ -179,20 +281,74 @@ tap design.
         this->input_chunk_size = static_cast<gr::Size_t>(decim);
         this->output_chunk_size = 1UZ;
 
-        _taps = taps.value.empty() ? designTaps() : copyConfiguredTaps();
-        if (_taps.empty()) {
-            throw std::invalid_argument("FirDecimator requires at least one tap");
-        }
-        if (_taps.size() > _history.capacity()) {
-            _history = HistoryBuffer<T>(std::bit_ceil(_taps.size()));
-        } else {
-            _history.reset();
-        }
+        installFilter(prepareFilter(taps.value.empty() ? designTaps() : copyConfiguredTaps(), static_cast<std::size_t>(decim), fft_tap_threshold));
+        _redesign.cancel(); // designed from older settings
+        _staged.reset();
+        _streamed   = 0UZ;
         _decimPhase = 0U;
         _debugProcessCalls = 0UZ;
+        publishWorkingSetHint();
         debugPrintTapStats();
     }
 
+    [[nodiscard]] static PreparedFilter prepareFilter(std::vector<CoeffType> filterTaps, std::size_t decimation, uint32_t fftTapThreshold) {
+        if (filterTaps.empty()) {
+            throw std::invalid_argument("FirDecimator requires at least one tap");
+        }
+        PreparedFilter filter;
+        filter.reversedTaps.assign(filterTaps.crbegin(), filterTaps.crend());
+        if constexpr (kFixedPoint) {
+            filter.tapShift = dsp_kernels::int16TapShift(std::span<const CoeffType>(filter.reversedTaps));
+            filter.reversedTapsInt16.resize(filter.reversedTaps.size());
+            dsp_kernels::quantiseInt16(std::span<const CoeffType>(filter.reversedTaps), filter.tapShift, std::span<std::int16_t>(filter.reversedTapsInt16));
+        }
+        filter.useFft = kFftCapable && fftTapThreshold > 0U && filterTaps.size() >= static_cast<std::size_t>(fftTapThreshold) * decimation;
+        if (filter.useFft) {
+            filter.overlapSave.setTaps(std::span<const CoeffType>(filterTaps));
+        }
+        filter.tail.assign(2UZ * (filterTaps.size() - 1UZ), T{});
+        filter.taps = std::move(filterTaps);
+        return filter;
+    }
+
+    // only moves buffers: the tail comes with the filter, from prepareFilter() or filled by stageFilter()
+    void installFilter(PreparedFilter&& filter) noexcept {
+        _taps              = std::move(filter.taps);
+        _reversedTaps      = std::move(filter.reversedTaps);
+        _reversedTapsInt16 = std::move(filter.reversedTapsInt16);
+        _tapShift          = filter.tapShift;
+        _overlapSave       = std::move(filter.overlapSave);
+        _useFft            = filter.useFft;
+        _tail              = std::move(filter.tail);
+    }
+
+    // Seeds the tail of a background design with the current history. Taps with a longer history than the current ones
+    // stay staged until the samples from before the current history have left their window, so they never filter
+    // zeros that stand in for actual input (only those for samples before the start of the stream).
+    void stageFilter(PreparedFilter&& filter) noexcept {
+        const std::size_t oldHistory = _reversedTaps.size() - 1UZ;
+        const std::size_t newHistory = filter.reversedTaps.size() - 1UZ;
+        detail::pushHistory<T>(filter.tail, newHistory, std::span<const T>(_tail).first(oldHistory));
+        _staged        = std::move(filter);
+        _stagedMissing = _streamed > oldHistory ? newHistory - std::min(oldHistory, newHistory) : 0UZ;
+    }
+
+    [[nodiscard]] bool isRetune(const property_map& newSettings) const {
+        return taps.value.empty() && std::ranges::all_of(newSettings, [](const auto& setting) { return std::ranges::find(kRetuneSettings, std::string_view(setting.first)) != kRetuneSettings.end(); });
+    }
+
+    void requestRedesign() {
+        _redesign.request([spec = designSpec(), decimation = static_cast<std::size_t>(decim), fftTapThreshold = fft_tap_threshold.value] { return prepareFilter(detail::cachedFirTaps<CoeffType>(spec), decimation, fftTapThreshold); });
+    }
+
+    // working set per work() call for cache-fitted chunk planners: taps (or FFT buffers) + tail + input span + decimated output span
+    void publishWorkingSetHint() {
+        const std::size_t filterBytes    = kFixedPoint ? _reversedTapsInt16.size() * sizeof(std::int16_t) : (_useFft ? _overlapSave.bufferBytes() : _reversedTaps.size() * sizeof(CoeffType));
+        const double      fixedBytes     = static_cast<double>(filterBytes + _tail.size() * sizeof(T));
+        const double      bytesPerSample = static_cast<double>(sizeof(T)) + static_cast<double>(sizeof(TOut)) / static_cast<double>(decim);
+        dsp_kernels::publishWorkingSetHint(this->meta_information.value, fixedBytes, bytesPerSample);
+    }
+
     [[nodiscard]] bool canUpdateFilter() const noexcept {
         if (decim == 0U) {
             return false;
@@ -210,83 +366,21 @@ tap design.
         return copied;
     }
 
-    [[nodiscard]] std::vector<CoeffType> designTaps() const {
-        if (!(_designSampleRate > 0.F)) {
-            throw std::invalid_argument("FirDecimator sample_rate must be greater than zero");
-        }
-
-        auto designed = designFilterWithTapCount(effectiveNumTaps());
-        return std::move(designed.b);
-    }
-
-    [[nodiscard]] std::size_t effectiveNumTaps() const {
-        if (num_taps > 1U) {
-            return static_cast<std::size_t>(num_taps);
-        }
-        if (!(transition_width > 0.F)) {
-            throw std::invalid_argument("FirDecimator transition_width must be greater than zero when num_taps requests automatic tap estimation");
-        }
-        const double normalised_transition = static_cast<double>(transition_width) / static_cast<double>(_designSampleRate);
-        return std::max<std::size_t>(3UZ, gr::filter::fir::estimateNumberOfTapsKaiser(static_cast<double>(attenuation_db), 2.0 * std::numbers::pi * normalised_transition));
-    }
-
-    [[nodiscard]] gr::filter::FilterCoefficients<CoeffType> designFilterWithTapCount(std::size_t tap_count) const {
-        if (tap_count < 2UZ) {
-            throw std::invalid_argument("FirDecimator num_taps must resolve to at least two taps");
-        }
-        if (tap_count % 2UZ == 0UZ) {
-            ++tap_count;
-        }
-
-        const auto fs        = static_cast<CoeffType>(_designSampleRate);
-        const auto low       = static_cast<CoeffType>(f_low);
-        const auto high      = static_cast<CoeffType>(f_high);
-        const auto targetGain = static_cast<CoeffType>(gain);
-        const auto kaiserBeta = static_cast<CoeffType>(beta);
-
-        switch (filter_response) {
-        case gr::filter::Type::LOWPASS: {
-            auto coeffs = gr::filter::fir::generateCoefficients<CoeffType>(tap_count, window, low / fs, kaiserBeta);
-            normaliseOrThrow(coeffs, CoeffType{0}, targetGain);
-            return coeffs;
-        }
-        case gr::filter::Type::HIGHPASS: {
-            auto coeffs = gr::filter::fir::generateCoefficients<CoeffType>(tap_count, window, CoeffType{0.5} - high / fs, kaiserBeta);
-            for (std::size_t n = 0UZ; n < tap_count; ++n) {
-                coeffs.b[n] *= (n % 2UZ == 0UZ ? CoeffType{1} : CoeffType{-1});
-            }
-            normaliseOrThrow(coeffs, CoeffType{0.48}, targetGain);
-            return coeffs;
-        }
-        case gr::filter::Type::BANDPASS: {
-            auto coeffs     = gr::filter::fir::generateCoefficients<CoeffType>(tap_count, window, low / fs, kaiserBeta);
-            auto highPass   = gr::filter::fir::generateCoefficients<CoeffType>(tap_count, window, high / fs, kaiserBeta);
-            std::ranges::transform(coeffs.b, highPass.b, coeffs.b.begin(), std::minus<>{});
-            const auto centre = static_cast<CoeffType>(std::sqrt(static_cast<double>(f_high) * static_cast<double>(f_low)) / static_cast<double>(_designSampleRate));
-            normaliseOrThrow(coeffs, centre, targetGain);
-            return coeffs;
-        }
-        case gr::filter::Type::BANDSTOP: {
-            auto coeffs   = gr::filter::fir::generateCoefficients<CoeffType>(tap_count, window, low / fs, kaiserBeta);
-            auto highPass = gr::filter::fir::generateCoefficients<CoeffType>(tap_count, window, high / fs, kaiserBeta);
-            for (std::size_t n = 0UZ; n < tap_count; ++n) {
-                coeffs.b[n] -= highPass.b[n];
-                if (n == (tap_count - 1UZ) / 2UZ) {
-                    coeffs.b[n] = CoeffType{1} - coeffs.b[n];
-                }
-            }
-            normaliseOrThrow(coeffs, CoeffType{0}, targetGain);
-            return coeffs;
-        }
-        }
-        throw std::runtime_error("unexpected FirDecimator filter response");
-    }
-
-    static void normaliseOrThrow(gr::filter::FilterCoefficients<CoeffType>& coeffs, CoeffType normalisedFrequency, CoeffType targetGain) {
-        const auto [ok, magnitude] = gr::filter::normaliseFilterCoefficients(coeffs, normalisedFrequency, targetGain);
-        if (!ok) {
-            throw std::invalid_argument(std::format("FirDecimator gain correction failed at normalised frequency {} with magnitude {}", normalisedFrequency, magnitude));
-        }
+    [[nodiscard]] std::vector<CoeffType> designTaps() const { return detail::cachedFirTaps<CoeffType>(designSpec()); }
+
+    [[nodiscard]] detail::FirDesignSpec designSpec() const {
+        return detail::FirDesignSpec{
+            .response        = filter_response,
+            .sampleRate      = _designSampleRate,
+            .fLow            = f_low,
+            .fHigh           = f_high,
+            .transitionWidth = transition_width,
+            .numTaps         = static_cast<std::size_t>(num_taps),
+            .gain            = gain,
+            .attenuationDb   = attenuation_db,
+            .beta            = beta,
+            .window          = window,
+        };
     }
 
     [[nodiscard]] static bool debugEnabled() noexcept {
@@ -294,13 +388,18 @@ tap design.
         return value != nullptr && value[0] != '\0' && !(value[0] == '0' && value[1] == '\0');
     }
 
-    static void updateDebugSampleStats(const T& sample, float& maxMagnitude, bool& sawNonFinite) noexcept {
-        if constexpr (gr::meta::complex_like<T>) {
-            sawNonFinite = sawNonFinite || !std::isfinite(sample.real()) || !std::isfinite(sample.imag());
+    template<typename S>
+    static void updateDebugSampleStats(const S& sample, float& maxMagnitude, bool& sawNonFinite) noexcept {
+        float magnitude = 0.F;
+        if constexpr (gr::meta::complex_like<S>) {
+            const auto re = static_cast<float>(sample.real());
+            const auto im = static_cast<float>(sample.imag());
+            sawNonFinite  = sawNonFinite || !std::isfinite(re) || !std::isfinite(im);
+            magnitude     = std::hypot(re, im);
         } else {
-            sawNonFinite = sawNonFinite || !std::isfinite(sample);
+            sawNonFinite = sawNonFinite || !std::isfinite(static_cast<float>(sample));
+            magnitude    = std::abs(static_cast<float>(sample));
         }
-        const float magnitude = static_cast<float>(std::abs(sample));
         if (std::isfinite(magnitude)) {
             maxMagnitude = std::max(maxMagnitude, magnitude);
         }
@@ -315,7 +414,7 @@ tap design.
         const auto [minIt, maxIt] = std::ranges::minmax_element(_taps);
         const bool allFinite = std::ranges::all_of(_taps, [](CoeffType tap) { return std::isfinite(tap); });
         std::println(stderr,
-            "[FirDecimator] decim={} chunk={}->{} sample_rate={} active_design_sample_rate={} response={} f_low={} f_high={} transition_width={} attenuation_db={} num_taps={} tap_count={} tap_sum={} tap_min={} tap_max={} taps_finite={}",
+            "[FirDecimator] decim={} chunk={}->{} sample_rate={} active_design_sample_rate={} response={} f_low={} f_high={} transition_width={} attenuation_db={} num_taps={} tap_count={} mode={} tap_sum={} tap_min={} tap_max={} taps_finite={}",
             decim.value,
             this->input_chunk_size.value,
             this->output_chunk_size.value,
@@ -328,6 +427,7 @@ tap design.
             attenuation_db.value,
             num_taps.value,
             _taps.size(),
+            _useFft ? "fft" : "direct",
             sum,
             minIt == _taps.end() ? CoeffType{0} : *minIt,
             maxIt == _taps.end() ? CoeffType{0} : *maxIt,
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gnuradio-4.0/Block.hpp>
+#include <gnuradio-4.0/BlockRegistry.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/WorkingSetHint.hpp>
+#include <gnuradio-4.0/algorithm/filter/FilterTool.hpp>
+
+#include <gnuradio-4.0/filter/FirDecimator.hpp>
+#include <gnuradio-4.0/filter/detail/FirDesign.hpp>
+#include <gnuradio-4.0/filter/detail/FirKernels.hpp>
+
+namespace gr::incubator::filter {
+
+GR_REGISTER_BLOCK("gr::incubator::filter::FreqXlatingFirDecimator", gr::incubator::filter::FreqXlatingFirDecimator, ([T]), [ float, std::complex<float> ])
+
+template<typename T>
+requires(std::floating_point<T> || gr::meta::complex_like<T>)
+struct FreqXlatingFirDecimator : Block<FreqXlatingFirDecimator<T>, Resampling<1UZ, 1UZ, false>> {
+    using TParent     = Block<FreqXlatingFirDecimator<T>, Resampling<1UZ, 1UZ, false>>;
+    using Description = Doc<R""(@brief Frequency-translating FIR decimator
+
+Moves center_frequency to 0 Hz, filters and decimates by an integer factor, i.e.
+the same as a rotator by -center_frequency followed by FirDecimator, without
+mixing every input sample. The mixer is folded into the taps: the designed (or
+given) real prototype h[k] becomes the complex band-pass h[k] exp(j w k) around
+center_frequency, and only the retained outputs are rotated by exp(-j w n), at the
+output rate. Each output costs two complex-by-real dot products on the SIMD
+kernels of FirDecimator, or one while center_frequency is 0.
+
+Design parameters and taps behave as in FirDecimator. Changing center_frequency
+alone re-rotates the taps and keeps the filter history.
+)"">;
+    using CoeffType = detail::fir_decimator_coeff_type_t<T>;
+    using TOut      = std::complex<CoeffType>;
+
+    PortIn<T>     in;
+    PortOut<TOut> out;
+
+    Annotated<uint32_t, "decimation factor", Doc<"Factor by which to downsample after filtering">, Visible> decim{1U};
+    Annotated<float, "center_frequency", Doc<"Input frequency in Hz translated to 0 Hz">, Visible> center_frequency{0.F};
+    Annotated<Tensor<CoeffType>, "taps", Doc<"Optional real prototype taps, centred at 0 Hz. Empty taps mean design taps from the filter parameters.">, Visible> taps{};
+
+    Annotated<gr::filter::Type, "filter_response", Doc<"Filter response of the designed prototype">, Visible> filter_response{gr::filter::Type::LOWPASS};
+    Annotated<float, "f_low", Doc<"Low cutoff frequency in Hz relative to center_frequency. For LOWPASS this is the cutoff.">, Visible> f_low{100000.F};
+    Annotated<float, "f_high", Doc<"High cutoff frequency in Hz relative to center_frequency for BANDPASS/BANDSTOP/HIGHPASS">, Visible> f_high{0.F};
+    Annotated<float, "sample_rate", Doc<"Input stream sample rate in Hz used for tap design and translation">, Visible> sample_rate{1000000.F};
+    Annotated<float, "transition_width", Doc<"Approximate transition width in Hz when num_taps=0">, Visible> transition_width{50000.F};
+    Annotated<uint32_t, "num_taps", Doc<"Number of FIR taps. Set 0 or 1 to estimate from transition_width and attenuation_db.">, Visible> num_taps{0U};
+    Annotated<float, "gain", Doc<"Designed filter gain">> gain{1.F};
+    Annotated<float, "attenuation_db", Doc<"Stop-band attenuation used for automatic order estimation">> attenuation_db{60.F};
+    Annotated<float, "beta", Doc<"Kaiser beta used by GNU Radio 4's FIR designer">> beta{6.76F};
+    Annotated<gr::algorithm::window::Type, "window", Doc<"Window used for designed taps">> window{gr::algorithm::window::Type::Kaiser};
+
+    GR_MAKE_REFLECTABLE(FreqXlatingFirDecimator, in, out, decim, center_frequency, taps, filter_response, f_low, f_high, sample_rate, transition_width, num_taps, gain, attenuation_db, beta, window);
+
+    std::vector<CoeffType>                _taps{CoeffType{1}};             // real prototype
+    dsp_kernels::AlignedVector<CoeffType> _reversedTapsReal{CoeffType{1}}; // band-pass taps h[k] exp(j w k), reversed, split into
+    dsp_kernels::AlignedVector<CoeffType> _reversedTapsImag;               // real and imaginary parts; the latter empty at 0 Hz
+    std::vector<T>                        _tail; // last taps-1 input samples, followed by room for the head of the next input span
+    uint32_t                              _decimPhase{0U};
+    std::complex<double>                  _rotation{1.0}; // exp(-j w n) for the input index n of the next output
+    std::complex<double>                  _rotationStep{1.0};
+    float                                 _designSampleRate{1000000.F};
+
+    void start() {
+        if (sample_rate > 0.F) {
+            _designSampleRate = sample_rate;
+        }
+        updateFilter();
+    }
+
+    void settingsChanged(const property_map& /*oldSettings*/, const property_map& newSettings) {
+        if (decim == 0U) {
+            throw std::invalid_argument("FreqXlatingFirDecimator decim must be greater than zero");
+        }
+
+        this->input_chunk_size  = static_cast<gr::Size_t>(decim);
+        this->output_chunk_size = 1UZ;
+
+        if (newSettings.size() == 1UZ && newSettings.contains("sample_rate")) {
+            return;
+        }
+        if (newSettings.contains("sample_rate") && sample_rate > 0.F) {
+            _designSampleRate = sample_rate;
+        }
+        if (newSettings.size() == 1UZ && newSettings.contains("center_frequency")) {
+            updateTranslation(); // retune: same prototype and history, the output phase stays continuous
+            return;
+        }
+        if (!canUpdateFilter()) {
+            return;
+        }
+
+        try {
+            updateFilter();
+        } catch (...) {
+            // Settings may be applied in stages. start() performs the final
+            // validation once all staged parameters have been committed.
+        }
+    }
+
+    [[nodiscard]] work::Status processBulk(std::span<const T> input, std::span<TOut> output) noexcept {
+        assert(decim > 0U);
+        assert(output.size() >= requiredOutputCount(input.size()));
+
+        const std::size_t decimation = static_cast<std::size_t>(decim);
+        const std::size_t nTaps      = _reversedTapsReal.size();
+        const std::size_t history    = nTaps - 1UZ;
+        const std::size_t first      = (decimation - static_cast<std::size_t>(_decimPhase)) % decimation;
+
+        detail::stageHead<T>(_tail, input, history);
+        if (_reversedTapsImag.empty()) { // at 0 Hz the rotation stays at the phase reached by earlier retunes
+            const TOut rotation = static_cast<TOut>(_rotation);
+            detail::visitDecimatedWindows<T>(_tail, input, history, first, decimation, output.size(), [&](std::size_t m, const T* window) { output[m] = TOut(dsp_kernels::dot(window, _reversedTapsReal.data(), nTaps)) * rotation; });
+        } else {
+            detail::visitDecimatedWindows<T>(_tail, input, history, first, decimation, output.size(), [&](std::size_t m, const T* window) {
+                const T    re       = dsp_kernels::dot(window, _reversedTapsReal.data(), nTaps);
+                const T    im       = dsp_kernels::dot(window, _reversedTapsImag.data(), nTaps);
+                const TOut filtered = TOut(re) + TOut(CoeffType{0}, CoeffType{1}) * TOut(im);
+                output[m]           = filtered * static_cast<TOut>(_rotation);
+                _rotation *= _rotationStep;
+            });
+            _rotation /= std::abs(_rotation); // keeps the recursion on the unit circle
+        }
+        detail::advanceHistory<T>(_tail, input, history);
+        _decimPhase = static_cast<uint32_t>((static_cast<std::size_t>(_decimPhase) + input.size()) % decimation);
+        return work::Status::OK;
+    }
+
+    [[nodiscard]] std::size_t requiredOutputCount(std::size_t input_size) const noexcept {
+        return detail::decimatedOutputCount(input_size, static_cast<std::size_t>(_decimPhase), static_cast<std::size_t>(decim));
+    }
+
+    void updateFilter() {
+        if (decim == 0U) {
+            throw std::invalid_argument("FreqXlatingFirDecimator decim must be greater than zero");
+        }
+        this->input_chunk_size  = static_cast<gr::Size_t>(decim);
+        this->output_chunk_size = 1UZ;
+
+        _taps = taps.value.empty() ? detail::cachedFirTaps<CoeffType>(designSpec()) : std::vector<CoeffType>(taps.value.begin(), taps.value.end());
+        if (_taps.empty()) {
+            throw std::invalid_argument("FreqXlatingFirDecimator requires at least one tap");
+        }
+        _tail.assign(2UZ * (_taps.size() - 1UZ), T{});
+        _decimPhase = 0U;
+        _rotation   = 1.0;
+        updateTranslation();
+    }
+
+    // Rotates the prototype to center_frequency; the reversed taps keep their length, so the history stays valid.
+    void updateTranslation() {
+        if (!(_designSampleRate > 0.F)) {
+            throw std::invalid_argument("FreqXlatingFirDecimator sample_rate must be greater than zero");
+        }
+        const double      omega = 2.0 * std::numbers::pi * static_cast<double>(center_frequency) / static_cast<double>(_designSampleRate);
+        const std::size_t nTaps = _taps.size();
+        _reversedTapsReal.resize(nTaps);
+        _reversedTapsImag.resize(omega == 0.0 ? 0UZ : nTaps);
+        for (std::size_t k = 0UZ; k < nTaps; ++k) {
+            const std::complex<double> tap = static_cast<double>(_taps[k]) * std::polar(1.0, omega * static_cast<double>(k));
+            _reversedTapsReal[nTaps - 1UZ - k] = static_cast<CoeffType>(tap.real());
+            if (!_reversedTapsImag.empty()) {
+                _reversedTapsImag[nTaps - 1UZ - k] = static_cast<CoeffType>(tap.imag());
+            }
+        }
+        _rotationStep = std::polar(1.0, -omega * static_cast<double>(decim));
+        publishWorkingSetHint();
+    }
+
+    // working set per work() call for cache-fitted chunk planners: real and imaginary taps + tail + input span + decimated output span
+    void publishWorkingSetHint() {
+        const double fixedBytes     = static_cast<double>((_reversedTapsReal.size() + _reversedTapsImag.size()) * sizeof(CoeffType) + _tail.size() * sizeof(T));
+        const double bytesPerSample = static_cast<double>(sizeof(T)) + static_cast<double>(sizeof(TOut)) / static_cast<double>(decim);
+        dsp_kernels::publishWorkingSetHint(this->meta_information.value, fixedBytes, bytesPerSample);
+    }
+
+    [[nodiscard]] bool canUpdateFilter() const noexcept {
+        if (decim == 0U) {
+            return false;
+        }
+        if (!taps.value.empty()) {
+            return true;
+        }
+        return _designSampleRate > 0.F && transition_width > 0.F;
+    }
+
+    [[nodiscard]] detail::FirDesignSpec designSpec() const {
+        return detail::FirDesignSpec{
+            .response        = filter_response,
+            .sampleRate      = _designSampleRate,
+            .fLow            = f_low,
+            .fHigh           = f_high,
+            .transitionWidth = transition_width,
+            .numTaps         = static_cast<std::size_t>(num_taps),
+            .gain            = gain,
+            .attenuationDb   = attenuation_db,
+            .beta            = beta,
+            .window          = window,
+        };
+    }
+};
+
+} // namespace gr::incubator::filter
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <format>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gnuradio-4.0/Block.hpp>
+#include <gnuradio-4.0/BlockRegistry.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/WorkingSetHint.hpp>
+#include <gnuradio-4.0/algorithm/filter/FilterTool.hpp>
+
+#include <gnuradio-4.0/filter/FirDecimator.hpp>
+
+namespace gr::incubator::filter {
+
+GR_REGISTER_BLOCK("gr::incubator::filter::HalfbandDecimator", gr::incubator::filter::HalfbandDecimator, ([T]), [ float, std::complex<float> ])
+
+template<typename T>
+requires(std::floating_point<T> || gr::meta::complex_like<T>)
+struct HalfbandDecimator : Block<HalfbandDecimator<T>, Resampling<1UZ, 1UZ, false>> {
+    using TParent     = Block<HalfbandDecimator<T>, Resampling<1UZ, 1UZ, false>>;
+    using Description = Doc<R""(@brief Decimate-by-2 halfband low-pass filter
+
+Designs a halfband filter (cutoff at sample_rate / 4) of 4K-1 taps, of which only
+the centre tap and the K symmetric pairs at odd offsets from it are non-zero.
+Each output costs K multiplies for the folded pairs plus one for the centre,
+about a quarter of a generic FirDecimator with the same taps at decim=2. Intended
+as the building block of cascaded decimation from wideband captures.
+)"">;
+    using CoeffType = detail::fir_decimator_coeff_type_t<T>;
+
+    PortIn<T>  in;
+    PortOut<T> out;
+
+    Annotated<float, "sample_rate", Doc<"Input stream sample rate in Hz used for automatic tap estimation">, Visible> sample_rate{1000000.F};
+    Annotated<float, "transition_width", Doc<"Transition width in Hz around sample_rate / 4 when num_taps=0">, Visible> transition_width{50000.F};
+    Annotated<uint32_t, "num_taps", Doc<"Number of taps, rounded up to 4K-1. Set 0 or 1 to estimate from transition_width and attenuation_db.">, Visible> num_taps{0U};
+    Annotated<float, "gain", Doc<"Designed filter gain">> gain{1.F};
+    Annotated<float, "attenuation_db", Doc<"Stop-band attenuation used for automatic order estimation">> attenuation_db{60.F};
+    Annotated<float, "beta", Doc<"Kaiser beta used by GNU Radio 4's FIR designer">> beta{6.76F};
+    Annotated<gr::algorithm::window::Type, "window", Doc<"Window used for designed taps">> window{gr::algorithm::window::Type::Kaiser};
+
+    GR_MAKE_REFLECTABLE(HalfbandDecimator, in, out, sample_rate, transition_width, num_taps, gain, attenuation_db, beta, window);
+
+    static constexpr std::size_t kOutputBlock = 256UZ; // outputs accumulated per pass over the side taps, kept in L1
+
+    std::vector<CoeffType> _taps{CoeffType{1}}; // full 4K-1 taps, for reference and introspection
+    std::vector<CoeffType> _sideTaps;           // a_k at offsets +-(2k-1) from the centre, k = 1..K
+    CoeffType              _centreTap{1};
+    std::vector<T>         _tail;        // last 4K-2 input samples
+    std::vector<T>         _sidePhase;   // samples of the same parity as the outputs, i.e. those hit by the side taps
+    std::vector<T>         _centrePhase; // samples of the other parity, hit by the centre tap only
+    uint32_t               _decimPhase{0U};
+    float                  _designSampleRate{1000000.F}; // sample_rate the taps were estimated for
+
+    void start() {
+        if (sample_rate > 0.F) {
+            _designSampleRate = sample_rate;
+        }
+        updateFilter();
+    }
+
+    void settingsChanged(const property_map& /*oldSettings*/, const property_map& newSettings) {
+        this->input_chunk_size  = 2UZ;
+        this->output_chunk_size = 1UZ;
+        if (newSettings.size() == 1UZ && newSettings.contains("sample_rate")) {
+            return;
+        }
+        if (newSettings.contains("sample_rate") && sample_rate > 0.F) {
+            _designSampleRate = sample_rate;
+        }
+
+        try {
+            updateFilter();
+        } catch (...) {
+            // Settings may be applied in stages. start() performs the final
+            // validation once all staged parameters have been committed.
+        }
+    }
+
+    [[nodiscard]] work::Status processBulk(std::span<const T> input, std::span<T> output) noexcept {
+        assert(output.size() >= requiredOutputCount(input.size()));
+
+        const std::size_t nOut    = requiredOutputCount(input.size());
+        const std::size_t nSide   = _sideTaps.size();
+        const std::size_t history = _tail.size();
+        const std::size_t first   = (2UZ - static_cast<std::size_t>(_decimPhase)) % 2UZ;
+
+        // split tail ++ input into the two polyphase streams of this call: output m sees sidePhase[m .. m + 2K - 1]
+        // and centrePhase[m]
+        const auto sampleAt = [&](std::size_t i) -> const T& { return i < history ? _tail[i] : input[i - history]; };
+        if (_sidePhase.size() < nOut + 2UZ * nSide) {
+            _sidePhase.resize(nOut + 2UZ * nSide); // grows to the largest span seen, then stays allocated
+            _centrePhase.resize(nOut + 2UZ * nSide);
+        }
+        if (nOut > 0UZ) {
+            for (std::size_t j = 0UZ; j < nOut + 2UZ * nSide - 1UZ; ++j) {
+                _sidePhase[j] = sampleAt(first + 2UZ * j);
+            }
+            for (std::size_t m = 0UZ; m < nOut; ++m) {
+                _centrePhase[m] = sampleAt(first + 2UZ * m + 2UZ * nSide - 1UZ);
+            }
+        }
+
+        // output-major: every tap pair is one contiguous pass over a block of outputs
+        for (std::size_t block = 0UZ; block < nOut; block += kOutputBlock) {
+            const std::size_t n      = std::min(kOutputBlock, nOut - block);
+            T*                y      = output.data() + block;
+            const T*          side   = _sidePhase.data() + block;
+            const T*          centre = _centrePhase.data() + block;
+            for (std::size_t m = 0UZ; m < n; ++m) {
+                y[m] = centre[m] * _centreTap;
+            }
+            std::size_t k = 1UZ;
+            for (; k + 3UZ <= nSide; k += 4UZ) { // four tap pairs per pass, so that y is loaded and stored once for all of them
+                const CoeffType* a    = _sideTaps.data() + (k - 1UZ);
+                const T*         near = side + (nSide - k); // tap k + j pairs near - j with far + j
+                const T*         far  = side + (nSide - 1UZ + k);
+                const T*         n1   = near - 1;
+                const T*         n2   = near - 2;
+                const T*         n3   = near - 3;
+                for (std::size_t m = 0UZ; m < n; ++m) {
+                    y[m] += (near[m] + far[m]) * a[0] + (n1[m] + far[m + 1UZ]) * a[1] + (n2[m] + far[m + 2UZ]) * a[2] + (n3[m] + far[m + 3UZ]) * a[3];
+                }
+            }
+            for (; k <= nSide; ++k) {
+                const CoeffType a    = _sideTaps[k - 1UZ];
+                const T*        near = side + (nSide - k);
+                const T*        far  = side + (nSide - 1UZ + k);
+                for (std::size_t m = 0UZ; m < n; ++m) {
+                    y[m] += (near[m] + far[m]) * a;
+                }
+            }
+        }
+
+        if (input.size() >= history) {
+            std::ranges::copy(input.last(history), _tail.begin());
+        } else {
+            std::copy(_tail.begin() + static_cast<std::ptrdiff_t>(input.size()), _tail.end(), _tail.begin());
+            std::ranges::copy(input, _tail.end() - static_cast<std::ptrdiff_t>(input.size()));
+        }
+        _decimPhase = static_cast<uint32_t>((static_cast<std::size_t>(_decimPhase) + input.size()) % 2UZ);
+        return work::Status::OK;
+    }
+
+    [[nodiscard]] std::size_t requiredOutputCount(std::size_t input_size) const noexcept {
+        return detail::decimatedOutputCount(input_size, static_cast<std::size_t>(_decimPhase), 2UZ);
+    }
+
+    void updateFilter() {
+        this->input_chunk_size  = 2UZ;
+        this->output_chunk_size = 1UZ;
+
+        const std::size_t nSide  = (effectiveNumTaps() + 1UZ + 3UZ) / 4UZ; // smallest K with 4K-1 >= requested taps
+        const std::size_t nTaps  = 4UZ * nSide - 1UZ;
+        const std::size_t centre = 2UZ * nSide - 1UZ;
+
+        // windowed sinc at a quarter of the sample rate; its taps at even offsets from the centre vanish
+        auto coeffs = gr::filter::fir::generateCoefficients<CoeffType>(nTaps, window, CoeffType{0.25}, static_cast<CoeffType>(beta));
+        if (const auto [ok, magnitude] = gr::filter::normaliseFilterCoefficients(coeffs, CoeffType{0}, static_cast<CoeffType>(gain)); !ok) {
+            throw std::invalid_argument(std::format("HalfbandDecimator gain correction failed with magnitude {}", magnitude));
+        }
+
+        _centreTap = coeffs.b[centre];
+        _sideTaps.resize(nSide);
+        _taps.assign(nTaps, CoeffType{0});
+        _taps[centre] = _centreTap;
+        for (std::size_t k = 1UZ; k <= nSide; ++k) {
+            const CoeffType a               = CoeffType{0.5} * (coeffs.b[centre - (2UZ * k - 1UZ)] + coeffs.b[centre + (2UZ * k - 1UZ)]);
+            _sideTaps[k - 1UZ]              = a;
+            _taps[centre - (2UZ * k - 1UZ)] = a;
+            _taps[centre + (2UZ * k - 1UZ)] = a;
+        }
+        _tail.assign(nTaps - 1UZ, T{});
+        _decimPhase = 0U;
+        publishWorkingSetHint();
+    }
+
+    // working set per work() call for cache-fitted chunk planners: taps + tail + input span + polyphase copies + output span
+    void publishWorkingSetHint() {
+        const double fixedBytes     = static_cast<double>((_sideTaps.size() + 1UZ) * sizeof(CoeffType) + _tail.size() * sizeof(T));
+        const double bytesPerSample = static_cast<double>(sizeof(T)) * 2.5;
+        dsp_kernels::publishWorkingSetHint(this->meta_information.value, fixedBytes, bytesPerSample);
+    }
+
+    [[nodiscard]] std::size_t effectiveNumTaps() const {
+        if (num_taps > 1U) {
+            return static_cast<std::size_t>(num_taps);
+        }
+        if (!(_designSampleRate > 0.F) || !(transition_width > 0.F)) {
+            throw std::invalid_argument("HalfbandDecimator sample_rate and transition_width must be greater than zero when num_taps requests automatic tap estimation");
+        }
+        const double normalised_transition = static_cast<double>(transition_width) / static_cast<double>(_designSampleRate);
+        return std::max<std::size_t>(3UZ, gr::filter::fir::estimateNumberOfTapsKaiser(static_cast<double>(attenuation_db), 2.0 * std::numbers::pi * normalised_transition));
+    }
+};
+
+} // namespace gr::incubator::filter
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstdlib>
+#include <format>
+#include <numbers>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gnuradio-4.0/Block.hpp>
+#include <gnuradio-4.0/BlockRegistry.hpp>
+#include <gnuradio-4.0/algorithm/filter/FilterTool.hpp>
+
+#include <gnuradio-4.0/filter/FirDecimator.hpp>
+#include <gnuradio-4.0/filter/detail/DecimationPlanner.hpp>
+#include <gnuradio-4.0/filter/detail/FirKernels.hpp>
+
+namespace gr::incubator::filter {
+
+GR_REGISTER_BLOCK("gr::incubator::filter::MultiStageDecimator", gr::incubator::filter::MultiStageDecimator, ([T]), [ float, std::complex<float> ])
+
+template<typename T>
+requires(std::floating_point<T> || gr::meta::complex_like<T>)
+struct MultiStageDecimator : Block<MultiStageDecimator<T>, Resampling<1UZ, 1UZ, false>> {
+    using TParent     = Block<MultiStageDecimator<T>, Resampling<1UZ, 1UZ, false>>;
+    using Description = Doc<R""(@brief Low-pass decimator that splits a large decimation factor into cascaded FIR stages
+
+The decimation factor is factored into up to max_stages stages. The last stage
+implements the requested low-pass (f_low, transition_width, attenuation_db) at
+the final rate, while earlier stages only prevent aliasing into the pass band
+and can use wide transition bands with few taps. Of all factorisations the one
+with the fewest multiply-accumulates per output sample is used; it is published
+as meta_information "decimation_plan" (e.g. "10x5x4 taps=15/23/187
+macs_per_output=1131") and "macs_per_output".
+)"">;
+    using CoeffType = detail::fir_decimator_coeff_type_t<T>;
+
+    PortIn<T>  in;
+    PortOut<T> out;
+
+    Annotated<uint32_t, "decimation factor", Doc<"Total factor by which to downsample">, Visible> decim{1U};
+    Annotated<float, "f_low", Doc<"Low-pass cutoff frequency in Hz">, Visible> f_low{100000.F};
+    Annotated<float, "sample_rate", Doc<"Input stream sample rate in Hz">, Visible> sample_rate{1000000.F};
+    Annotated<float, "transition_width", Doc<"Transition width in Hz of the final response">, Visible> transition_width{50000.F};
+    Annotated<uint32_t, "max_stages", Doc<"Maximum number of cascaded stages; 1 designs a single FIR decimator">, Visible> max_stages{4U};
+    Annotated<float, "gain", Doc<"Pass-band gain of the cascade">> gain{1.F};
+    Annotated<float, "attenuation_db", Doc<"Stop-band attenuation of every stage">> attenuation_db{60.F};
+    Annotated<float, "beta", Doc<"Kaiser beta used by GNU Radio 4's FIR designer">> beta{6.76F};
+    Annotated<gr::algorithm::window::Type, "window", Doc<"Window used for designed taps">> window{gr::algorithm::window::Type::Kaiser};
+
+    GR_MAKE_REFLECTABLE(MultiStageDecimator, in, out, decim, f_low, sample_rate, transition_width, max_stages, gain, attenuation_db, beta, window);
+
+    struct Stage {
+        std::size_t                           decim{1UZ};
+        dsp_kernels::AlignedVector<CoeffType> reversedTaps{CoeffType{1}};
+        std::vector<T>                        tail;
+        std::size_t                           phase{0UZ};
+        std::vector<T>                        output; // input of the next stage
+    };
+
+    detail::DecimationPlan _plan;
+    std::vector<Stage>     _stages;
+    uint32_t               _decimPhase{0U};
+
+    void start() { updateFilter(); }
+
+    void settingsChanged(const property_map& /*oldSettings*/, const property_map& newSettings) {
+        if (decim == 0U) {
+            throw std::invalid_argument("MultiStageDecimator decim must be greater than zero");
+        }
+        this->input_chunk_size  = static_cast<gr::Size_t>(decim);
+        this->output_chunk_size = 1UZ;
+        if (newSettings.size() == 1UZ && newSettings.contains("sample_rate")) {
+            return;
+        }
+        if (!(sample_rate > 0.F) || !(transition_width > 0.F)) {
+            return;
+        }
+
+        try {
+            updateFilter();
+        } catch (...) {
+            // Settings may be applied in stages. start() performs the final
+            // validation once all staged parameters have been committed.
+        }
+    }
+
+    [[nodiscard]] work::Status processBulk(std::span<const T> input, std::span<T> output) noexcept {
+        assert(decim > 0U);
+        assert(output.size() >= requiredOutputCount(input.size()));
+
+        // each stage writes into its own buffer, which is the input of the next one; the last stage writes the output
+        std::span<const T> stageInput = input;
+        for (std::size_t i = 0UZ; i < _stages.size(); ++i) {
+            Stage&            stage   = _stages[i];
+            const std::size_t history = stage.reversedTaps.size() - 1UZ;
+            const std::size_t first   = (stage.decim - stage.phase) % stage.decim;
+            const std::size_t nOut    = detail::decimatedOutputCount(stageInput.size(), stage.phase, stage.decim);
+            if (i + 1UZ < _stages.size() && stage.output.size() < nOut) {
+                stage.output.resize(nOut); // grows to the largest span seen, then stays allocated
+            }
+            const std::span<T> stageOutput = i + 1UZ < _stages.size() ? std::span<T>(stage.output).first(nOut) : output;
+
+            detail::stageHead<T>(stage.tail, stageInput, history);
+            const std::size_t produced = detail::firDecimateSpan<T, CoeffType>(stage.tail, stageInput, stage.reversedTaps, first, stage.decim, stageOutput);
+            detail::advanceHistory<T>(stage.tail, stageInput, history);
+            stage.phase = (stage.phase + stageInput.size()) % stage.decim;
+            stageInput  = stageOutput.first(produced);
+        }
+        _decimPhase = static_cast<uint32_t>((static_cast<std::size_t>(_decimPhase) + input.size()) % static_cast<std::size_t>(decim));
+        return work::Status::OK;
+    }
+
+    [[nodiscard]] std::size_t requiredOutputCount(std::size_t input_size) const noexcept {
+        return detail::decimatedOutputCount(input_size, static_cast<std::size_t>(_decimPhase), static_cast<std::size_t>(decim));
+    }
+
+    void updateFilter() {
+        if (decim == 0U) {
+            throw std::invalid_argument("MultiStageDecimator decim must be greater than zero");
+        }
+        if (!(sample_rate > 0.F)) {
+            throw std::invalid_argument("MultiStageDecimator sample_rate must be greater than zero");
+        }
+        this->input_chunk_size  = static_cast<gr::Size_t>(decim);
+        this->output_chunk_size = 1UZ;
+
+        const double attenuation = static_cast<double>(attenuation_db);
+        _plan                    = detail::planDecimation(static_cast<std::size_t>(decim), static_cast<double>(sample_rate), static_cast<double>(f_low), static_cast<double>(transition_width), static_cast<std::size_t>(max_stages),
+            [attenuation](double normalisedTransition) { return gr::filter::fir::estimateNumberOfTapsKaiser(attenuation, normalisedTransition); });
+
+        _stages.clear();
+        for (std::size_t i = 0UZ; i < _plan.stages.size(); ++i) {
+            const detail::DecimationStage& spec      = _plan.stages[i];
+            const CoeffType                stageGain = i + 1UZ == _plan.stages.size() ? static_cast<CoeffType>(gain) : CoeffType{1}; // earlier stages are unity gain
+
+            auto coeffs                = gr::filter::fir::generateCoefficients<CoeffType>(spec.numTaps, window, static_cast<CoeffType>(spec.cutoff / spec.inputRate), static_cast<CoeffType>(beta));
+            const auto [ok, magnitude] = gr::filter::normaliseFilterCoefficients(coeffs, CoeffType{0}, stageGain);
+            if (!ok) {
+                throw std::invalid_argument(std::format("MultiStageDecimator gain correction of stage {} failed with magnitude {}", i, magnitude));
+            }
+            Stage& stage = _stages.emplace_back();
+            stage.decim  = spec.decim;
+            stage.reversedTaps.assign(coeffs.b.crbegin(), coeffs.b.crend());
+            stage.tail.assign(2UZ * (coeffs.b.size() - 1UZ), T{});
+        }
+        _decimPhase = 0U;
+        publishPlan();
+    }
+
+    void publishPlan() {
+        auto& meta = this->meta_information.value;
+        meta.insert_or_assign(std::pmr::string("decimation_plan", meta.get_allocator().resource()), gr::pmt::Value(_plan.toString()));
+        meta.insert_or_assign(std::pmr::string("macs_per_output", meta.get_allocator().resource()), gr::pmt::Value(_plan.macsPerOutput));
+        if (FirDecimator<T>::debugEnabled()) {
+            std::println(stderr, "[MultiStageDecimator] decim={} sample_rate={} f_low={} transition_width={} plan={}", decim.value, sample_rate.value, f_low.value, transition_width.value, _plan.toString());
+        }
+    }
+};
+
+} // namespace gr::incubator::filter
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gr::incubator::filter::detail {
+
+struct DecimationStage {
+    std::size_t decim{1UZ};
+    std::size_t numTaps{1UZ};
+    double      inputRate{0.0};  // Hz
+    double      cutoff{0.0};     // Hz, centre of the transition band
+    double      transition{0.0}; // Hz
+};
+
+struct DecimationPlan {
+    std::vector<DecimationStage> stages;
+    double                       macsPerOutput{0.0};
+
+    // e.g. "10x5x4 taps=15/23/187 macs_per_output=1131"
+    [[nodiscard]] std::string toString() const {
+        std::string factors;
+        std::string taps;
+        for (const DecimationStage& stage : stages) {
+            factors += std::format("{}{}", factors.empty() ? "" : "x", stage.decim);
+            taps += std::format("{}{}", taps.empty() ? "" : "/", stage.numTaps);
+        }
+        return std::format("{} taps={} macs_per_output={:.0f}", factors, taps, macsPerOutput);
+    }
+};
+
+// Splits decimation by `decim` into up to `maxStages` cascaded low-pass decimators and returns the split with the fewest
+// multiply-accumulates per output sample (fewer stages on ties). The last stage implements the requested response
+// (cutoff, transitionWidth) at the final rate; every earlier stage only has to keep [0, cutoff - transitionWidth / 2]
+// free of aliases from the bands folded by its own rate change, which allows a wide transition band and few taps:
+// its stop band starts at outputRate - (cutoff + transitionWidth / 2). estimateTaps maps the normalised transition
+// width (radians per sample) to a tap count, e.g. gr::filter::fir::estimateNumberOfTapsKaiser at the design attenuation.
+[[nodiscard]] inline DecimationPlan planDecimation(std::size_t decim, double sampleRate, double cutoff, double transitionWidth, std::size_t maxStages, const std::function<std::size_t(double)>& estimateTaps) {
+    if (decim == 0UZ || !(sampleRate > 0.0) || !(transitionWidth > 0.0)) {
+        throw std::invalid_argument("planDecimation requires decim > 0, sample_rate > 0 and transition_width > 0");
+    }
+    const double passEdge = std::max(0.0, cutoff - 0.5 * transitionWidth);
+    const double stopEdge = cutoff + 0.5 * transitionWidth;
+
+    const auto tapsFor = [&](double transition, double inputRate) {
+        std::size_t taps = std::max<std::size_t>(3UZ, estimateTaps(2.0 * std::numbers::pi * transition / inputRate));
+        return taps % 2UZ == 0UZ ? taps + 1UZ : taps; // odd, as designed by FirDecimator
+    };
+
+    // fills `plan` for a candidate split; false if an intermediate stage cannot protect the pass band
+    const auto evaluate = [&](const std::vector<std::size_t>& factors, DecimationPlan& plan) {
+        plan.stages.clear();
+        double rate = sampleRate;
+        for (std::size_t i = 0UZ; i < factors.size(); ++i) {
+            const double    outputRate = rate / static_cast<double>(factors[i]);
+            DecimationStage stage{.decim = factors[i], .inputRate = rate};
+            if (i + 1UZ == factors.size()) {
+                stage.cutoff     = cutoff;
+                stage.transition = transitionWidth;
+            } else {
+                const double stageStop = outputRate - stopEdge;
+                if (stageStop <= passEdge) {
+                    return false;
+                }
+                stage.cutoff     = 0.5 * (passEdge + stageStop);
+                stage.transition = stageStop - passEdge;
+            }
+            stage.numTaps = tapsFor(stage.transition, rate);
+            plan.stages.push_back(stage);
+            rate = outputRate;
+        }
+        // stage i computes one output per decimated sample, i.e. prod(decim_j, j > i) outputs per final output
+        plan.macsPerOutput     = 0.0;
+        double outputsPerFinal = 1.0;
+        for (auto stage = plan.stages.rbegin(); stage != plan.stages.rend(); ++stage) {
+            plan.macsPerOutput += static_cast<double>(stage->numTaps) * outputsPerFinal;
+            outputsPerFinal *= static_cast<double>(stage->decim);
+        }
+        return true;
+    };
+
+    const std::size_t        stageLimit = std::max<std::size_t>(1UZ, maxStages);
+    DecimationPlan           best;
+    DecimationPlan           candidate;
+    std::vector<std::size_t> factors;
+    best.macsPerOutput = std::numeric_limits<double>::infinity();
+
+    // factors holds the earlier stages; `remaining` is either the last stage or split further
+    const std::function<void(std::size_t)> search = [&](std::size_t remaining) {
+        factors.push_back(remaining);
+        if (evaluate(factors, candidate) && (candidate.macsPerOutput < best.macsPerOutput || (candidate.macsPerOutput == best.macsPerOutput && candidate.stages.size() < best.stages.size()))) {
+            best = candidate;
+        }
+        factors.pop_back();
+        if (factors.size() + 2UZ > stageLimit) {
+            return;
+        }
+        for (std::size_t factor = 2UZ; factor < remaining; ++factor) {
+            if (remaining % factor == 0UZ) {
+                factors.push_back(factor);
+                search(remaining / factor);
+                factors.pop_back();
+            }
+        }
+    };
+    search(decim);
+    return best;
+}
+
+} // namespace gr::incubator::filter::detail
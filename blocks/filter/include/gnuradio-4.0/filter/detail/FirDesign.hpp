@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gnuradio-4.0/algorithm/dsp_kernels/TapCache.hpp>
+#include <gnuradio-4.0/algorithm/filter/FilterTool.hpp>
+
+namespace gr::incubator::filter::detail {
+
+// Everything that determines a designed FIR, in the units of the block settings; equal specs give identical taps.
+struct FirDesignSpec {
+    gr::filter::Type            response{gr::filter::Type::LOWPASS};
+    float                       sampleRate{1000000.F};
+    float                       fLow{100000.F};
+    float                       fHigh{0.F};
+    float                       transitionWidth{50000.F};
+    std::size_t                 numTaps{0UZ}; // 0 or 1 estimates the count from transitionWidth and attenuationDb
+    float                       gain{1.F};
+    float                       attenuationDb{60.F};
+    float                       beta{6.76F};
+    gr::algorithm::window::Type window{gr::algorithm::window::Type::Kaiser};
+
+    bool operator==(const FirDesignSpec&) const = default;
+};
+
+template<typename C>
+void normaliseFirOrThrow(gr::filter::FilterCoefficients<C>& coeffs, C normalisedFrequency, C targetGain) {
+    const auto [ok, magnitude] = gr::filter::normaliseFilterCoefficients(coeffs, normalisedFrequency, targetGain);
+    if (!ok) {
+        throw std::invalid_argument(std::format("FIR gain correction failed at normalised frequency {} with magnitude {}", normalisedFrequency, magnitude));
+    }
+}
+
+[[nodiscard]] inline std::size_t firTapCount(const FirDesignSpec& spec) {
+    if (spec.numTaps > 1UZ) {
+        return spec.numTaps;
+    }
+    if (!(spec.transitionWidth > 0.F)) {
+        throw std::invalid_argument("FIR transition_width must be greater than zero when num_taps requests automatic tap estimation");
+    }
+    const double normalised_transition = static_cast<double>(spec.transitionWidth) / static_cast<double>(spec.sampleRate);
+    return std::max<std::size_t>(3UZ, gr::filter::fir::estimateNumberOfTapsKaiser(static_cast<double>(spec.attenuationDb), 2.0 * std::numbers::pi * normalised_transition));
+}
+
+// Windowed-sinc design of the spec's response with an odd number of taps, normalised to `gain` in the pass band.
+template<typename C>
+[[nodiscard]] std::vector<C> designFirTaps(const FirDesignSpec& spec) {
+    if (!(spec.sampleRate > 0.F)) {
+        throw std::invalid_argument("FIR sample_rate must be greater than zero");
+    }
+    std::size_t tap_count = firTapCount(spec);
+    if (tap_count < 2UZ) {
+        throw std::invalid_argument("FIR num_taps must resolve to at least two taps");
+    }
+    if (tap_count % 2UZ == 0UZ) {
+        ++tap_count;
+    }
+
+    const auto fs         = static_cast<C>(spec.sampleRate);
+    const auto low        = static_cast<C>(spec.fLow);
+    const auto high       = static_cast<C>(spec.fHigh);
+    const auto targetGain = static_cast<C>(spec.gain);
+    const auto kaiserBeta = static_cast<C>(spec.beta);
+
+    switch (spec.response) {
+    case gr::filter::Type::LOWPASS: {
+        auto coeffs = gr::filter::fir::generateCoefficients<C>(tap_count, spec.window, low / fs, kaiserBeta);
+        normaliseFirOrThrow(coeffs, C{0}, targetGain);
+        return std::move(coeffs.b);
+    }
+    case gr::filter::Type::HIGHPASS: {
+        auto coeffs = gr::filter::fir::generateCoefficients<C>(tap_count, spec.window, C{0.5} - high / fs, kaiserBeta);
+        for (std::size_t n = 0UZ; n < tap_count; ++n) {
+            coeffs.b[n] *= (n % 2UZ == 0UZ ? C{1} : C{-1});
+        }
+        normaliseFirOrThrow(coeffs, C{0.48}, targetGain);
+        return std::move(coeffs.b);
+    }
+    case gr::filter::Type::BANDPASS: {
+        auto coeffs   = gr::filter::fir::generateCoefficients<C>(tap_count, spec.window, low / fs, kaiserBeta);
+        auto highPass = gr::filter::fir::generateCoefficients<C>(tap_count, spec.window, high / fs, kaiserBeta);
+        std::ranges::transform(coeffs.b, highPass.b, coeffs.b.begin(), std::minus<>{});
+        const auto centre = static_cast<C>(std::sqrt(static_cast<double>(spec.fHigh) * static_cast<double>(spec.fLow)) / static_cast<double>(spec.sampleRate));
+        normaliseFirOrThrow(coeffs, centre, targetGain);
+        return std::move(coeffs.b);
+    }
+    case gr::filter::Type::BANDSTOP: {
+        auto coeffs   = gr::filter::fir::generateCoefficients<C>(tap_count, spec.window, low / fs, kaiserBeta);
+        auto highPass = gr::filter::fir::generateCoefficients<C>(tap_count, spec.window, high / fs, kaiserBeta);
+        for (std::size_t n = 0UZ; n < tap_count; ++n) {
+            coeffs.b[n] -= highPass.b[n];
+            if (n == (tap_count - 1UZ) / 2UZ) {
+                coeffs.b[n] = C{1} - coeffs.b[n];
+            }
+        }
+        normaliseFirOrThrow(coeffs, C{0}, targetGain);
+        return std::move(coeffs.b);
+    }
+    }
+    throw std::runtime_error("unexpected FIR filter response");
+}
+
+// designFirTaps() through the process-wide tap cache: retunes back to an earlier spec, further blocks with the same
+// spec and (with GR4_TAP_CACHE_DIR) restarts reuse the taps instead of designing them again.
+inline constexpr std::uint32_t kFirDesignVersion = 1U; // bump when designFirTaps() output changes for the same spec
+
+template<typename C>
+[[nodiscard]] std::vector<C> cachedFirTaps(const FirDesignSpec& spec) {
+    const std::string key = dsp_kernels::tapCacheKey("FirDesign", kFirDesignVersion, sizeof(C), spec.response, spec.sampleRate, spec.fLow, spec.fHigh, spec.transitionWidth, spec.numTaps, spec.gain, spec.attenuationDb, spec.beta, spec.window);
+    return *dsp_kernels::TapCache<C>::instance().getOrDesign(key, [&spec] { return designFirTaps<C>(spec); });
+}
+
+} // namespace gr::incubator::filter::detail
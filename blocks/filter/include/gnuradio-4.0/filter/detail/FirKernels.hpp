@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <span>
+
+#include <gnuradio-4.0/algorithm/dsp_kernels/DotProduct.hpp>
+
+namespace gr::incubator::filter::detail {
+
+// Number of outputs of a decimator that keeps every decim-th input, starting with the first one of the stream, over the
+// next n inputs when `phase` inputs (mod decim) have been consumed so far.
+[[nodiscard]] constexpr std::size_t decimatedOutputCount(std::size_t n, std::size_t phase, std::size_t decim) noexcept {
+    const std::size_t first = (decim - phase) % decim;
+    return n > first ? (n - first + decim - 1UZ) / decim : 0UZ;
+}
+
+// Decimating FIR over a contiguous signal: out[m] is the filter output for sample x[first + m * decim], where the
+// window of that sample (the h.size() - 1 samples before it) must lie within x. Taps are stored in reverse order so
+// that each output is one forward dot product. Returns the number of outputs written.
+template<typename T, typename C>
+inline std::size_t firDecimate(std::span<const T> x, std::span<const C> reversedTaps, std::size_t first, std::size_t decim, std::span<T> out) noexcept {
+    const std::size_t history = reversedTaps.size() - 1UZ;
+    std::size_t       m       = 0UZ;
+    for (std::size_t k = first; k < x.size() && m < out.size(); k += decim) {
+        out[m++] = dsp_kernels::dot(x.data() + (k - history), reversedTaps.data(), reversedTaps.size());
+    }
+    return m;
+}
+
+// Streaming state of a decimating FIR keeps the last `history` = taps-1 input samples at the front of a buffer of
+// 2 * history samples. stageHead() copies the head of the next input span behind them, so that firDecimateSpan() can
+// compute the outputs whose window straddles both spans over contiguous memory and all others directly on the input.
+template<typename T>
+inline void stageHead(std::span<T> tail, std::span<const T> input, std::size_t history) noexcept {
+    std::ranges::copy(input.first(std::min(history, input.size())), tail.begin() + static_cast<std::ptrdiff_t>(history));
+}
+
+// Calls visit(m, window) for the m-th of input[first], input[first + decim], ... (at most maxOut of them), where window
+// points to the history + 1 contiguous samples ending at that input, given the state prepared by stageHead().
+template<typename T, typename Visit>
+inline std::size_t visitDecimatedWindows(std::span<const T> tail, std::span<const T> input, std::size_t history, std::size_t first, std::size_t decim, std::size_t maxOut, Visit&& visit) noexcept {
+    const std::size_t nHead = std::min(history, input.size());
+    std::size_t       m     = 0UZ;
+    for (std::size_t k = history + first; k < history + nHead && m < maxOut; k += decim) { // windows straddling the previous span
+        visit(m++, tail.data() + (k - history));
+    }
+    for (std::size_t k = first + m * decim; k < input.size() && m < maxOut; k += decim) {
+        visit(m++, input.data() + (k - history));
+    }
+    return m;
+}
+
+// Outputs for input[first], input[first + decim], ... given the state prepared by stageHead().
+template<typename T, typename C>
+inline std::size_t firDecimateSpan(std::span<const T> tail, std::span<const T> input, std::span<const C> reversedTaps, std::size_t first, std::size_t decim, std::span<T> out) noexcept {
+    return visitDecimatedWindows<T>(tail, input, reversedTaps.size() - 1UZ, first, decim, out.size(), [&](std::size_t m, const T* window) { out[m] = dsp_kernels::dot(window, reversedTaps.data(), reversedTaps.size()); });
+}
+
+// Advances the history over the input span; requires the head staged by stageHead().
+template<typename T>
+inline void advanceHistory(std::span<T> tail, std::span<const T> input, std::size_t history) noexcept {
+    if (input.size() >= history) {
+        std::ranges::copy(input.last(history), tail.begin());
+    } else {
+        std::ranges::copy(tail | std::views::drop(input.size()) | std::views::take(history), tail.begin());
+    }
+}
+
+// Appends the input span to the `history` most recent samples at the front of the tail, without a staged head; used
+// to fill the tail of a filter that is not active yet.
+template<typename T>
+inline void pushHistory(std::span<T> tail, std::size_t history, std::span<const T> input) noexcept {
+    const std::size_t n = std::min(history, input.size());
+    std::shift_left(tail.begin(), tail.begin() + static_cast<std::ptrdiff_t>(history), static_cast<std::ptrdiff_t>(n));
+    std::ranges::copy(input.last(n), tail.begin() + static_cast<std::ptrdiff_t>(history - n));
+}
+
+} // namespace gr::incubator::filter::detail
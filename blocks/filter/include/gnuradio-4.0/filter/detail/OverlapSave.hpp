@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <gnuradio-4.0/algorithm/dsp_kernels/Fft.hpp>
+
+namespace gr::incubator::filter::detail {
+
+// Overlap-save fast convolution with real taps, decimating the filtered output. Each FFT block holds the taps-1
+// samples preceding a segment plus up to segmentLength() new samples; the outputs of the segment have their complete
+// window inside the block and are therefore exact, also for a partially filled (zero-padded) last block. Real input is
+// filtered two segments per FFT, one in the real and one in the imaginary part, since real taps keep them separate.
+template<typename T>
+class OverlapSave {
+public:
+    using value_type = T;
+
+    // fft size is the power of two at or above 4 * taps, leaving roughly three quarters of every FFT for new samples
+    template<typename C>
+    void setTaps(std::span<const C> taps) {
+        _nTaps = taps.size();
+        _fft   = dsp_kernels::Radix2Fft(std::bit_ceil(std::max<std::size_t>(64UZ, 4UZ * _nTaps)));
+
+        const std::size_t n = _fft.size();
+        _hRe.assign(n, 0.F);
+        _hIm.assign(n, 0.F);
+        for (std::size_t j = 0UZ; j < _nTaps; ++j) {
+            _hRe[j] = static_cast<float>(taps[j]) / static_cast<float>(n); // folds the scaling of the unscaled inverse
+        }
+        _fft.forward(_hRe.data(), _hIm.data());
+        _re.assign(n, 0.F);
+        _im.assign(n, 0.F);
+    }
+
+    [[nodiscard]] std::size_t fftSize() const noexcept { return _fft.size(); }
+    [[nodiscard]] std::size_t segmentLength() const noexcept { return _fft.size() - (_nTaps - 1UZ); }
+    [[nodiscard]] std::size_t bufferBytes() const noexcept { return 4UZ * _fft.size() * sizeof(float); }
+
+    // Filters the signal tail ++ input, where tail holds the taps-1 samples preceding input, and writes the outputs for
+    // input[first], input[first + decim], ... to out. Returns the number of outputs written.
+    std::size_t process(std::span<const T> tail, std::span<const T> input, std::size_t first, std::size_t decim, std::span<T> out) noexcept {
+        const std::size_t segment = segmentLength();
+        std::size_t       m       = 0UZ;
+        std::size_t       k       = first; // next retained output, as input index
+        for (std::size_t start = 0UZ; start < input.size() && k < input.size() && m < out.size();) {
+            const std::size_t countA = std::min(segment, input.size() - start);
+            if constexpr (std::floating_point<T>) {
+                const std::size_t startB = start + countA;
+                const std::size_t countB = std::min(segment, input.size() - startB);
+                load(tail, input, start, countA, _re.data(), nullptr);
+                load(tail, input, startB, countB, _im.data(), nullptr);
+                transform();
+                emit(start, countA, _re.data(), nullptr, k, m, decim, out);
+                emit(startB, countB, _im.data(), nullptr, k, m, decim, out);
+                start = startB + countB;
+            } else {
+                load(tail, input, start, countA, _re.data(), _im.data());
+                transform();
+                emit(start, countA, _re.data(), _im.data(), k, m, decim, out);
+                start += countA;
+            }
+        }
+        return m;
+    }
+
+private:
+    std::size_t            _nTaps{1UZ};
+    dsp_kernels::Radix2Fft _fft{64UZ};
+    std::vector<float>     _hRe;
+    std::vector<float>     _hIm;
+    std::vector<float>     _re;
+    std::vector<float>     _im;
+
+    // block[i] = signal[start + i] for the history + count samples ending at input[start + count - 1], zero padded
+    void load(std::span<const T> tail, std::span<const T> input, std::size_t start, std::size_t count, float* re, float* im) const noexcept {
+        const std::size_t history = _nTaps - 1UZ;
+        const std::size_t used    = history + count;
+        for (std::size_t i = 0UZ; i < used; ++i) {
+            const std::size_t s      = start + i; // index into tail ++ input
+            const T&          sample = s < history ? tail[s] : input[s - history];
+            if constexpr (std::floating_point<T>) {
+                re[i] = static_cast<float>(sample);
+            } else {
+                re[i] = sample.real();
+                im[i] = sample.imag();
+            }
+        }
+        std::fill(re + used, re + _fft.size(), 0.F);
+        if (im != nullptr) {
+            std::fill(im + used, im + _fft.size(), 0.F);
+        }
+    }
+
+    void transform() noexcept {
+        _fft.forward(_re.data(), _im.data());
+        dsp_kernels::multiplySpectra(_re.data(), _im.data(), _hRe.data(), _hIm.data(), _fft.size());
+        _fft.inverse(_re.data(), _im.data());
+    }
+
+    // block output history + i belongs to input index start + i
+    void emit(std::size_t start, std::size_t count, const float* re, const float* im, std::size_t& k, std::size_t& m, std::size_t decim, std::span<T> out) const noexcept {
+        const std::size_t history = _nTaps - 1UZ;
+        for (; k < start + count && m < out.size(); k += decim) {
+            const std::size_t i = history + (k - start);
+            if constexpr (std::floating_point<T>) {
+                out[m++] = static_cast<T>(re[i]);
+            } else {
+                out[m++] = T{re[i], im[i]};
+            }
+        }
+    }
+};
+
+} // namespace gr::incubator::filter::detail
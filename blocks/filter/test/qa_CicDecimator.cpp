@@ -0,0 +1,186 @@
+#include <boost/ut.hpp>
+#include <gnuradio-4.0/filter/CicDecimator.hpp>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace {
+
+// CIC as N cascaded moving sums of decim * differential_delay samples in double precision, followed by the block's
+// compensation taps
+std::vector<float> referenceOutput(const gr::incubator::filter::CicDecimator<int16_t>& decimator, const std::vector<int16_t>& input) {
+    const std::size_t   length = static_cast<std::size_t>(decimator.decim) * static_cast<std::size_t>(decimator.differential_delay);
+    std::vector<double> summed(input.begin(), input.end());
+    for (std::size_t stage = 0UZ; stage < static_cast<std::size_t>(decimator.order); ++stage) {
+        std::vector<double> next(summed.size());
+        double              acc = 0.0;
+        for (std::size_t i = 0UZ; i < summed.size(); ++i) {
+            acc += summed[i] - (i >= length ? summed[i - length] : 0.0);
+            next[i] = acc;
+        }
+        summed = std::move(next);
+    }
+
+    const double        scale = std::pow(static_cast<double>(length), -static_cast<double>(decimator.order));
+    std::vector<double> cic;
+    for (std::size_t i = 0UZ; i < summed.size(); i += static_cast<std::size_t>(decimator.decim)) {
+        cic.push_back(summed[i] * scale);
+    }
+    std::vector<float> expected;
+    for (std::size_t i = 0UZ; i < cic.size(); i += static_cast<std::size_t>(decimator.compensation_decim)) {
+        double acc = 0.0;
+        for (std::size_t k = 0UZ; k < decimator._taps.size() && k <= i; ++k) {
+            acc += cic[i - k] * static_cast<double>(decimator._taps[k]);
+        }
+        expected.push_back(static_cast<float>(acc));
+    }
+    return expected;
+}
+
+float toneGainDb(gr::incubator::filter::CicDecimator<int16_t> decimator, double frequency) {
+    constexpr double     amplitude = 30000.0;
+    std::vector<int16_t> input(400000UZ);
+    for (std::size_t n = 0UZ; n < input.size(); ++n) {
+        input[n] = static_cast<int16_t>(std::lround(amplitude * std::cos(2.0 * std::numbers::pi * frequency * static_cast<double>(n) / static_cast<double>(decimator.sample_rate))));
+    }
+    std::vector<float> output(decimator.requiredOutputCount(input.size()));
+    expect(decimator.processBulk(input, output) == gr::work::Status::OK);
+    float peak = 0.F;
+    for (const float sample : std::span(output).subspan(output.size() / 2UZ)) { // after the filters settled
+        peak = std::max(peak, std::abs(sample));
+    }
+    return 20.F * std::log10(peak / static_cast<float>(amplitude));
+}
+
+} // namespace
+
+const boost::ut::suite<"CicDecimator"> cicDecimatorTests = [] {
+    "matches moving-sum cascade and compensation FIR across chunk boundaries"_test = [] {
+        gr::incubator::filter::CicDecimator<int16_t> decimator;
+        decimator.decim              = 7U;
+        decimator.order              = 3U;
+        decimator.differential_delay = 2U;
+        decimator.compensation_decim = 3U;
+        decimator.f_low              = 9000.F;
+        decimator.transition_width   = 5000.F;
+        decimator.start();
+        expect(eq(decimator.input_chunk_size, 21UZ));
+
+        std::vector<int16_t> input(60000UZ);
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n] = static_cast<int16_t>(static_cast<int32_t>((n * 7919UZ + n * n * 31UZ) % 65536UZ) - 32768); // full-scale pseudo noise
+        }
+        const auto expected = referenceOutput(decimator, input);
+
+        std::vector<float> output;
+        std::size_t        offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 7UZ + 3UZ) % 1013UZ) {
+            const auto         span = std::span<const int16_t>(input).subspan(offset, std::min(chunk, input.size() - offset));
+            std::vector<float> chunkOut(decimator.requiredOutputCount(span.size()));
+            expect(decimator.processBulk(span, chunkOut) == gr::work::Status::OK);
+            output.insert(output.end(), chunkOut.begin(), chunkOut.end());
+            offset += span.size();
+        }
+
+        expect(eq(output.size(), expected.size()));
+        for (std::size_t i = 0UZ; i < std::min(output.size(), expected.size()); ++i) {
+            expect(std::abs(output[i] - expected[i]) < 1e-3F * (1.F + std::abs(expected[i]))) << "output" << i;
+        }
+    };
+
+    "compensation flattens the CIC droop in the pass band"_test = [] {
+        gr::incubator::filter::CicDecimator<int16_t> decimator;
+        decimator.decim            = 100U;
+        decimator.order            = 4U;
+        decimator.sample_rate      = 1000000.F;
+        decimator.f_low            = 2000.F;
+        decimator.transition_width = 1000.F;
+        decimator.start();
+
+        expect(lt(gr::incubator::filter::detail::cicMagnitude(1200.0 / 1e6, 4UZ, 100UZ, 1UZ), 0.92)) << "bare CIC droops by more than 0.7 dB";
+        for (const double frequency : {0.0, 300.0, 800.0, 1200.0}) {
+            expect(approx(toneGainDb(decimator, frequency), 0.F, 0.05F)) << "at" << frequency << "Hz";
+        }
+        expect(lt(toneGainDb(decimator, 3500.0), -50.F)) << "stop band of the compensation FIR";
+    };
+
+    "invalid configurations are rejected"_test = [] {
+        gr::incubator::filter::CicDecimator<int16_t> decimator;
+        decimator.sample_rate = 100000000.F;
+        decimator.decim       = 10000U;
+        decimator.order       = 4U;
+        expect(throws<std::invalid_argument>([&] { decimator.start(); })) << "16 + 4 * log2(10000) bits exceed 64";
+
+        decimator.order = 3U;
+        expect(nothrow([&] { decimator.start(); }));
+
+        decimator.order = 0U;
+        expect(throws<std::invalid_argument>([&] { decimator.settingsChanged({}, gr::property_map{{"order", gr::pmt::Value(0U)}}); }));
+
+        decimator.order            = 3U;
+        decimator.num_taps         = 31U; // no tap estimate, but the compensation steps still divide by the width
+        decimator.transition_width = 0.F;
+        expect(throws<std::invalid_argument>([&] { decimator.settingsChanged({}, gr::property_map{{"transition_width", gr::pmt::Value(0.F)}}); }));
+        expect(throws<std::invalid_argument>([&] { decimator.start(); }));
+    };
+
+    "complex int16 stream decimates real and imaginary parts independently"_test = [] {
+        const auto configure = [](auto& decimator) {
+            decimator.decim              = 5U;
+            decimator.order              = 4U;
+            decimator.differential_delay = 1U;
+            decimator.compensation_decim = 2U;
+            decimator.f_low              = 20000.F;
+            decimator.transition_width   = 10000.F;
+            decimator.start();
+        };
+        gr::incubator::filter::CicDecimator<std::complex<int16_t>> complexDecimator;
+        gr::incubator::filter::CicDecimator<int16_t>               realDecimator;
+        gr::incubator::filter::CicDecimator<int16_t>               imagDecimator;
+        configure(complexDecimator);
+        configure(realDecimator);
+        configure(imagDecimator);
+
+        std::vector<std::complex<int16_t>> input(20000UZ);
+        std::vector<int16_t>               realPart(input.size());
+        std::vector<int16_t>               imagPart(input.size());
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            realPart[n] = static_cast<int16_t>(static_cast<int32_t>((n * 7919UZ + n * n * 31UZ) % 65536UZ) - 32768);
+            imagPart[n] = static_cast<int16_t>(static_cast<int32_t>((n * 104729UZ + n * n * 17UZ) % 65536UZ) - 32768);
+            input[n]    = {realPart[n], imagPart[n]};
+        }
+
+        std::vector<std::complex<float>> output;
+        std::vector<float>               expectedReal;
+        std::vector<float>               expectedImag;
+        std::size_t                      offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 5UZ + 3UZ) % 997UZ) {
+            const std::size_t                n = std::min(chunk, input.size() - offset);
+            std::vector<std::complex<float>> chunkOut(complexDecimator.requiredOutputCount(n));
+            std::vector<float>               realOut(realDecimator.requiredOutputCount(n));
+            std::vector<float>               imagOut(imagDecimator.requiredOutputCount(n));
+            expect(complexDecimator.processBulk(std::span<const std::complex<int16_t>>(input).subspan(offset, n), chunkOut) == gr::work::Status::OK);
+            expect(realDecimator.processBulk(std::span<const int16_t>(realPart).subspan(offset, n), realOut) == gr::work::Status::OK);
+            expect(imagDecimator.processBulk(std::span<const int16_t>(imagPart).subspan(offset, n), imagOut) == gr::work::Status::OK);
+            output.insert(output.end(), chunkOut.begin(), chunkOut.end());
+            expectedReal.insert(expectedReal.end(), realOut.begin(), realOut.end());
+            expectedImag.insert(expectedImag.end(), imagOut.begin(), imagOut.end());
+            offset += n;
+        }
+
+        expect(eq(output.size(), expectedReal.size())) << fatal;
+        for (std::size_t i = 0UZ; i < output.size(); ++i) {
+            expect(std::abs(output[i].real() - expectedReal[i]) < 1e-3F * (1.F + std::abs(expectedReal[i]))) << "real" << i;
+            expect(std::abs(output[i].imag() - expectedImag[i]) < 1e-3F * (1.F + std::abs(expectedImag[i]))) << "imag" << i;
+        }
+    };
+};
+
+int main() {}
@@ -1,14 +1,128 @@
 #include <boost/ut.hpp>
 #include <gnuradio-4.0/filter/FirDecimator.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <limits>
 #include <numbers>
 #include <numeric>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
 using namespace boost::ut;
 
+// what the next work() call does once a background redesign has finished
+template<typename T>
+void applyRedesign(gr::incubator::filter::FirDecimator<T>& decimator) {
+    decimator._redesign.wait();
+    std::vector<T> noOutput;
+    expect(decimator.processBulk(std::span<const T>(), std::span<T>(noOutput)) == gr::work::Status::OK);
+    expect(!decimator._redesign.pending());
+}
+
+// Retunes a running decimator and checks that every output, before and after the swap, equals the full-stream
+// convolution with the taps active in its chunk, i.e. that the new taps only ever see actual input as history.
+template<typename T>
+void expectRetuneKeepsHistory(float fLow, float transitionWidth, uint32_t fftTapThreshold) {
+    gr::incubator::filter::FirDecimator<T> decimator;
+    decimator.decim             = 3U;
+    decimator.sample_rate       = 1000000.F;
+    decimator.f_low             = 100000.F;
+    decimator.transition_width  = 40000.F;
+    decimator.fft_tap_threshold = fftTapThreshold;
+    decimator.start();
+
+    std::vector<T> input(4000UZ);
+    for (std::size_t n = 0UZ; n < input.size(); ++n) {
+        if constexpr (std::floating_point<T>) {
+            input[n] = std::cos(0.001F * static_cast<float>(n * n));
+        } else {
+            input[n] = {std::cos(0.001F * static_cast<float>(n * n)), static_cast<float>(n % 17UZ) - 8.F};
+        }
+    }
+    const std::size_t split = 1001UZ; // leaves the decimation phase at 2
+
+    const auto     firstChunk = std::span<const T>(input).first(split);
+    std::vector<T> firstOut(decimator.requiredOutputCount(firstChunk.size()));
+    expect(decimator.processBulk(firstChunk, firstOut) == gr::work::Status::OK);
+
+    const auto oldTaps = decimator._taps;
+    decimator.f_low            = fLow;
+    decimator.transition_width = transitionWidth;
+    decimator.settingsChanged({}, gr::property_map{{"f_low", gr::pmt::Value(fLow)}, {"transition_width", gr::pmt::Value(transitionWidth)}});
+    expect(decimator._taps == oldTaps) << "the design runs in the background";
+    applyRedesign(decimator);
+    expect(eq(decimator._decimPhase, 2U));
+
+    std::size_t chunksWithNewTaps = 0UZ;
+    for (std::size_t offset = split; offset < input.size();) {
+        const auto     chunk = std::span<const T>(input).subspan(offset, std::min(250UZ, input.size() - offset));
+        std::vector<T> out(decimator.requiredOutputCount(chunk.size()));
+        expect(decimator.processBulk(chunk, out) == gr::work::Status::OK);
+
+        const auto& used = decimator._taps; // swaps happen only at the start of a chunk
+        chunksWithNewTaps += used != oldTaps ? 1UZ : 0UZ;
+        const std::size_t first = (3UZ - offset % 3UZ) % 3UZ;
+        for (std::size_t m = 0UZ; m < out.size(); ++m) {
+            const std::size_t k = offset + first + 3UZ * m; // stream index of the m-th output
+            T                 expected{};
+            for (std::size_t j = 0UZ; j < used.size() && j <= k; ++j) {
+                expected += input[k - j] * used[j];
+            }
+            expect(std::abs(out[m] - expected) < 1e-4F * (1.F + std::abs(expected))) << "stream index" << k;
+        }
+        offset += chunk.size();
+    }
+    expect(gt(chunksWithNewTaps, 0UZ)) << "the new taps took over";
+    expect(!decimator._staged.has_value());
+}
+
+template<typename T>
+void expectOverlapSaveMatchesDirect() {
+    constexpr std::size_t decim = 3UZ;
+    std::vector<float>    taps(801UZ);
+    for (std::size_t i = 0UZ; i < taps.size(); ++i) {
+        taps[i] = std::sin(0.11F * static_cast<float>(i)) / static_cast<float>(i + 1UZ);
+    }
+    std::vector<T> input(5000UZ);
+    for (std::size_t n = 0UZ; n < input.size(); ++n) {
+        if constexpr (std::floating_point<T>) {
+            input[n] = std::cos(0.001F * static_cast<float>(n * n));
+        } else {
+            input[n] = {std::cos(0.001F * static_cast<float>(n * n)), static_cast<float>(n % 17UZ) - 8.F};
+        }
+    }
+
+    gr::incubator::filter::FirDecimator<T> direct;
+    direct.decim             = static_cast<uint32_t>(decim);
+    direct.taps              = gr::Tensor<float>(gr::data_from, taps);
+    direct.fft_tap_threshold = 0U;
+    direct.start();
+    gr::incubator::filter::FirDecimator<T> fft;
+    fft.decim = static_cast<uint32_t>(decim);
+    fft.taps  = gr::Tensor<float>(gr::data_from, taps);
+    fft.start(); // 801 taps / 3 exceeds the default threshold
+    expect(!direct._useFft);
+    expect(fft._useFft);
+
+    std::size_t offset = 0UZ;
+    for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 7UZ + 5UZ) % 1901UZ) { // spans shorter and longer than the taps
+        const auto     span = std::span<const T>(input).subspan(offset, std::min(chunk, input.size() - offset));
+        std::vector<T> directOut(direct.requiredOutputCount(span.size()));
+        std::vector<T> fftOut(fft.requiredOutputCount(span.size()));
+        expect(direct.processBulk(span, directOut) == gr::work::Status::OK);
+        expect(fft.processBulk(span, fftOut) == gr::work::Status::OK);
+        expect(eq(fftOut.size(), directOut.size()));
+        for (std::size_t i = 0UZ; i < std::min(fftOut.size(), directOut.size()); ++i) {
+            expect(std::abs(fftOut[i] - directOut[i]) < 1e-4F * (1.F + std::abs(directOut[i]))) << "offset" << offset << "output" << i;
+        }
+        offset += span.size();
+    }
+}
+
 const boost::ut::suite<"FirDecimator"> firDecimatorTests = [] {
     "custom taps decimate complex stream"_test = [] {
         gr::incubator::filter::FirDecimator<std::complex<float>> decimator;
@@ -25,6 +139,68 @@ const boost::ut::suite<"FirDecimator"> firDecimatorTests = [] {
         expect(approx(output[2].real(), 5.F, 1e-6F));
     };
 
+    "int16 stream matches the float path across chunk boundaries"_test = [] {
+        gr::incubator::filter::FirDecimator<std::complex<std::int16_t>, float> fixedPoint;
+        gr::incubator::filter::FirDecimator<std::complex<float>>               reference;
+        const auto configure = [](auto& decimator) {
+            decimator.decim            = 5U;
+            decimator.sample_rate      = 1000000.F;
+            decimator.f_low            = 80000.F;
+            decimator.transition_width = 30000.F;
+            decimator.start();
+        };
+        configure(fixedPoint);
+        configure(reference);
+        expect(fixedPoint._taps == reference._taps);
+        expect(gr::incubator::dsp_kernels::int16AccumulationBound(fixedPoint._reversedTapsInt16) <= std::numeric_limits<std::int32_t>::max());
+
+        std::vector<std::complex<std::int16_t>> input(20000UZ);
+        std::vector<std::complex<float>>        scaled(input.size());
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n]  = {static_cast<std::int16_t>(std::lround(30000.0 * std::cos(0.0013 * static_cast<double>(n * n % 10007UZ)))), static_cast<std::int16_t>(static_cast<int>(n * 7919UZ % 60001UZ) - 30000)};
+            scaled[n] = {static_cast<float>(input[n].real()) / 32768.F, static_cast<float>(input[n].imag()) / 32768.F};
+        }
+        std::vector<std::complex<float>> expected(reference.requiredOutputCount(scaled.size()));
+        expect(reference.processBulk(scaled, expected) == gr::work::Status::OK);
+
+        std::vector<std::complex<float>> output;
+        std::size_t                      offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 7UZ + 3UZ) % 389UZ) {
+            const auto                       span = std::span<const std::complex<std::int16_t>>(input).subspan(offset, std::min(chunk, input.size() - offset));
+            std::vector<std::complex<float>> chunkOut(fixedPoint.requiredOutputCount(span.size()));
+            expect(fixedPoint.processBulk(span, chunkOut) == gr::work::Status::OK);
+            output.insert(output.end(), chunkOut.begin(), chunkOut.end());
+            offset += span.size();
+        }
+
+        expect(eq(output.size(), expected.size()));
+        for (std::size_t i = 0UZ; i < std::min(output.size(), expected.size()); ++i) {
+            expect(std::abs(output[i] - expected[i]) < 1e-3F) << "output" << i; // tap quantisation error
+        }
+    };
+
+    "int16 output is rounded and saturated"_test = [] {
+        gr::incubator::filter::FirDecimator<std::int16_t> average;
+        average.decim = 1U;
+        average.taps  = gr::Tensor<float>{0.5F, 0.5F};
+        average.start();
+
+        const std::vector<std::int16_t> input{3, 4, -3, -4, 100};
+        std::vector<std::int16_t>       output(input.size());
+        expect(average.processBulk(input, output) == gr::work::Status::OK);
+        expect(output == std::vector<std::int16_t>{2, 4, 1, -3, 48});
+
+        gr::incubator::filter::FirDecimator<std::int16_t> gain;
+        gain.decim = 1U;
+        gain.taps  = gr::Tensor<float>{1.5F};
+        gain.start();
+
+        const std::vector<std::int16_t> loud{30000, -30000, 1000};
+        std::vector<std::int16_t>       clipped(loud.size());
+        expect(gain.processBulk(loud, clipped) == gr::work::Status::OK);
+        expect(clipped == std::vector<std::int16_t>{32767, -32768, 1500});
+    };
+
     "designed lowpass creates taps"_test = [] {
         gr::incubator::filter::FirDecimator<std::complex<float>> decimator;
         decimator.decim            = 5U;
@@ -146,6 +322,42 @@ const boost::ut::suite<"FirDecimator"> firDecimatorTests = [] {
         expect(neq(decimator._taps.size(), originalTapCount));
     };
 
+    "designed taps are shared through the tap cache"_test = [] {
+        auto& cache = gr::incubator::dsp_kernels::TapCache<float>::instance();
+        cache.clear();
+
+        gr::incubator::filter::FirDecimator<std::complex<float>> first;
+        first.decim            = 4U;
+        first.sample_rate      = 1000000.F;
+        first.f_low            = 90000.F;
+        first.transition_width = 30000.F;
+        first.start();
+        expect(eq(cache.size(), 1UZ));
+        expect(first._taps == gr::incubator::filter::detail::designFirTaps<float>(first.designSpec()));
+
+        gr::incubator::filter::FirDecimator<float> second; // same design for a real stream
+        second.decim            = 4U;
+        second.sample_rate      = 1000000.F;
+        second.f_low            = 90000.F;
+        second.transition_width = 30000.F;
+        second.start();
+        expect(eq(cache.size(), 1UZ));
+        expect(second._taps == first._taps);
+
+        const auto original = first._taps;
+        first.f_low         = 60000.F;
+        first.settingsChanged({}, gr::property_map{{"f_low", gr::pmt::Value(60000.F)}});
+        applyRedesign(first);
+        expect(eq(cache.size(), 2UZ));
+        expect(first._taps != original);
+
+        first.f_low = 90000.F;
+        first.settingsChanged({}, gr::property_map{{"f_low", gr::pmt::Value(90000.F)}});
+        applyRedesign(first);
+        expect(eq(cache.size(), 2UZ)) << "retune back hits the cache";
+        expect(first._taps == original);
+    };
+
     "custom taps filter only retained decimated samples"_test = [] {
         gr::incubator::filter::FirDecimator<float> decimator;
         decimator.decim = 2U;
@@ -177,6 +389,86 @@ const boost::ut::suite<"FirDecimator"> firDecimatorTests = [] {
         expect(approx(secondOut[0], 4.F, 1e-6F));
     };
 
+    "required output count follows the decimation phase"_test = [] {
+        gr::incubator::filter::FirDecimator<float> decimator;
+        decimator.decim = 4U;
+        decimator.taps  = gr::Tensor<float>{1.F};
+        decimator.start();
+        expect(eq(decimator.requiredOutputCount(1UZ), 1UZ));
+
+        std::vector<float> output(1UZ);
+        expect(decimator.processBulk(std::vector<float>{1.F}, output) == gr::work::Status::OK);
+        expect(eq(decimator.requiredOutputCount(3UZ), 0UZ)) << "next output is the fourth sample";
+        expect(eq(decimator.requiredOutputCount(4UZ), 1UZ));
+        expect(eq(decimator.requiredOutputCount(8UZ), 2UZ));
+    };
+
+    "long filter matches direct convolution across arbitrary chunk boundaries"_test = [] {
+        constexpr std::size_t decim = 7UZ;
+        std::vector<float>    taps(129UZ);
+        for (std::size_t i = 0UZ; i < taps.size(); ++i) {
+            taps[i] = std::sin(0.37F * static_cast<float>(i)) / static_cast<float>(i + 1UZ);
+        }
+        std::vector<std::complex<float>> input(1000UZ);
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n] = {std::cos(0.01F * static_cast<float>(n * n)), static_cast<float>(n % 13UZ) - 6.F};
+        }
+
+        std::vector<std::complex<float>> expected;
+        for (std::size_t n = 0UZ; n < input.size(); n += decim) {
+            std::complex<float> acc{};
+            for (std::size_t i = 0UZ; i < taps.size() && i <= n; ++i) {
+                acc += input[n - i] * taps[i];
+            }
+            expected.push_back(acc);
+        }
+
+        gr::incubator::filter::FirDecimator<std::complex<float>> decimator;
+        decimator.decim = static_cast<uint32_t>(decim);
+        decimator.taps  = gr::Tensor<float>(gr::data_from, taps);
+        decimator.start();
+
+        std::vector<std::complex<float>> output;
+        std::size_t                      offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 5UZ + 3UZ) % 211UZ) { // spans shorter and longer than the taps
+            const auto                       span = std::span<const std::complex<float>>(input).subspan(offset, std::min(chunk, input.size() - offset));
+            std::vector<std::complex<float>> chunkOut(decimator.requiredOutputCount(span.size()));
+            expect(decimator.processBulk(span, chunkOut) == gr::work::Status::OK);
+            output.insert(output.end(), chunkOut.begin(), chunkOut.end());
+            offset += span.size();
+        }
+
+        expect(eq(output.size(), expected.size()));
+        for (std::size_t i = 0UZ; i < std::min(output.size(), expected.size()); ++i) {
+            expect(approx(output[i].real(), expected[i].real(), 1e-4F) && approx(output[i].imag(), expected[i].imag(), 1e-4F)) << "output" << i;
+        }
+    };
+
+    "overlap-save mode matches direct form across chunk boundaries"_test = [] {
+        expectOverlapSaveMatchesDirect<float>();
+        expectOverlapSaveMatchesDirect<std::complex<float>>();
+    };
+
+    "retune swaps taps at a chunk boundary and keeps the history"_test = [] {
+        expectRetuneKeepsHistory<float>(60000.F, 40000.F, 0U);                // same length
+        expectRetuneKeepsHistory<std::complex<float>>(60000.F, 80000.F, 0U);  // shorter
+        expectRetuneKeepsHistory<std::complex<float>>(140000.F, 20000.F, 0U); // longer
+        expectRetuneKeepsHistory<float>(60000.F, 20000.F, 16U);               // overlap-save
+        expectRetuneKeepsHistory<std::complex<float>>(60000.F, 40000.F, 16U);
+    };
+
+    "failed background design keeps the current taps"_test = [] {
+        gr::incubator::filter::FirDecimator<float> decimator;
+        decimator.decim = 2U;
+        decimator.start();
+        const auto taps = decimator._taps;
+
+        decimator.f_low = 0.F; // no pass band to normalise the gain at
+        decimator.settingsChanged({}, gr::property_map{{"f_low", gr::pmt::Value(0.F)}});
+        applyRedesign(decimator);
+        expect(decimator._taps == taps);
+    };
+
     "runtime tap update clears filter history"_test = [] {
         gr::incubator::filter::FirDecimator<float> decimator;
         decimator.decim = 1U;
@@ -0,0 +1,131 @@
+#include <boost/ut.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/FixedPoint.hpp>
+#include <gnuradio-4.0/filter/detail/FirKernels.hpp>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace boost::ut;
+using namespace gr::incubator::dsp_kernels;
+
+namespace {
+
+// deterministic, non-trivial values in [-0.5, 0.5)
+float sampleValue(std::size_t n, std::size_t seed) { return static_cast<float>((n * 7919UZ + seed * 104729UZ) % 1000UZ) * 1e-3F - 0.5F; }
+
+} // namespace
+
+const boost::ut::suite<"FirKernels"> firKernelsTests = [] {
+    "every supported SIMD level matches the scalar kernel"_test = [] {
+        const DotKernels scalar = kernelsFor(SimdLevel::Scalar);
+        for (const SimdLevel level : {SimdLevel::Neon, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (!isSupported(level)) {
+                continue;
+            }
+            const DotKernels kernels = kernelsFor(level);
+            for (std::size_t n = 0UZ; n <= 100UZ; ++n) {
+                // offset by one element so that unaligned sample loads are covered as well
+                std::vector<float>               real(n + 1UZ);
+                std::vector<std::complex<float>> complex(n + 1UZ);
+                AlignedVector<float>             taps(n);
+                for (std::size_t j = 0UZ; j < n; ++j) {
+                    real[j + 1UZ]    = sampleValue(j, 1UZ);
+                    complex[j + 1UZ] = {sampleValue(j, 2UZ), sampleValue(j, 3UZ)};
+                    taps[j]          = sampleValue(j, 4UZ);
+                }
+                const float tolerance = 1e-5F * static_cast<float>(n + 1UZ);
+
+                const float realExpected = scalar.real(real.data() + 1, taps.data(), n);
+                expect(approx(kernels.real(real.data() + 1, taps.data(), n), realExpected, tolerance)) << toString(level) << "real n =" << n;
+
+                const std::complex<float> complexExpected = scalar.complex(complex.data() + 1, taps.data(), n);
+                const std::complex<float> complexActual   = kernels.complex(complex.data() + 1, taps.data(), n);
+                expect(approx(complexActual.real(), complexExpected.real(), tolerance)) << toString(level) << "complex n =" << n;
+                expect(approx(complexActual.imag(), complexExpected.imag(), tolerance)) << toString(level) << "complex n =" << n;
+            }
+        }
+    };
+
+    "int16 kernels are exact on every supported SIMD level"_test = [] {
+        const DotKernels scalar = kernelsFor(SimdLevel::Scalar);
+        for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::Neon, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (!isSupported(level)) {
+                continue;
+            }
+            const DotKernels kernels = kernelsFor(level);
+            for (std::size_t n = 0UZ; n <= 100UZ; ++n) {
+                std::vector<std::int16_t>               real(n + 1UZ);
+                std::vector<std::complex<std::int16_t>> complex(n + 1UZ);
+                std::vector<float>                      designed(n);
+                std::int64_t                            realExpected = 0;
+                for (std::size_t j = 0UZ; j < n; ++j) {
+                    real[j + 1UZ]    = static_cast<std::int16_t>(sampleValue(j, 1UZ) * 65535.F);
+                    complex[j + 1UZ] = {static_cast<std::int16_t>(sampleValue(j, 2UZ) * 65535.F), j % 3UZ == 0UZ ? std::numeric_limits<std::int16_t>::min() : std::int16_t{32767}};
+                    designed[j]      = sampleValue(j, 4UZ);
+                }
+                AlignedVector<std::int16_t> taps(n);
+                quantiseInt16(std::span<const float>(designed), int16TapShift(std::span<const float>(designed)), std::span<std::int16_t>(taps));
+                expect(int16AccumulationBound(taps) <= std::numeric_limits<std::int32_t>::max());
+                for (std::size_t j = 0UZ; j < n; ++j) {
+                    realExpected += static_cast<std::int64_t>(real[j + 1UZ]) * taps[j];
+                }
+
+                expect(eq(static_cast<std::int64_t>(kernels.realInt16(real.data() + 1, taps.data(), n)), realExpected)) << toString(level) << "real n =" << n;
+                const std::complex<std::int32_t> complexExpected = scalar.complexInt16(complex.data() + 1, taps.data(), n);
+                const std::complex<std::int32_t> complexActual   = kernels.complexInt16(complex.data() + 1, taps.data(), n);
+                expect(complexActual == complexExpected) << toString(level) << "complex n =" << n;
+            }
+        }
+    };
+
+    "int16 tap quantisation uses the full accumulator range"_test = [] {
+        const std::vector<float>  taps{0.125F, -0.125F, 0.125F, 0.125F, 0.125F, 0.125F, -0.125F, 0.125F};
+        const int                 shift = int16TapShift(std::span<const float>(taps));
+        std::vector<std::int16_t> quantised(taps.size());
+        quantiseInt16(std::span<const float>(taps), shift, std::span<std::int16_t>(quantised));
+        expect(int16AccumulationBound(quantised) <= std::numeric_limits<std::int32_t>::max());
+        quantiseInt16(std::span<const float>(taps), shift + 1, std::span<std::int16_t>(quantised));
+        expect(int16AccumulationBound(quantised) > std::numeric_limits<std::int32_t>::max()) << "one more bit would overflow";
+
+        expect(eq(fromFixedPoint<std::int16_t>(std::int32_t{5} << 3, 3), std::int16_t{5}));
+        expect(eq(fromFixedPoint<std::int16_t>(-(std::int32_t{5} << 3) - 4, 3), std::int16_t{-5})) << "rounds half up";
+        expect(eq(fromFixedPoint<std::int16_t>(std::int32_t{1} << 30, 10), std::int16_t{32767})) << "saturates";
+        expect(eq(fromFixedPoint<std::int16_t>(-(std::int32_t{1} << 30), 10), std::int16_t{-32768}));
+        expect(approx(fromFixedPoint<float>(std::int32_t{16384} << 4, 4), 0.5F, 1e-7F)) << "int16 full scale maps to 1.0";
+    };
+
+    "decimating FIR equals direct convolution"_test = [] {
+        const std::vector<float> taps{0.5F, -0.25F, 0.125F, 1.F, 0.75F};
+        AlignedVector<float>     reversed(taps.rbegin(), taps.rend());
+        std::vector<float>       x(64UZ);
+        for (std::size_t n = 0UZ; n < x.size(); ++n) {
+            x[n] = sampleValue(n, 5UZ);
+        }
+
+        constexpr std::size_t decim = 3UZ;
+        const std::size_t     first = taps.size() - 1UZ;
+        std::vector<float>    out(x.size());
+        const std::size_t     count = gr::incubator::filter::detail::firDecimate<float, float>(x, reversed, first, decim, out);
+        expect(eq(count, (x.size() - first + decim - 1UZ) / decim));
+        for (std::size_t m = 0UZ; m < count; ++m) {
+            const std::size_t k        = first + m * decim;
+            float             expected = 0.F;
+            for (std::size_t j = 0UZ; j < taps.size(); ++j) {
+                expected += taps[j] * x[k - j];
+            }
+            expect(approx(out[m], expected, 1e-5F)) << "output" << m;
+        }
+    };
+
+    "activeKernels respects detected level"_test = [] {
+        const SimdLevel level = detectSimdLevel();
+        expect(isSupported(level));
+        expect(activeKernels().real == kernelsFor(level).real);
+    };
+};
+
+int main() {}
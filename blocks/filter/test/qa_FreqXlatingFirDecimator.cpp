@@ -0,0 +1,100 @@
+#include <boost/ut.hpp>
+#include <gnuradio-4.0/filter/FirDecimator.hpp>
+#include <gnuradio-4.0/filter/FreqXlatingFirDecimator.hpp>
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace {
+
+void configure(auto& decimator) {
+    decimator.decim            = 5U;
+    decimator.sample_rate      = 1000000.F;
+    decimator.f_low            = 40000.F;
+    decimator.transition_width = 20000.F;
+}
+
+} // namespace
+
+const boost::ut::suite<"FreqXlatingFirDecimator"> freqXlatingFirDecimatorTests = [] {
+    "matches mixer followed by FirDecimator across chunk boundaries"_test = [] {
+        constexpr double centre = -125000.0;
+
+        gr::incubator::filter::FreqXlatingFirDecimator<std::complex<float>> xlating;
+        configure(xlating);
+        xlating.center_frequency = static_cast<float>(centre);
+        xlating.start();
+
+        gr::incubator::filter::FirDecimator<std::complex<float>> reference;
+        configure(reference);
+        reference.start();
+        expect(xlating._taps == reference._taps) << "same prototype design";
+
+        std::vector<std::complex<float>> input(20000UZ);
+        std::vector<std::complex<float>> mixed(input.size());
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n] = {std::cos(0.002F * static_cast<float>(n * n % 7919UZ)), static_cast<float>(n % 13UZ) / 6.F - 1.F};
+            mixed[n] = input[n] * std::complex<float>(std::polar(1.0, -2.0 * std::numbers::pi * centre * static_cast<double>(n) / 1e6));
+        }
+        std::vector<std::complex<float>> expected(reference.requiredOutputCount(mixed.size()));
+        expect(reference.processBulk(mixed, expected) == gr::work::Status::OK);
+
+        std::vector<std::complex<float>> output;
+        std::size_t                      offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 7UZ + 3UZ) % 389UZ) {
+            const auto                       span = std::span<const std::complex<float>>(input).subspan(offset, std::min(chunk, input.size() - offset));
+            std::vector<std::complex<float>> chunkOut(xlating.requiredOutputCount(span.size()));
+            expect(xlating.processBulk(span, chunkOut) == gr::work::Status::OK);
+            output.insert(output.end(), chunkOut.begin(), chunkOut.end());
+            offset += span.size();
+        }
+
+        expect(eq(output.size(), expected.size()));
+        for (std::size_t i = 0UZ; i < std::min(output.size(), expected.size()); ++i) {
+            expect(std::abs(output[i] - expected[i]) < 1e-4F * (1.F + std::abs(expected[i]))) << "output" << i;
+        }
+    };
+
+    "real tone at the centre frequency becomes a constant phasor"_test = [] {
+        gr::incubator::filter::FreqXlatingFirDecimator<float> xlating;
+        configure(xlating);
+        xlating.center_frequency = 200000.F;
+        xlating.start();
+
+        std::vector<float> input(10000UZ);
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n] = std::cos(2.F * std::numbers::pi_v<float> * 0.2F * static_cast<float>(n) + 0.3F);
+        }
+        std::vector<std::complex<float>> output(xlating.requiredOutputCount(input.size()));
+        expect(xlating.processBulk(input, output) == gr::work::Status::OK);
+        for (const auto& sample : std::span(output).subspan(output.size() / 2UZ)) { // the image at -400 kHz is filtered out
+            expect(std::abs(sample - std::polar(0.5F, 0.3F)) < 2e-3F);
+        }
+    };
+
+    "retuning the centre frequency keeps prototype and history"_test = [] {
+        gr::incubator::filter::FreqXlatingFirDecimator<std::complex<float>> xlating;
+        configure(xlating);
+        xlating.center_frequency = 50000.F;
+        xlating.start();
+
+        std::vector<std::complex<float>> input(1000UZ, {1.F, -1.F});
+        std::vector<std::complex<float>> output(xlating.requiredOutputCount(input.size()));
+        expect(xlating.processBulk(input, output) == gr::work::Status::OK);
+        const auto taps = xlating._taps;
+        const auto tail = xlating._tail;
+
+        xlating.center_frequency = -50000.F;
+        xlating.settingsChanged({}, gr::property_map{{"center_frequency", gr::pmt::Value(-50000.F)}});
+        expect(xlating._taps == taps);
+        expect(xlating._tail == tail);
+        expect(approx(xlating._rotationStep.imag(), std::sin(2.0 * std::numbers::pi * 0.05 * 5.0), 1e-9));
+    };
+};
+
+int main() {}
@@ -0,0 +1,95 @@
+#include <boost/ut.hpp>
+#include <gnuradio-4.0/filter/FirDecimator.hpp>
+#include <gnuradio-4.0/filter/HalfbandDecimator.hpp>
+
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace boost::ut;
+
+const boost::ut::suite<"HalfbandDecimator"> halfbandDecimatorTests = [] {
+    "designed taps have halfband structure"_test = [] {
+        gr::incubator::filter::HalfbandDecimator<float> decimator;
+        decimator.num_taps = 20U;
+        decimator.start();
+
+        const auto& taps = decimator._taps;
+        expect(eq(taps.size(), 23UZ)) << "rounded up to 4K-1";
+        const std::size_t centre = taps.size() / 2UZ;
+        expect(approx(taps[centre], 0.5F, 0.02F));
+        for (std::size_t i = 0UZ; i < taps.size(); ++i) {
+            expect(eq(taps[i], taps[taps.size() - 1UZ - i])) << "symmetric at" << i;
+            if (i != centre && (centre - i) % 2UZ == 0UZ) {
+                expect(eq(taps[i], 0.F)) << "even offset" << i;
+            }
+        }
+        expect(approx(std::accumulate(taps.begin(), taps.end(), 0.F), 1.F, 1e-3F));
+        expect(eq(decimator.input_chunk_size, 2UZ));
+    };
+
+    "matches FirDecimator with the same taps across chunk boundaries"_test = [] {
+        gr::incubator::filter::HalfbandDecimator<std::complex<float>> halfband;
+        halfband.sample_rate      = 1000000.F;
+        halfband.transition_width = 40000.F;
+        halfband.start();
+        expect(gt(halfband._taps.size(), 40UZ));
+
+        gr::incubator::filter::FirDecimator<std::complex<float>> reference;
+        reference.decim             = 2U;
+        reference.taps              = gr::Tensor<float>(gr::data_from, halfband._taps);
+        reference.fft_tap_threshold = 0U;
+        reference.start();
+
+        std::vector<std::complex<float>> input(3000UZ);
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n] = {std::cos(0.013F * static_cast<float>(n * n % 977UZ)), static_cast<float>(n % 11UZ) - 5.F};
+        }
+
+        std::size_t offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 5UZ + 3UZ) % 131UZ) { // odd and even spans, shorter and longer than the taps
+            const auto                       span = std::span<const std::complex<float>>(input).subspan(offset, std::min(chunk, input.size() - offset));
+            std::vector<std::complex<float>> expected(reference.requiredOutputCount(span.size()));
+            std::vector<std::complex<float>> output(halfband.requiredOutputCount(span.size()));
+            expect(reference.processBulk(span, expected) == gr::work::Status::OK);
+            expect(halfband.processBulk(span, output) == gr::work::Status::OK);
+            expect(eq(output.size(), expected.size()));
+            for (std::size_t i = 0UZ; i < std::min(output.size(), expected.size()); ++i) {
+                expect(std::abs(output[i] - expected[i]) < 1e-4F) << "offset" << offset << "output" << i;
+            }
+            offset += span.size();
+        }
+    };
+
+    "runtime sample rate propagation keeps taps and history"_test = [] {
+        gr::incubator::filter::HalfbandDecimator<std::complex<float>> decimator;
+        decimator.sample_rate      = 2000000.F;
+        decimator.transition_width = 100000.F;
+        decimator.start();
+
+        std::vector<std::complex<float>> input(1001UZ);
+        for (std::size_t n = 0UZ; n < input.size(); ++n) {
+            input[n] = {std::sin(0.01F * static_cast<float>(n)), std::cos(0.02F * static_cast<float>(n))};
+        }
+        std::vector<std::complex<float>> output(decimator.requiredOutputCount(input.size()));
+        expect(decimator.processBulk(input, output) == gr::work::Status::OK);
+        const auto taps  = decimator._taps;
+        const auto tail  = decimator._tail;
+        const auto phase = decimator._decimPhase;
+
+        decimator.sample_rate = 1000000.F; // num_taps = 0: would halve the estimated length if redesigned
+        decimator.settingsChanged({}, gr::property_map{{"sample_rate", gr::pmt::Value(1000000.F)}});
+        expect(decimator._taps == taps);
+        expect(decimator._tail == tail);
+        expect(eq(decimator._decimPhase, phase));
+        expect(eq(decimator._designSampleRate, 2000000.F));
+
+        decimator.settingsChanged({}, gr::property_map{{"sample_rate", gr::pmt::Value(1000000.F)}, {"transition_width", gr::pmt::Value(100000.F)}});
+        expect(eq(decimator._designSampleRate, 1000000.F));
+        expect(lt(decimator._taps.size(), taps.size())) << "batched sample_rate is used for the estimate";
+    };
+};
+
+int main() {}
@@ -0,0 +1,130 @@
+#include <boost/ut.hpp>
+#include <gnuradio-4.0/filter/MultiStageDecimator.hpp>
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace {
+
+std::vector<std::complex<float>> tone(float frequency, float sampleRate, std::size_t n) {
+    std::vector<std::complex<float>> samples(n);
+    for (std::size_t i = 0UZ; i < n; ++i) {
+        const double phase = 2.0 * std::numbers::pi * static_cast<double>(frequency) * static_cast<double>(i) / static_cast<double>(sampleRate);
+        samples[i]         = {static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase))};
+    }
+    return samples;
+}
+
+void configure(gr::incubator::filter::MultiStageDecimator<std::complex<float>>& decimator, uint32_t maxStages) {
+    decimator.decim            = 40U;
+    decimator.sample_rate      = 2000000.F;
+    decimator.f_low            = 20000.F;
+    decimator.transition_width = 10000.F;
+    decimator.attenuation_db   = 60.F;
+    decimator.max_stages       = maxStages;
+    decimator.start();
+}
+
+} // namespace
+
+const boost::ut::suite<"MultiStageDecimator"> multiStageDecimatorTests = [] {
+    "large decimation is split into cheaper stages"_test = [] {
+        gr::incubator::filter::MultiStageDecimator<std::complex<float>> single;
+        configure(single, 1U);
+        gr::incubator::filter::MultiStageDecimator<std::complex<float>> cascade;
+        configure(cascade, 4U);
+
+        expect(eq(single._stages.size(), 1UZ));
+        expect(gt(cascade._stages.size(), 1UZ));
+        expect(lt(cascade._plan.macsPerOutput, 0.5 * single._plan.macsPerOutput));
+
+        std::size_t total = 1UZ;
+        for (const auto& stage : cascade._stages) {
+            total *= stage.decim;
+        }
+        expect(eq(total, 40UZ));
+        expect(cascade.meta_information.value.contains("decimation_plan"));
+    };
+
+    "pass band is kept and aliasing bands are rejected"_test = [] {
+        constexpr float sampleRate = 2000000.F;
+        const auto      measure    = [&](float frequency) {
+            gr::incubator::filter::MultiStageDecimator<std::complex<float>> decimator;
+            configure(decimator, 4U);
+            const auto                       input = tone(frequency, sampleRate, 80000UZ);
+            std::vector<std::complex<float>> output(decimator.requiredOutputCount(input.size()));
+            expect(decimator.processBulk(input, output) == gr::work::Status::OK);
+            float peak = 0.F;
+            for (const auto& sample : std::span(output).subspan(output.size() / 2UZ)) { // after all stages settled
+                peak = std::max(peak, std::abs(sample));
+            }
+            return peak;
+        };
+
+        expect(approx(measure(5000.F), 1.F, 0.02F));
+        expect(lt(measure(60000.F), 2e-3F)) << "aliases onto 10 kHz at the 50 kHz output rate";
+        expect(lt(measure(410000.F), 2e-3F));
+    };
+
+    "output does not depend on chunking"_test = [] {
+        const auto input = tone(7000.F, 2000000.F, 20000UZ);
+
+        gr::incubator::filter::MultiStageDecimator<std::complex<float>> whole;
+        configure(whole, 4U);
+        std::vector<std::complex<float>> expected(whole.requiredOutputCount(input.size()));
+        expect(whole.processBulk(input, expected) == gr::work::Status::OK);
+
+        gr::incubator::filter::MultiStageDecimator<std::complex<float>> chunked;
+        configure(chunked, 4U);
+        std::vector<std::complex<float>> output;
+        std::size_t                      offset = 0UZ;
+        for (std::size_t chunk = 1UZ; offset < input.size(); chunk = (chunk * 7UZ + 3UZ) % 997UZ) {
+            const auto                       span = std::span<const std::complex<float>>(input).subspan(offset, std::min(chunk, input.size() - offset));
+            std::vector<std::complex<float>> chunkOut(chunked.requiredOutputCount(span.size()));
+            expect(chunked.processBulk(span, chunkOut) == gr::work::Status::OK);
+            output.insert(output.end(), chunkOut.begin(), chunkOut.end());
+            offset += span.size();
+        }
+
+        expect(eq(output.size(), expected.size()));
+        for (std::size_t i = 0UZ; i < std::min(output.size(), expected.size()); ++i) {
+            expect(std::abs(output[i] - expected[i]) < 1e-5F) << "output" << i;
+        }
+    };
+
+    "runtime sample rate propagation keeps stages and history"_test = [] {
+        gr::incubator::filter::MultiStageDecimator<std::complex<float>> decimator;
+        configure(decimator, 4U);
+
+        const auto                       input = tone(5000.F, 2000000.F, 1000UZ);
+        std::vector<std::complex<float>> output(decimator.requiredOutputCount(input.size()));
+        expect(decimator.processBulk(input, output) == gr::work::Status::OK);
+        const auto stages = decimator._stages;
+
+        decimator.sample_rate = 1000000.F;
+        decimator.settingsChanged({}, gr::property_map{{"sample_rate", gr::pmt::Value(1000000.F)}});
+        expect(eq(decimator._stages.size(), stages.size()));
+        for (std::size_t i = 0UZ; i < std::min(stages.size(), decimator._stages.size()); ++i) {
+            expect(decimator._stages[i].reversedTaps == stages[i].reversedTaps);
+            expect(decimator._stages[i].tail == stages[i].tail) << "stage" << i;
+            expect(eq(decimator._stages[i].phase, stages[i].phase));
+        }
+    };
+
+    "runtime decimation factor rejects zero"_test = [] {
+        gr::incubator::filter::MultiStageDecimator<float> decimator;
+        decimator.decim = 4U;
+        decimator.start();
+
+        decimator.decim = 0U;
+        expect(throws<std::invalid_argument>([&] { decimator.settingsChanged({}, gr::property_map{{"decim", gr::pmt::Value(0U)}}); }));
+    };
+};
+
+int main() {}
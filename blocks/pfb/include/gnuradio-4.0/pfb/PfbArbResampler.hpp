@@ -15,12 +15,15 @@
 #include <cstdio>
 #include <cstdlib>
 #include <limits>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include <gnuradio-4.0/Block.hpp>
 #include <gnuradio-4.0/BlockRegistry.hpp>
-#include <gnuradio-4.0/HistoryBuffer.hpp>
 #include <gnuradio-4.0/Tag.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/BackgroundDesign.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/WorkingSetHint.hpp>
 
 #include <gnuradio-4.0/pfb/PfbArbResamplerKernel.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResamplerTaps.hpp>
@@ -28,16 +31,26 @@
 namespace gr::incubator::pfb {
 
 GR_REGISTER_BLOCK("gr::incubator::pfb::PfbArbResampler", gr::incubator::pfb::PfbArbResampler, ([T]), [ float, std::complex<float> ])
+GR_REGISTER_BLOCK("gr::incubator::pfb::PfbArbResampler", gr::incubator::pfb::PfbArbResampler, ([T], [TAPS_T], [TOut]), [ int16_t ], [ float ], [ int16_t, float ])
+GR_REGISTER_BLOCK("gr::incubator::pfb::PfbArbResampler", gr::incubator::pfb::PfbArbResampler, ([T], [TAPS_T], [TOut]), [ std::complex<int16_t> ], [ float ], [ std::complex<int16_t>, std::complex<float> ])
 
-template<typename T, typename TAPS_T = T>
-struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr::Stride<>> {
-    using Base = Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr::Stride<>>;
+template<typename T, typename TAPS_T = kernel::default_taps_t<T>, typename TOut = T>
+struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T, TOut>, gr::Resampling<>, gr::Stride<>> {
+    using Base = Block<PfbArbResampler<T, TAPS_T, TOut>, gr::Resampling<>, gr::Stride<>>;
     using Base::Base;
 
-    using Description = Doc<"@brief Polyphase filterbank arbitrary resampler (GR3-compatible).">;
+    using Description = Doc<R""(@brief Polyphase filterbank arbitrary resampler (GR3-compatible).
+
+With designed taps (empty taps), a rate change that alters the prototype (rate < 1) is redesigned on a background
+thread; the current filter bank keeps running at the new rate until the new one takes over at a chunk boundary, with
+history and filter phase kept. A longer new bank waits until its history is filled with actual input samples.
+
+int16 and complex<int16> streams (e.g. SoapyRx CS16) are filtered with int16 banks quantised from the float taps and
+32-bit accumulation; TOut is the int16 type (rounded, saturated) or its float counterpart (scaled by 1/32768).
+)"">;
 
     PortIn<T> in;
-    PortOut<T> out;
+    PortOut<TOut> out;
 
     double rate{1.0};
     std::vector<TAPS_T> taps;
@@ -59,8 +72,13 @@ struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr:
             num_filters = 1;
         }
 
+        if (new_settings.contains("taps")) {
+            _designed_taps = false;
+        }
         if (taps.empty()) {
-            taps = create_taps<TAPS_T>(rate, num_filters, stop_band_attenuation);
+            taps = create_taps_cached<TAPS_T>(rate, num_filters, stop_band_attenuation);
+            _designed_taps = true;
+            _design_rate = std::min(rate, 1.0);
         }
 
         _kernel.set_num_filters(num_filters);
@@ -69,6 +87,16 @@ struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr:
             _kernel.set_rate(rate);
         }
 
+        if (taps_changed) {
+            _cancel_redesign(); // built for the previous taps or filter count
+        } else if (rate_changed && _designed_taps) {
+            if (std::min(rate, 1.0) != _design_rate) {
+                _request_redesign();
+            } else {
+                _cancel_redesign(); // back at the current design before an earlier retune finished
+            }
+        }
+
         if (taps_changed || new_settings.contains("taps")) {
             _kernel.set_taps(taps);
         }
@@ -78,6 +106,7 @@ struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr:
 
         _choose_chunk_sizes();
         _resize_history_buffer();
+        _publish_working_set_hint();
     }
 
     template<class InputSpanLike, class OutputSpanLike>
@@ -95,28 +124,24 @@ struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr:
                          call, nin, nout, _historyBuffer.size(), _taps_per_filter, rate);
         }
 
-        if constexpr (requires { _historyBuffer.resize(std::size_t{}); }) {
-            const std::size_t need = (_taps_per_filter > 0 ? _taps_per_filter - 1 : 0) + nin;
-            const std::size_t target = need + 128;
-            if (target > _historyBuffer.size()) {
-                _historyBuffer.resize(target);
-            }
+        if (auto redesigned = _redesign.poll()) {
+            _stage_filter(std::move(*redesigned));
         }
-
-        for (std::size_t i = 0; i < nin; ++i) {
-            _historyBuffer.push_back(inSamples[i]);
+        if (_staged && (_lead >= _staged_extra || _front_index <= 0)) { // chunk boundary: swap in the filter bank designed in the background
+            _swap_filter();
         }
 
+        _historyBuffer.insert(_historyBuffer.end(), inSamples.begin(), inSamples.begin() + static_cast<std::ptrdiff_t>(nin));
+
         int produced = 0;
         int consumed = 0;
 
-        if (_taps_per_filter > 0 && _historyBuffer.size() >= _taps_per_filter && nout > 0) {
-            const std::size_t available = _historyBuffer.size() - _taps_per_filter + 1;
+        if (_taps_per_filter > 0 && _historyBuffer.size() >= _lead + _taps_per_filter && nout > 0) {
+            const std::size_t available = _historyBuffer.size() - _lead - _taps_per_filter + 1;
             const int n_to_read = static_cast<int>(std::min<std::size_t>(available, static_cast<std::size_t>(std::numeric_limits<int>::max())));
-            produced = _kernel.filter(_historyBuffer, n_to_read, &outSamples[0], static_cast<int>(nout), consumed);
-            for (int i = 0; i < consumed; ++i) {
-                _historyBuffer.pop_front();
-            }
+            produced = _kernel.filter(std::span<const T>(_historyBuffer).subspan(_lead), n_to_read, &outSamples[0], static_cast<int>(nout), consumed);
+            _lead += static_cast<std::size_t>(consumed);
+            _drop_leading_history(_staged ? _staged_extra : 0);
         }
 
         // if (debug) {
@@ -149,31 +174,127 @@ struct PfbArbResampler : Block<PfbArbResampler<T, TAPS_T>, gr::Resampling<>, gr:
     }
 
 private:
-    kernel::PfbArbResamplerKernel<T, TAPS_T> _kernel{};
+    using kernel_type = kernel::PfbArbResamplerKernel<T, TAPS_T, TOut>;
+
+    struct redesigned_filter {
+        std::vector<TAPS_T> taps;
+        kernel_type kernel;
+        double design_rate;
+        std::vector<T> history; // empty, with room for the history of both banks, so that neither staging nor the swap allocates
+    };
+
+    static constexpr std::size_t kHistoryGuard = 128;
+
+    kernel_type _kernel{};
     std::size_t _taps_per_filter{0};
-    HistoryBuffer<T> _historyBuffer{1024};
+    std::vector<T> _historyBuffer; // contiguous, so the kernel can hand whole filter windows to the SIMD dot product
+    bool _designed_taps{false};
+    double _design_rate{1.0}; // rate the designed taps were made for, capped at 1 (where the prototype stops changing)
+    dsp_kernels::BackgroundDesign<redesigned_filter> _redesign;
+    std::optional<redesigned_filter> _staged; // designed bank waiting for its history to fill
+    std::size_t _staged_extra{0};             // history samples the staged bank needs beyond the current one
+    std::size_t _lead{0};                     // samples kept in front of the current bank's window for the staged one
+    std::ptrdiff_t _front_index{0};           // stream index of _historyBuffer[0], negative for the zeros before the stream
+
+    void _request_redesign() {
+        _redesign.request([rate = rate, num_filters = num_filters, attenuation_db = stop_band_attenuation, capacity = _historyBuffer.capacity()] {
+            auto new_taps = create_taps_cached<TAPS_T>(rate, num_filters, attenuation_db);
+            kernel_type new_kernel(rate, new_taps, num_filters);
+            const std::size_t new_taps_per_filter = new_kernel.taps_per_filter();
+            std::vector<T> history;
+            history.reserve(std::max(capacity, new_taps_per_filter + _input_chunk_size(rate) + kHistoryGuard) + new_taps_per_filter);
+            return redesigned_filter{std::move(new_taps), std::move(new_kernel), std::min(rate, 1.0), std::move(history)};
+        });
+    }
+
+    void _cancel_redesign() {
+        _redesign.cancel();
+        _staged.reset();
+        _drop_leading_history(0);
+    }
+
+    // Erases the samples in front of the current bank's window beyond the `keep` most recent ones.
+    void _drop_leading_history(std::size_t keep) {
+        const std::size_t drop = _lead - std::min(_lead, keep);
+        _historyBuffer.erase(_historyBuffer.begin(), _historyBuffer.begin() + static_cast<std::ptrdiff_t>(drop));
+        _front_index += static_cast<std::ptrdiff_t>(drop);
+        _lead -= drop;
+    }
+
+    // Moves the history into the buffer reserved by the background design, which also has room for the samples that a
+    // longer bank needs from before the current window; those are kept from here on until the swap.
+    void _stage_filter(redesigned_filter&& redesigned) {
+        const std::size_t old_history = _taps_per_filter > 0 ? _taps_per_filter - 1 : 0;
+        const std::size_t new_history = redesigned.kernel.taps_per_filter() > 0 ? redesigned.kernel.taps_per_filter() - 1 : 0;
+        redesigned.history.assign(_historyBuffer.begin(), _historyBuffer.end());
+        std::swap(_historyBuffer, redesigned.history);
+        _staged = std::move(redesigned);
+        _staged_extra = _samples_before_window(old_history, new_history);
+        _drop_leading_history(_staged_extra);
+    }
+
+    // Group delays are history / 2 samples, so the new bank's newest sample sits half the history difference after the
+    // current one's (rounded down, the odd half sample goes into the filter phase); returns how many samples from
+    // before the current window the new one needs.
+    [[nodiscard]] static std::size_t _samples_before_window(std::size_t old_history, std::size_t new_history) {
+        const std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(new_history) - static_cast<std::ptrdiff_t>(old_history);
+        return static_cast<std::size_t>(std::max<std::ptrdiff_t>(0, delta - _floor_half(delta)));
+    }
+
+    [[nodiscard]] static std::ptrdiff_t _floor_half(std::ptrdiff_t delta) { return delta >= 0 ? delta / 2 : -((1 - delta) / 2); }
+
+    // Keeps the filter phase and the output timing: the new window is centred where the current one is. Its history
+    // is input samples, or zeros only where the new bank reaches back before the start of the stream.
+    void _swap_filter() {
+        const std::size_t old_history = _taps_per_filter > 0 ? _taps_per_filter - 1 : 0;
+        const std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(_staged->kernel.taps_per_filter()) - static_cast<std::ptrdiff_t>(_taps_per_filter);
+        const unsigned int carry = _staged->kernel.continue_from(_kernel, delta % 2 != 0);
+        _kernel = std::move(_staged->kernel);
+        taps = std::move(_staged->taps);
+        _design_rate = _staged->design_rate;
+        _taps_per_filter = _kernel.taps_per_filter();
+        sample_delay = static_cast<std::size_t>(std::max(0, _kernel.group_delay()));
+        _staged.reset();
+
+        const std::size_t new_history = _taps_per_filter > 0 ? _taps_per_filter - 1 : 0;
+        const std::ptrdiff_t window_start = static_cast<std::ptrdiff_t>(_lead + old_history + carry) + _floor_half(delta) - static_cast<std::ptrdiff_t>(new_history);
+        if (window_start < 0) { // within the capacity reserved by the background design
+            _historyBuffer.insert(_historyBuffer.begin(), static_cast<std::size_t>(-window_start), T{});
+        } else {
+            _historyBuffer.erase(_historyBuffer.begin(), _historyBuffer.begin() + std::min(window_start, static_cast<std::ptrdiff_t>(_historyBuffer.size())));
+        }
+        _front_index += window_start;
+        _lead = 0; // no _resize_history_buffer(): the capacity is reserved, and zero padding would land behind the input
+        _publish_working_set_hint();
+    }
+
+    [[nodiscard]] static std::size_t _input_chunk_size(double r) {
+        constexpr std::size_t base = 1024;
+        return r < 1.0 ? static_cast<std::size_t>(std::max(1.0, std::floor(static_cast<double>(base) / std::max(r, 1e-9)))) : base;
+    }
 
     void _choose_chunk_sizes() {
         constexpr std::size_t base = 1024;
-        std::size_t in_chunk = base;
-        std::size_t out_chunk = static_cast<std::size_t>(std::max(1.0, std::floor(static_cast<double>(in_chunk) * std::max(rate, 1e-9))));
-        if (rate < 1.0) {
-            out_chunk = base;
-            in_chunk = static_cast<std::size_t>(std::max(1.0, std::floor(static_cast<double>(out_chunk) / std::max(rate, 1e-9))));
-        }
-        this->input_chunk_size = in_chunk;
-        this->output_chunk_size = out_chunk;
+        this->input_chunk_size = _input_chunk_size(rate);
+        this->output_chunk_size = rate < 1.0 ? base : static_cast<std::size_t>(std::max(1.0, std::floor(static_cast<double>(base) * std::max(rate, 1e-9))));
+    }
+
+    // working set per work() call for cache-fitted chunk planners: filter bank + history + input span + resampled output span
+    void _publish_working_set_hint() {
+        const double fixed_bytes      = static_cast<double>(taps.size() * sizeof(TAPS_T) + _historyBuffer.capacity() * sizeof(T));
+        const double bytes_per_sample = static_cast<double>(sizeof(T)) * 2.0 + static_cast<double>(sizeof(TOut)) * rate; // input copied into the history, then read
+        dsp_kernels::publishWorkingSetHint(this->meta_information.value, fixed_bytes, bytes_per_sample);
     }
 
     void _resize_history_buffer() {
-        const std::size_t guard = 128;
-        const std::size_t cap = _taps_per_filter + std::max<std::size_t>(this->input_chunk_size, 1) + guard;
-        if constexpr (requires { _historyBuffer.resize(std::size_t{}); }) {
-            _historyBuffer.resize(cap);
-        }
+        const std::size_t cap = _taps_per_filter + std::max<std::size_t>(this->input_chunk_size, 1) + kHistoryGuard;
+        _historyBuffer.reserve(cap);
 
-        while (_historyBuffer.size() < (_taps_per_filter > 0 ? _taps_per_filter - 1 : 0)) {
-            _historyBuffer.push_back(T{});
+        if (const std::size_t need = _taps_per_filter > 0 ? _taps_per_filter - 1 : 0; _historyBuffer.size() < need) {
+            if (_historyBuffer.empty()) {
+                _front_index = -static_cast<std::ptrdiff_t>(need);
+            }
+            _historyBuffer.resize(need, T{});
         }
     }
 };
@@ -10,18 +10,39 @@
 #include <algorithm>
 #include <cmath>
 #include <complex>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
 
+#include <gnuradio-4.0/algorithm/dsp_kernels/DotProduct.hpp>
+#include <gnuradio-4.0/algorithm/dsp_kernels/FixedPoint.hpp>
+
 namespace gr::incubator::pfb::kernel {
 
-template<typename T, typename TAPS_T = T>
+// int16 (e.g. SoapySDR CS16) samples are filtered with int16 banks quantised from float taps and 32-bit accumulation
+template<typename T>
+inline constexpr bool is_int16_sample_v = std::same_as<T, std::int16_t> || std::same_as<T, std::complex<std::int16_t>>;
+
+template<typename T>
+using default_taps_t = std::conditional_t<is_int16_sample_v<T>, float, T>;
+
+// OUT_T differs from T only for int16 samples: int16 outputs are rounded and saturated, float outputs scaled by
+// 1/32768 (int16 full scale is 1.0).
+template<typename T, typename TAPS_T = default_taps_t<T>, typename OUT_T = T>
 class PfbArbResamplerKernel {
 public:
     using sample_type = T;
     using taps_type = TAPS_T;
+    using output_type = OUT_T;
+
+    static constexpr bool kFixedPoint = is_int16_sample_v<T>;
+    static_assert(!kFixedPoint || std::floating_point<TAPS_T>, "int16 samples need real floating-point taps to quantise");
+    static_assert(kFixedPoint || std::same_as<OUT_T, T>, "only int16 samples convert on output");
 
     PfbArbResamplerKernel() = default;
 
@@ -52,6 +73,10 @@ public:
         create_diff_taps(taps, dtaps);
         create_taps(taps, d_taps);
         create_taps(dtaps, d_dtaps);
+        if constexpr (kFixedPoint) {
+            d_shift = quantise_banks(d_taps, d_taps_q);
+            d_dshift = quantise_banks(d_dtaps, d_dtaps_q);
+        }
 
         update_delay_and_phase();
     }
@@ -71,6 +96,17 @@ public:
         d_last_filter = static_cast<unsigned int>(ph / ph_diff);
     }
 
+    // Continues at the filter phase reached by `other` (same number of filters), e.g. when a redesigned filter bank
+    // takes over mid-stream, so the output timing does not jump. `half_sample` moves the phase half an input sample
+    // later, for banks whose group delays differ by an odd number of half samples; returns the whole input samples
+    // (0 or 1) that this carries over.
+    unsigned int continue_from(const PfbArbResamplerKernel& other, bool half_sample = false) {
+        const unsigned int filter = other.d_last_filter % d_int_rate + (half_sample ? d_int_rate / 2 : 0);
+        d_last_filter = filter % d_int_rate;
+        d_acc = other.d_acc;
+        return filter / d_int_rate;
+    }
+
     double phase() const {
         const double ph_diff = 2.0 * kPi / static_cast<double>(d_int_rate);
         return static_cast<double>(d_last_filter) * ph_diff;
@@ -90,7 +126,7 @@ public:
     template<typename InputAccessor>
     int filter(const InputAccessor& input,
                int n_to_read,
-               sample_type* output,
+               output_type* output,
                int output_capacity,
                int& n_read)
     {
@@ -106,10 +142,14 @@ public:
         while (i_in < n_to_read && i_out < output_capacity) {
             while (j < d_int_rate && i_in < n_to_read && i_out < output_capacity) {
                 const std::size_t base = static_cast<std::size_t>(i_in) + d_taps_per_filter - 1;
-                const sample_type o0 = dot(d_taps[j], input, base);
-                const sample_type o1 = dot(d_dtaps[j], input, base);
-
-                output[i_out] = o0 + scale_sample(o1, d_acc);
+                if constexpr (kFixedPoint) {
+                    output[i_out] = combine_fixed(dot(d_taps_q[j], input, base), dot(d_dtaps_q[j], input, base));
+                } else {
+                    const sample_type o0 = dot(d_taps[j], input, base);
+                    const sample_type o1 = dot(d_dtaps[j], input, base);
+
+                    output[i_out] = o0 + scale_sample(o1, d_acc);
+                }
                 ++i_out;
 
                 d_acc += d_flt_rate;
@@ -128,9 +168,17 @@ public:
 private:
     static constexpr double kPi = 3.14159265358979323846;
 
+    using filter_taps = dsp_kernels::AlignedVector<TAPS_T>; // one polyphase branch, stored in reverse order
+
     std::vector<TAPS_T> d_proto_taps;
-    std::vector<std::vector<TAPS_T>> d_taps;
-    std::vector<std::vector<TAPS_T>> d_dtaps;
+    std::vector<filter_taps> d_taps;
+    std::vector<filter_taps> d_dtaps;
+
+    using fixed_taps = dsp_kernels::AlignedVector<std::int16_t>; // d_taps/d_dtaps quantised with a common shift each
+    std::vector<fixed_taps> d_taps_q;
+    std::vector<fixed_taps> d_dtaps_q;
+    int d_shift{0};
+    int d_dshift{0};
 
     unsigned int d_int_rate{32};
     unsigned int d_dec_rate{1};
@@ -155,7 +203,7 @@ private:
     }
 
     void create_taps(const std::vector<TAPS_T>& newtaps,
-                     std::vector<std::vector<TAPS_T>>& outtaps)
+                     std::vector<filter_taps>& outtaps)
     {
         const std::size_t ntaps = newtaps.size();
         d_taps_per_filter = static_cast<unsigned int>(std::ceil(static_cast<double>(ntaps) / static_cast<double>(d_int_rate)));
@@ -169,7 +217,7 @@ private:
         for (unsigned int i = 0; i < d_int_rate; ++i) {
             outtaps[i].assign(d_taps_per_filter, TAPS_T{});
             for (unsigned int j = 0; j < d_taps_per_filter; ++j) {
-                outtaps[i][j] = tmp_taps[i + j * d_int_rate];
+                outtaps[i][d_taps_per_filter - 1 - j] = tmp_taps[i + j * d_int_rate];
             }
         }
     }
@@ -196,13 +244,59 @@ private:
         d_est_phase_change = static_cast<double>(d_last_filter) - (static_cast<double>(end_filter) + accum_frac);
     }
 
-    template<typename InputAccessor>
-    sample_type dot(const std::vector<TAPS_T>& taps, const InputAccessor& input, std::size_t base) const {
-        sample_type acc{};
-        for (std::size_t i = 0; i < taps.size(); ++i) {
-            acc += input[base - i] * taps[i];
+    // the branches share one scale, so the combination below stays a plain sum; returns that shift
+    static int quantise_banks(const std::vector<filter_taps>& banks, std::vector<fixed_taps>& out) {
+        int shift = 30;
+        for (const auto& bank : banks) {
+            shift = std::min(shift, dsp_kernels::int16TapShift(std::span<const TAPS_T>(bank)));
+        }
+        out.assign(banks.size(), fixed_taps{});
+        for (std::size_t i = 0; i < banks.size(); ++i) {
+            out[i].resize(banks[i].size());
+            dsp_kernels::quantiseInt16(std::span<const TAPS_T>(banks[i]), shift, std::span<std::int16_t>(out[i]));
+        }
+        return shift;
+    }
+
+    // `base` indexes the newest sample of the window; contiguous inputs go through the SIMD kernels. int16 windows
+    // accumulate in 32 bits.
+    template<typename Bank, typename InputAccessor>
+    auto dot(const Bank& taps, const InputAccessor& input, std::size_t base) const {
+        const std::size_t first = base + 1 - taps.size();
+        if constexpr (requires { { std::data(input) } -> std::convertible_to<const sample_type*>; }) {
+            return dsp_kernels::dot(std::data(input) + first, taps.data(), taps.size());
+        } else if constexpr (kFixedPoint) {
+            decltype(dsp_kernels::dot(static_cast<const sample_type*>(nullptr), taps.data(), 0)) acc{};
+            for (std::size_t i = 0; i < taps.size(); ++i) {
+                if constexpr (std::is_arithmetic_v<sample_type>) {
+                    acc += static_cast<std::int32_t>(input[first + i]) * taps[i];
+                } else {
+                    acc += std::complex<std::int32_t>(input[first + i].real() * taps[i], input[first + i].imag() * taps[i]);
+                }
+            }
+            return acc;
+        } else {
+            sample_type acc{};
+            for (std::size_t i = 0; i < taps.size(); ++i) {
+                acc += input[first + i] * taps[i];
+            }
+            return acc;
+        }
+    }
+
+    // o0 + d_acc * o1 as for floating-point samples, evaluated on the int16 sample scale
+    template<typename Acc>
+    output_type combine_fixed(const Acc& o0, const Acc& o1) const {
+        const auto combine = [this](std::int32_t a0, std::int32_t a1) {
+            return std::ldexp(static_cast<double>(a0), -d_shift) + std::ldexp(static_cast<double>(a1), -d_dshift) * d_acc;
+        };
+        if constexpr (std::is_arithmetic_v<sample_type>) {
+            return dsp_kernels::fromInt16Scale<output_type>(combine(o0, o1));
+        } else {
+            using scalar_t = typename output_type::value_type;
+            return {dsp_kernels::fromInt16Scale<scalar_t>(combine(o0.real(), o1.real())),
+                    dsp_kernels::fromInt16Scale<scalar_t>(combine(o0.imag(), o1.imag()))};
         }
-        return acc;
     }
 
     static sample_type scale_sample(const sample_type& value, double scale) {
@@ -9,9 +9,12 @@
 
 #include <complex>
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <type_traits>
 #include <vector>
 
+#include <gnuradio-4.0/algorithm/dsp_kernels/TapCache.hpp>
 #include <gnuradio-4.0/pfb/PfbFirdes.hpp>
 #include <gnuradio-4.0/pfb/PfbOptfir.hpp>
 
@@ -90,4 +93,19 @@ std::vector<TAPS_T> create_taps(double rate, std::size_t num_filters, double att
     }
 }
 
+// create_taps() through the process-wide tap cache (see dsp_kernels::TapCache), so resamplers sharing a design,
+// settings changes and, with GR4_TAP_CACHE_DIR set, process restarts skip the ripple search.
+inline constexpr std::uint32_t kTapDesignVersion = 1U; // bump when create_taps() output changes for the same arguments
+
+template <typename TAPS_T>
+std::vector<TAPS_T> create_taps_cached(double rate, std::size_t num_filters, double attenuation_db)
+{
+    // create_taps() only depends on rate through rate < 1 and the halfband derived from it
+    const double design_rate = rate < 1.0 ? rate : 1.0;
+    const std::string key = dsp_kernels::tapCacheKey(
+        "PfbArbResampler", kTapDesignVersion, sizeof(TAPS_T), is_complex<TAPS_T>::value, design_rate, num_filters, attenuation_db);
+    return *dsp_kernels::TapCache<TAPS_T>::instance().getOrDesign(
+        key, [&] { return create_taps<TAPS_T>(rate, num_filters, attenuation_db); });
+}
+
 } // namespace gr::incubator::pfb
@@ -6,10 +6,22 @@
  */
 
 #include <boost/ut.hpp>
+#include <algorithm>
+#include <chrono>
 #include <complex>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
 
+#include <gnuradio-4.0/algorithm/dsp_kernels/TapCache.hpp>
+#include <gnuradio-4.0/pfb/PfbArbResampler.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResamplerKernel.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResamplerTaps.hpp>
 
@@ -31,6 +43,84 @@ static std::vector<std::complex<float>> sig_source_c(double samp_rate, double fr
     return out;
 }
 
+// Minimal stand-ins for the scheduler's spans, to drive PfbArbResampler::processBulk() chunk by chunk.
+template <typename T>
+struct TestInputSpan {
+    std::span<const T> samples;
+    std::vector<std::pair<std::ptrdiff_t, std::reference_wrapper<const gr::property_map>>> tag_list;
+
+    std::size_t size() const { return samples.size(); }
+    auto begin() const { return samples.begin(); }
+    bool consume(std::size_t) { return true; }
+    const auto& tags() const { return tag_list; }
+};
+
+template <typename T>
+struct TestOutputSpan {
+    std::span<T> samples;
+    std::size_t published{0};
+
+    std::size_t size() const { return samples.size(); }
+    T& operator[](std::size_t i) { return samples[i]; }
+    void publish(std::size_t n) { published = n; }
+    void publishTag(const gr::property_map&, std::size_t) {}
+};
+
+// Changes the rate of a running resampler fed with a unit tone and checks that the output stays a continuous unit tone
+// across the swap to the bank designed in the background: zeros in place of input history would show up as an
+// amplitude dip, a window not centred like the previous one as a phase step.
+void expect_continuous_rate_change(double from_rate, double to_rate) {
+    using C = std::complex<float>;
+    constexpr double fs = 5000.0;
+    constexpr double freq = 100.0;
+
+    gr::incubator::pfb::PfbArbResampler<C> resampler;
+    resampler.rate = from_rate;
+    resampler.stop_band_attenuation = 80.0;
+    resampler.settingsChanged({}, gr::property_map{{"rate", from_rate}, {"stop_band_attenuation", 80.0}});
+    const std::size_t initial_taps = resampler.taps.size();
+
+    double phase = 0.0;
+    std::vector<C> output;
+    const auto process_chunk = [&] {
+        std::vector<C> in(512);
+        for (auto& sample : in) {
+            sample = C(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+            phase += 2.0 * kPi * freq / fs;
+        }
+        std::vector<C> out(in.size() + 64);
+        TestInputSpan<C> in_span{in, {}};
+        TestOutputSpan<C> out_span{out};
+        expect(resampler.processBulk(in_span, out_span) == gr::work::Status::OK);
+        output.insert(output.end(), out.begin(), out.begin() + static_cast<std::ptrdiff_t>(out_span.published));
+    };
+
+    for (int i = 0; i < 8; ++i) {
+        process_chunk();
+    }
+    resampler.rate = to_rate; // designed in the background, old bank keeps running at the new rate
+    resampler.settingsChanged({}, gr::property_map{{"rate", to_rate}});
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (resampler.taps.size() == initial_taps && std::chrono::steady_clock::now() < deadline) {
+        process_chunk();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    expect(resampler.taps.size() != initial_taps) << "redesigned bank swapped in" << fatal;
+    expect((resampler.taps.size() < initial_taps) == (to_rate > from_rate));
+    const std::size_t swap_index = output.size();
+    for (int i = 0; i < 8; ++i) {
+        process_chunk();
+    }
+    expect(output.size() > swap_index + 1000);
+
+    // a unit tone stays a unit tone, and consecutive outputs never step further than one period at the lowest rate
+    const double max_step = 2.0 * std::sin(kPi * freq / (fs * std::min(from_rate, to_rate))) + 0.05;
+    for (std::size_t i = 2 * initial_taps / resampler.num_filters; i < output.size(); ++i) {
+        expect(std::abs(std::abs(output[i]) - 1.0f) < 0.05f) << "amplitude at" << i;
+        expect(std::abs(output[i] - output[i - 1]) < max_step) << "step at" << i;
+    }
+}
+
 } // namespace
 
 const suite PfbArbResamplerTests = [] {
@@ -114,6 +204,185 @@ const suite PfbArbResamplerTests = [] {
             expect(err < 0.05f);
         }
     };
+    "continue_from_keeps_the_output_phase"_test = [] {
+        const double rrate = 0.7312;
+        const std::size_t nfilts = 32;
+        const auto taps = gr::incubator::pfb::create_taps<float>(rrate, nfilts, 60.0);
+
+        PfbArbResamplerKernel<std::complex<float>, float> whole(rrate, taps, nfilts);
+        const std::size_t k = whole.taps_per_filter();
+        const std::size_t n = 3000;
+        std::vector<std::complex<float>> input(k - 1, std::complex<float>{});
+        const auto data = sig_source_c(5000.0, 311.0, n);
+        input.insert(input.end(), data.begin(), data.end());
+
+        std::vector<std::complex<float>> expected(n, std::complex<float>{});
+        int n_read = 0;
+        const int n_expected = whole.filter(input, static_cast<int>(n), expected.data(), static_cast<int>(n), n_read);
+
+        // a filter bank swapped in after 777 inputs, as PfbArbResampler does after a background redesign
+        PfbArbResamplerKernel<std::complex<float>, float> before(rrate, taps, nfilts);
+        std::vector<std::complex<float>> output(n, std::complex<float>{});
+        int consumed = 0;
+        const int n_before = before.filter(input, 777, output.data(), static_cast<int>(n), consumed);
+
+        PfbArbResamplerKernel<std::complex<float>, float> after(rrate, taps, nfilts);
+        after.continue_from(before);
+        const std::span<const std::complex<float>> rest = std::span<const std::complex<float>>(input).subspan(static_cast<std::size_t>(consumed));
+        const int n_after = after.filter(rest, static_cast<int>(n) - consumed, output.data() + n_before, static_cast<int>(n) - n_before, n_read);
+
+        expect(n_before + n_after == n_expected);
+        for (int i = 0; i < std::min(n_before + n_after, n_expected); ++i) {
+            expect(std::abs(output[static_cast<std::size_t>(i)] - expected[static_cast<std::size_t>(i)]) < 1e-5f);
+        }
+    };
+
+    "int16_samples_match_the_float_kernel"_test = [] {
+        const double rrate = 0.7312;
+        const std::size_t nfilts = 32;
+        const auto taps = gr::incubator::pfb::create_taps<float>(rrate, nfilts, 60.0);
+
+        PfbArbResamplerKernel<std::complex<float>, float> reference(rrate, taps, nfilts);
+        PfbArbResamplerKernel<std::complex<std::int16_t>, float, std::complex<float>> to_float(rrate, taps, nfilts);
+        PfbArbResamplerKernel<std::complex<std::int16_t>> to_int16(rrate, taps, nfilts);
+
+        const std::size_t k = reference.taps_per_filter();
+        const std::size_t n = 3000;
+        const auto data = sig_source_c(5000.0, 311.0, n);
+        std::vector<std::complex<std::int16_t>> input(k - 1, std::complex<std::int16_t>{});
+        std::vector<std::complex<float>> scaled(k - 1, std::complex<float>{});
+        for (const auto& sample : data) { // just below full scale, so the int16 output must not wrap
+            input.emplace_back(static_cast<std::int16_t>(std::lround(32000.0f * sample.real())),
+                               static_cast<std::int16_t>(std::lround(32000.0f * sample.imag())));
+            scaled.emplace_back(static_cast<float>(input.back().real()) / 32768.0f,
+                                static_cast<float>(input.back().imag()) / 32768.0f);
+        }
+
+        std::vector<std::complex<float>> expected(n, std::complex<float>{});
+        std::vector<std::complex<float>> as_float(n, std::complex<float>{});
+        std::vector<std::complex<std::int16_t>> as_int16(n, std::complex<std::int16_t>{});
+        int n_read = 0;
+        const int n_expected = reference.filter(scaled, static_cast<int>(n), expected.data(), static_cast<int>(n), n_read);
+        expect(to_float.filter(input, static_cast<int>(n), as_float.data(), static_cast<int>(n), n_read) == n_expected);
+        expect(to_int16.filter(input, static_cast<int>(n), as_int16.data(), static_cast<int>(n), n_read) == n_expected);
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(n_expected); ++i) {
+            expect(std::abs(as_float[i] - expected[i]) < 1e-3f); // tap quantisation error
+            const std::complex<float> rescaled(static_cast<float>(as_int16[i].real()) / 32768.0f,
+                                               static_cast<float>(as_int16[i].imag()) / 32768.0f);
+            expect(std::abs(rescaled - as_float[i]) < 1.5f / 32768.0f); // rounding to int16
+        }
+    };
+
+    "rate_change_keeps_the_stream_continuous_across_the_filter_swap"_test = [] {
+        expect_continuous_rate_change(0.6, 0.8); // narrower prototype: shorter bank
+        expect_continuous_rate_change(0.8, 0.3); // wider prototype: longer bank, swapped in once its history holds input
+    };
+
+    "int16_blocks_match_the_float_block"_test = [] {
+        using CI16 = std::complex<std::int16_t>;
+        using CF = std::complex<float>;
+        const auto init = [](auto& resampler) {
+            resampler.rate = 0.7312;
+            resampler.stop_band_attenuation = 60.0;
+            resampler.settingsChanged({}, gr::property_map{{"rate", 0.7312}, {"stop_band_attenuation", 60.0}});
+        };
+        gr::incubator::pfb::PfbArbResampler<CF> reference;
+        gr::incubator::pfb::PfbArbResampler<CI16, float, CF> to_float;
+        gr::incubator::pfb::PfbArbResampler<CI16> to_int16;
+        init(reference);
+        init(to_float);
+        init(to_int16);
+
+        const auto data = sig_source_c(5000.0, 311.0, 3000);
+        std::vector<CI16> input;
+        std::vector<CF> scaled;
+        for (const auto& sample : data) {
+            input.emplace_back(static_cast<std::int16_t>(std::lround(32000.0f * sample.real())),
+                               static_cast<std::int16_t>(std::lround(32000.0f * sample.imag())));
+            scaled.emplace_back(static_cast<float>(input.back().real()) / 32768.0f,
+                                static_cast<float>(input.back().imag()) / 32768.0f);
+        }
+
+        std::vector<CF> expected(data.size());
+        std::vector<CF> as_float(data.size());
+        std::vector<CI16> as_int16(data.size());
+        TestOutputSpan<CF> expected_span{expected};
+        TestOutputSpan<CF> float_span{as_float};
+        TestOutputSpan<CI16> int16_span{as_int16};
+        TestInputSpan<CF> scaled_in{scaled, {}};
+        TestInputSpan<CI16> float_in{input, {}};
+        TestInputSpan<CI16> int16_in{input, {}};
+        expect(reference.processBulk(scaled_in, expected_span) == gr::work::Status::OK);
+        expect(to_float.processBulk(float_in, float_span) == gr::work::Status::OK);
+        expect(to_int16.processBulk(int16_in, int16_span) == gr::work::Status::OK);
+
+        expect(expected_span.published > 2000_ul);
+        expect(float_span.published == expected_span.published);
+        expect(int16_span.published == expected_span.published);
+        for (std::size_t i = 0; i < std::min(expected_span.published, float_span.published); ++i) {
+            expect(std::abs(as_float[i] - expected[i]) < 1e-3f); // tap quantisation error
+        }
+        for (std::size_t i = 0; i < std::min(float_span.published, int16_span.published); ++i) {
+            const CF rescaled(static_cast<float>(as_int16[i].real()) / 32768.0f,
+                              static_cast<float>(as_int16[i].imag()) / 32768.0f);
+            expect(std::abs(rescaled - as_float[i]) < 1.5f / 32768.0f); // rounding to int16
+        }
+    };
+
+    "cached_taps_match_create_taps"_test = [] {
+        auto& cache = gr::incubator::dsp_kernels::TapCache<float>::instance();
+        cache.clear();
+
+        const auto taps = gr::incubator::pfb::create_taps_cached<float>(2.4321, 32, 80.0);
+        expect(taps == gr::incubator::pfb::create_taps<float>(2.4321, 32, 80.0));
+        expect(cache.size() == 1_ul);
+
+        // above rate 1 the prototype does not depend on the rate
+        expect(gr::incubator::pfb::create_taps_cached<float>(1.5, 32, 80.0) == taps);
+        expect(cache.size() == 1_ul);
+
+        expect(gr::incubator::pfb::create_taps_cached<float>(0.5, 32, 80.0) == gr::incubator::pfb::create_taps<float>(0.5, 32, 80.0));
+        expect(cache.size() == 2_ul);
+    };
+
+    "tap_cache_directory_survives_restart"_test = [] {
+        using gr::incubator::dsp_kernels::TapCache;
+        auto& cache = TapCache<double>::instance();
+        const auto previous = cache.directory();
+        const auto directory = std::filesystem::temp_directory_path() / "qa_PfbArbResampler_tap_cache";
+        std::filesystem::remove_all(directory);
+        cache.setDirectory(directory);
+        cache.clear();
+
+        int designs = 0;
+        const auto design = [&designs] {
+            ++designs;
+            return std::vector<double>{0.25, 0.5, 0.25};
+        };
+        const std::string key = gr::incubator::dsp_kernels::tapCacheKey("qa", 1U, 3.0, std::size_t{32});
+        expect(*cache.getOrDesign(key, design) == std::vector<double>{0.25, 0.5, 0.25});
+        expect(designs == 1_i);
+
+        cache.clear(); // what a restart leaves behind
+        expect(*cache.getOrDesign(key, design) == std::vector<double>{0.25, 0.5, 0.25});
+        expect(designs == 1_i) << "loaded from disk";
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            std::ofstream(entry.path(), std::ios::binary | std::ios::app) << "garbage";
+        }
+        cache.clear();
+        expect(*cache.getOrDesign(key, design) == std::vector<double>{0.25, 0.5, 0.25});
+        expect(designs == 2_i) << "corrupt files are redesigned";
+
+        cache.clear();
+        expect(*cache.getOrDesign(gr::incubator::dsp_kernels::tapCacheKey("qa", 2U, 3.0, std::size_t{32}), design) == std::vector<double>{0.25, 0.5, 0.25});
+        expect(designs == 3_i) << "a new design version does not load files of the old one";
+
+        cache.setDirectory(previous);
+        cache.clear();
+        std::filesystem::remove_all(directory);
+    };
 };
 
 int main() {
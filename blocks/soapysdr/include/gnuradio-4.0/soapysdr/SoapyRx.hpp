@@ -5,14 +5,19 @@
 #include <cctype>
 #include <cstdint>
 #include <format>
+#include <mutex>
 #include <print>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <gnuradio-4.0/Block.hpp>
 #include <gnuradio-4.0/BlockRegistry.hpp>
 #include <gnuradio-4.0/meta/utils.hpp>
+#include <gnuradio-4.0/scheduler/IoWakeup.hpp>
 
 #include <SoapySDR/Device.hpp>
 #include <SoapySDR/Formats.h>
@@ -42,8 +47,9 @@ struct SoapyRx : Block<SoapyRx<T>> {
     std::uint32_t max_chunk_size = 8192U;
     std::uint32_t stream_timeout_us = 1'000U;
     gr::Size_t    max_overflow_count = 10U;
+    bool          async_io = false; // read on a dedicated thread, processBulk() only copies what arrived
 
-    GR_MAKE_REFLECTABLE(SoapyRx, out, device, device_args, sample_rate, channel, center_frequency, bandwidth, gain, antenna, debug, max_chunk_size, stream_timeout_us, max_overflow_count);
+    GR_MAKE_REFLECTABLE(SoapyRx, out, device, device_args, sample_rate, channel, center_frequency, bandwidth, gain, antenna, debug, max_chunk_size, stream_timeout_us, max_overflow_count, async_io);
 
     SoapyRx() = default;
 
@@ -72,10 +78,11 @@ struct SoapyRx : Block<SoapyRx<T>> {
 
         const bool device_changed = new_settings.contains("device") || new_settings.contains("device_args");
         const bool rate_changed = new_settings.contains("sample_rate") || new_settings.contains("channel");
+        const bool mode_changed = new_settings.contains("async_io") || (async_io && new_settings.contains("max_chunk_size")); // only the reader sizes its buffers by max_chunk_size
 
-        if (device_changed || rate_changed) {
+        if (device_changed || rate_changed || mode_changed) {
             if (debug || std::getenv("GR4_SOAPY_DEBUG")) {
-                std::println(stderr, "[SoapyRx] reinit device (device/rate/channel changed)");
+                std::println(stderr, "[SoapyRx] reinit device (device/rate/channel/io mode changed)");
             }
             closeDevice();
             openDevice();
@@ -112,6 +119,10 @@ struct SoapyRx : Block<SoapyRx<T>> {
             return gr::work::Status::OK;
         }
 
+        if (async_io) {
+            return drainReader(output, max_samples);
+        }
+
         int       flags = 0;
         long long time_ns = 0;
         void* buffers[1] = {output.data()};
@@ -140,10 +151,106 @@ struct SoapyRx : Block<SoapyRx<T>> {
     }
 
 private:
+    static constexpr std::size_t kReaderChunks = 8UZ; // reader ring capacity in units of max_chunk_size
+
     SoapySDR::Device* _dev = nullptr;
     SoapySDR::Stream* _stream = nullptr;
     gr::Size_t        _overflow_count = 0U;
 
+    // async_io: samples read by _reader, handed over through a ring buffer guarded by _reader_mutex
+    std::mutex     _reader_mutex;
+    std::vector<T> _ring;
+    std::size_t    _ring_head = 0UZ;
+    std::size_t    _ring_size = 0UZ;
+    gr::Size_t     _reader_overflows = 0U;
+    int            _reader_error = 0;
+    std::jthread   _reader;
+
+    void readLoop(std::stop_token stop_token) {
+        std::vector<T> chunk(std::max<std::size_t>(1UZ, max_chunk_size));
+        while (!stop_token.stop_requested()) {
+            int       flags = 0;
+            long long time_ns = 0;
+            void*     buffers[1] = {chunk.data()};
+            const int ret = _dev->readStream(_stream, buffers, chunk.size(), flags, time_ns, stream_timeout_us);
+            if (ret == 0 || ret == SOAPY_SDR_TIMEOUT) {
+                continue;
+            }
+
+            {
+                std::lock_guard lock(_reader_mutex);
+                if (ret == SOAPY_SDR_OVERFLOW) {
+                    ++_reader_overflows;
+                    continue;
+                }
+                if (ret < 0) {
+                    _reader_error = ret;
+                } else {
+                    const std::size_t n = static_cast<std::size_t>(ret);
+                    if (_ring_size + n > _ring.size()) { // the graph fell behind: drop the block like a device overflow
+                        ++_reader_overflows;
+                        continue;
+                    }
+                    for (std::size_t i = 0UZ; i < n; ++i) {
+                        _ring[(_ring_head + _ring_size + i) % _ring.size()] = chunk[i];
+                    }
+                    _ring_size += n;
+                }
+            }
+            gr::incubator::scheduler::IoWakeup::notify(); // a parked scheduler runs the block now instead of after its park timeout
+            if (ret < 0) {
+                return;
+            }
+        }
+    }
+
+    [[nodiscard]] gr::work::Status drainReader(OutputSpanLike auto& output, std::size_t max_samples) {
+        std::size_t n = 0UZ;
+        gr::Size_t  overflows = 0U;
+        int         error = 0;
+        {
+            std::lock_guard lock(_reader_mutex);
+            n = std::min(max_samples, _ring_size);
+            for (std::size_t i = 0UZ; i < n; ++i) {
+                output[i] = _ring[(_ring_head + i) % _ring.size()];
+            }
+            _ring_head = (_ring_head + n) % _ring.size();
+            _ring_size -= n;
+            overflows = std::exchange(_reader_overflows, 0U);
+            error = _reader_error;
+        }
+
+        output.publish(n);
+        if (error != 0) {
+            throw gr::exception(std::format("SoapySDR readStream error {} ({})", error, SoapySDR_errToStr(error)));
+        }
+        if (overflows > 0U) {
+            _overflow_count += overflows;
+            if (max_overflow_count > 0 && _overflow_count > max_overflow_count) {
+                throw gr::exception(std::format("SoapySDR overflow exceeded max_overflow_count={} for device '{}'", max_overflow_count, device));
+            }
+        } else if (n > 0UZ) {
+            _overflow_count = 0U;
+        }
+        return n > 0UZ ? gr::work::Status::OK : gr::work::Status::INSUFFICIENT_INPUT_ITEMS; // starved: let the scheduler back off
+    }
+
+    void startReader() {
+        _ring.assign(kReaderChunks * std::max<std::size_t>(1UZ, max_chunk_size), T{});
+        _ring_head = 0UZ;
+        _ring_size = 0UZ;
+        _reader_overflows = 0U;
+        _reader_error = 0;
+        _reader = std::jthread([this](std::stop_token stop_token) { readLoop(stop_token); });
+    }
+
+    void stopReader() {
+        if (_reader.joinable()) {
+            _reader.request_stop();
+            _reader.join(); // returns within stream_timeout_us
+        }
+    }
+
     static constexpr const char* soapyFormat() {
         if constexpr (std::is_same_v<T, std::complex<float>>) {
             return SOAPY_SDR_CF32;
@@ -230,9 +337,13 @@ private:
         }
 
         _dev->activateStream(_stream);
+        if (async_io) {
+            startReader();
+        }
     }
 
     void closeDevice() {
+        stopReader();
         if (_dev && _stream) {
             _dev->deactivateStream(_stream, 0, 0);
             _dev->closeStream(_stream);
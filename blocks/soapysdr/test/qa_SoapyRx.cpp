@@ -0,0 +1,116 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gnuradio-4.0/Graph.hpp>
+#include <gnuradio-4.0/Scheduler.hpp>
+#include <gnuradio-4.0/soapysdr/SoapyRx.hpp>
+
+#include <SoapySDR/Device.hpp>
+#include <SoapySDR/Registry.hpp>
+#include <SoapySDR/Version.hpp>
+
+using namespace boost::ut;
+
+namespace {
+
+constexpr std::size_t kStubSamples = 2048UZ; // fits the async reader ring (8 x max_chunk_size 256): nothing is dropped
+
+std::atomic<std::size_t> gStubDevices{0UZ}; // devices made since the test started
+
+// In-process "gr4stub" driver: streams a float ramp 0, 1, 2, ... of kStubSamples samples, then only times out.
+class StubDevice : public SoapySDR::Device {
+    std::size_t _next = 0UZ;
+
+public:
+    SoapySDR::Stream* setupStream(const int /*direction*/, const std::string& /*format*/, const std::vector<std::size_t>& /*channels*/, const SoapySDR::Kwargs& /*args*/) override { return reinterpret_cast<SoapySDR::Stream*>(this); }
+
+    void closeStream(SoapySDR::Stream* /*stream*/) override {}
+
+    int readStream(SoapySDR::Stream* /*stream*/, void* const* buffs, const std::size_t numElems, int& flags, long long& timeNs, const long timeoutUs = 100000) override {
+        flags  = 0;
+        timeNs = 0;
+        const std::size_t n = std::min(numElems, kStubSamples - _next);
+        if (n == 0UZ) {
+            std::this_thread::sleep_for(std::chrono::microseconds(timeoutUs));
+            return SOAPY_SDR_TIMEOUT;
+        }
+        auto* out = static_cast<float*>(buffs[0]);
+        for (std::size_t i = 0UZ; i < n; ++i) {
+            out[i] = static_cast<float>(_next + i);
+        }
+        _next += n;
+        return static_cast<int>(n);
+    }
+};
+
+const SoapySDR::Registry registerStub("gr4stub", [](const SoapySDR::Kwargs&) { return SoapySDR::KwargsList{{{"driver", "gr4stub"}}}; },
+    [](const SoapySDR::Kwargs&) -> SoapySDR::Device* {
+        ++gStubDevices;
+        return new StubDevice();
+    },
+    SOAPY_SDR_ABI_VERSION);
+
+template<typename T>
+struct RampSink : gr::Block<RampSink<T>> {
+    gr::PortIn<T> in;
+    gr::Size_t    n_samples_max = 0U;
+    gr::Size_t    count         = 0U;
+    gr::Size_t    gaps          = 0U;
+
+    GR_MAKE_REFLECTABLE(RampSink, in, n_samples_max, count, gaps);
+
+    void processOne(T value) {
+        if (value != static_cast<T>(count)) {
+            ++gaps;
+        }
+        if (++count >= n_samples_max) {
+            this->requestStop();
+        }
+    }
+};
+
+} // namespace
+
+const boost::ut::suite<"SoapyRx"> soapyRxTests = [] {
+    "async reader hands the device stream over without gaps"_test = [] {
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::incubator::soapysdr::SoapyRx<float>>(gr::property_map{{"device", std::string("gr4stub")}, {"max_chunk_size", std::uint32_t(256U)}, {"async_io", true}});
+        auto&     sink   = graph.emplaceBlock<RampSink<float>>(gr::property_map{{"n_samples_max", static_cast<gr::Size_t>(kStubSamples)}});
+        expect(graph.connect<"out", "in">(source, sink).has_value()) << fatal;
+
+        gr::scheduler::Simple sched;
+        expect(sched.exchange(std::move(graph)).has_value());
+        expect(sched.runAndWait().has_value());
+
+        expect(eq(sink.count, static_cast<gr::Size_t>(kStubSamples)));
+        expect(eq(sink.gaps, 0U));
+    };
+
+    "max_chunk_size only reopens the device in async_io mode"_test = [] {
+        gr::incubator::soapysdr::SoapyRx<float> rx;
+        rx.device = "gr4stub";
+        rx.start();
+        const std::size_t opened = gStubDevices.load();
+
+        rx.max_chunk_size = 1024U;
+        rx.settingsChanged({}, gr::property_map{{"max_chunk_size", std::uint32_t(1024U)}});
+        expect(eq(gStubDevices.load(), opened)) << "blocking reads take max_chunk_size per call";
+
+        rx.async_io = true;
+        rx.settingsChanged({}, gr::property_map{{"async_io", true}});
+        expect(eq(gStubDevices.load(), opened + 1UZ));
+
+        rx.max_chunk_size = 512U;
+        rx.settingsChanged({}, gr::property_map{{"max_chunk_size", std::uint32_t(512U)}});
+        expect(eq(gStubDevices.load(), opened + 2UZ)) << "the reader ring is sized by max_chunk_size";
+        rx.stop();
+    };
+};
+
+int main() { /* tests are statically executed */ }
@@ -35,17 +35,21 @@ public:
     bool           pass_tags = false;
     int            linger   = 1000;
     int            hwm      = -1;
+    bool           async_io = false;
     std::string    key;
     bool           drop_on_hwm = true;
 
     detail::ZmqSocketTransport _transport{zmq::socket_type::pub};
 
-    GR_MAKE_REFLECTABLE(ZmqPubSink, in, endpoint, timeout, bind, pass_tags, linger, hwm, key, drop_on_hwm);
+    GR_MAKE_REFLECTABLE(ZmqPubSink, in, endpoint, timeout, bind, pass_tags, linger, hwm, key, drop_on_hwm, async_io);
 
     void start() {
         _transport.open(endpoint, bind, linger, hwm, true);
         const int no_drop = drop_on_hwm ? 0 : 1;
         _transport.socket().set(zmq::sockopt::xpub_nodrop, no_drop);
+        if (async_io) {
+            _transport.enable_async(hwm);
+        }
     }
 
     [[nodiscard]] std::string last_endpoint() const { return _transport.last_endpoint(); }
@@ -61,7 +65,6 @@ public:
         }
 
         std::size_t consumed = 0;
-        auto&       socket = _transport.socket();
         const auto tags = pass_tags ? detail::collect_tag_records(inData) : std::vector<detail::ZmqTagHeaderRecord>{};
         const auto header = pass_tags ? detail::serialize_tag_header(0, tags) : std::vector<std::uint8_t>{};
 
@@ -69,11 +72,11 @@ public:
             if (!key.empty()) {
                 zmq::message_t key_message(key.size());
                 std::memcpy(key_message.data(), key.data(), key.size());
-                if (!socket.send(key_message, zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+                if (!_transport.send(key_message, zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
                     return false;
                 }
             }
-            return bool(socket.send(payload, zmq::send_flags::dontwait));
+            return bool(_transport.send(payload, zmq::send_flags::dontwait));
         };
 
         if constexpr (is_vector_of_arithmetic_or_complex_v<T>) {
@@ -36,16 +36,20 @@ public:
     bool           pass_tags = false;
     int            linger   = 1000;
     int            hwm      = -1;
+    bool           async_io = false;
 
     detail::ZmqSocketTransport _transport{zmq::socket_type::pull};
 
     [[maybe_unused]] std::vector<T> _pending_items;
     [[maybe_unused]] std::vector<detail::ZmqTagHeaderRecord> _pending_tags;
 
-    GR_MAKE_REFLECTABLE(ZmqPullSource, out, endpoint, timeout, bind, pass_tags, linger, hwm);
+    GR_MAKE_REFLECTABLE(ZmqPullSource, out, endpoint, timeout, bind, pass_tags, linger, hwm, async_io);
 
     void start() {
         _transport.open(endpoint, bind, linger, hwm, false);
+        if (async_io) {
+            _transport.enable_async(hwm);
+        }
     }
 
     [[nodiscard]] std::string last_endpoint() const { return _transport.last_endpoint(); }
@@ -84,7 +88,7 @@ public:
                 if (_transport.wait_readable(timeout)) {
                     // Receive data
                     zmq::message_t              msg;
-                    [[maybe_unused]] const bool ok = bool(_transport.socket().recv(msg));
+                    [[maybe_unused]] const bool ok = bool(_transport.recv(msg));
                     std::uint64_t header_offset = 0;
                     std::vector<detail::ZmqTagHeaderRecord> tags;
                     std::size_t consumed_bytes = 0;
@@ -143,7 +147,7 @@ public:
                 if (_transport.wait_readable(timeout)) {
                     // Receive data
                     zmq::message_t              msg;
-                    [[maybe_unused]] const bool ok = bool(_transport.socket().recv(msg));
+                    [[maybe_unused]] const bool ok = bool(_transport.recv(msg));
                     std::uint64_t header_offset = 0;
                     std::vector<detail::ZmqTagHeaderRecord> tags;
                     std::size_t consumed_bytes = 0;
@@ -194,7 +198,7 @@ public:
                 if (_transport.wait_readable(timeout)) {
                 try {
                     zmq::message_t msg;
-                    [[maybe_unused]] const bool ok = bool(_transport.socket().recv(msg));
+                    [[maybe_unused]] const bool ok = bool(_transport.recv(msg));
                     std::uint64_t header_offset = 0;
                     std::vector<detail::ZmqTagHeaderRecord> tags;
                     std::size_t consumed_bytes = 0;
@@ -224,7 +228,9 @@ public:
         }
 
         outputSpan.publish(npublished);
-
+        if (npublished == 0 && _transport.is_async()) {
+            return gr::work::Status::INSUFFICIENT_INPUT_ITEMS; // nothing arrived yet: let the scheduler back off
+        }
         return gr::work::Status::OK;
     }
 };
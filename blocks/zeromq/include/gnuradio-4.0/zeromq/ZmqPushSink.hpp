@@ -36,13 +36,17 @@ public:
     bool           pass_tags = false;
     int            linger   = 1000;
     int            hwm      = -1;
+    bool           async_io = false;
 
     detail::ZmqSocketTransport _transport{zmq::socket_type::push};
 
-    GR_MAKE_REFLECTABLE(ZmqPushSink, in, endpoint, timeout, bind, pass_tags, linger, hwm);
+    GR_MAKE_REFLECTABLE(ZmqPushSink, in, endpoint, timeout, bind, pass_tags, linger, hwm, async_io);
 
     void start() {
         _transport.open(endpoint, bind, linger, hwm, true);
+        if (async_io) {
+            _transport.enable_async(hwm);
+        }
     }
 
     [[nodiscard]] std::string last_endpoint() const { return _transport.last_endpoint(); }
@@ -71,7 +75,7 @@ public:
                     std::memcpy(zmsg.data(), header.data(), header.size());
                 }
                 std::memcpy(static_cast<std::uint8_t*>(zmsg.data()) + header.size(), a.data(), size_in_bytes);
-                if (!_transport.socket().send(zmsg, zmq::send_flags::dontwait)) {
+                if (!_transport.send(zmsg, zmq::send_flags::dontwait)) {
                     break;
                 }
                 ++consumed;
@@ -83,7 +87,7 @@ public:
                 std::memcpy(zmsg.data(), header.data(), header.size());
             }
             std::memcpy(static_cast<std::uint8_t*>(zmsg.data()) + header.size(), inData.data(), size_in_bytes);
-            if (_transport.socket().send(zmsg, zmq::send_flags::dontwait)) {
+            if (_transport.send(zmsg, zmq::send_flags::dontwait)) {
                 consumed = inData.size();
             }
         } else if constexpr(std::is_same_v<T, gr::pmt::Value>) {
@@ -96,7 +100,7 @@ public:
                     std::memcpy(zmsg.data(), header.data(), header.size());
                 }
                 std::memcpy(static_cast<std::uint8_t*>(zmsg.data()) + header.size(), serialized.data(), serialized.size());
-                if (!_transport.socket().send(zmsg, zmq::send_flags::dontwait)) {
+                if (!_transport.send(zmsg, zmq::send_flags::dontwait)) {
                     break;
                 }
                 ++consumed;
@@ -35,16 +35,20 @@ public:
     bool           pass_tags = false;
     int            linger   = 1000;
     int            hwm      = -1;
+    bool           async_io = false;
 
     detail::ZmqSocketTransport _transport{zmq::socket_type::rep};
 
     [[maybe_unused]] std::vector<T>                            _pending_items;
     [[maybe_unused]] std::vector<detail::ZmqTagHeaderRecord> _pending_tags;
 
-    GR_MAKE_REFLECTABLE(ZmqRepSink, in, endpoint, timeout, bind, pass_tags, linger, hwm);
+    GR_MAKE_REFLECTABLE(ZmqRepSink, in, endpoint, timeout, bind, pass_tags, linger, hwm, async_io);
 
     void start() {
         _transport.open(endpoint, bind, linger, hwm, true);
+        if (async_io) {
+            _transport.enable_async(hwm);
+        }
     }
 
     [[nodiscard]] std::string last_endpoint() const { return _transport.last_endpoint(); }
@@ -104,7 +108,7 @@ public:
                 }
 
                 zmq::message_t request;
-                if (!bool(_transport.socket().recv(request))) {
+                if (!bool(_transport.recv(request))) {
                     break;
                 }
 
@@ -121,7 +125,7 @@ public:
                     std::memcpy(reply.data(), header.data(), header.size());
                 }
                 std::memcpy(static_cast<std::uint8_t*>(reply.data()) + header.size(), _pending_items.data(), nsend * sizeof(T));
-                if (!bool(_transport.socket().send(reply, zmq::send_flags::dontwait))) {
+                if (!bool(_transport.send(reply, zmq::send_flags::dontwait))) {
                     break;
                 }
                 _pending_items.erase(_pending_items.begin(), _pending_items.begin() + static_cast<std::ptrdiff_t>(nsend));
@@ -133,7 +137,7 @@ public:
                 }
 
                 zmq::message_t request;
-                if (!bool(_transport.socket().recv(request))) {
+                if (!bool(_transport.recv(request))) {
                     break;
                 }
 
@@ -147,7 +151,7 @@ public:
                 if (!vec.empty()) {
                     std::memcpy(static_cast<std::uint8_t*>(reply.data()) + header.size(), vec.data(), vec.size() * sizeof(typename T::value_type));
                 }
-                if (!bool(_transport.socket().send(reply, zmq::send_flags::dontwait))) {
+                if (!bool(_transport.send(reply, zmq::send_flags::dontwait))) {
                     break;
                 }
                 _pending_items.erase(_pending_items.begin());
@@ -159,7 +163,7 @@ public:
                 }
 
                 zmq::message_t request;
-                if (!bool(_transport.socket().recv(request))) {
+                if (!bool(_transport.recv(request))) {
                     break;
                 }
 
@@ -173,7 +177,7 @@ public:
                 if (!serialized.empty()) {
                     std::memcpy(static_cast<std::uint8_t*>(reply.data()) + header.size(), serialized.data(), serialized.size());
                 }
-                if (!bool(_transport.socket().send(reply, zmq::send_flags::dontwait))) {
+                if (!bool(_transport.send(reply, zmq::send_flags::dontwait))) {
                     break;
                 }
                 _pending_items.erase(_pending_items.begin());
@@ -36,6 +36,7 @@ public:
     bool           pass_tags = false;
     int            linger   = 1000;
     int            hwm      = -1;
+    bool           async_io = false;
 
     detail::ZmqSocketTransport _transport{zmq::socket_type::req};
 
@@ -43,10 +44,13 @@ public:
     [[maybe_unused]] std::vector<detail::ZmqTagHeaderRecord> _pending_tags;
     bool                                                      _req_pending = false;
 
-    GR_MAKE_REFLECTABLE(ZmqReqSource, out, endpoint, timeout, bind, pass_tags, linger, hwm);
+    GR_MAKE_REFLECTABLE(ZmqReqSource, out, endpoint, timeout, bind, pass_tags, linger, hwm, async_io);
 
     void start() {
         _transport.open(endpoint, bind, linger, hwm, false);
+        if (async_io) {
+            _transport.enable_async(hwm);
+        }
     }
 
     [[nodiscard]] std::string last_endpoint() const { return _transport.last_endpoint(); }
@@ -99,7 +103,7 @@ public:
                     const uint32_t request_size = static_cast<uint32_t>(request_count_for(nProcessOut - npublished));
                     zmq::message_t  request(sizeof(request_size));
                     std::memcpy(request.data(), &request_size, sizeof(request_size));
-                    if (!_transport.socket().send(request, zmq::send_flags::dontwait)) {
+                    if (!_transport.send(request, zmq::send_flags::dontwait)) {
                         break;
                     }
                     _req_pending = true;
@@ -110,7 +114,7 @@ public:
                 }
 
                 zmq::message_t msg;
-                if (!bool(_transport.socket().recv(msg))) {
+                if (!bool(_transport.recv(msg))) {
                     break;
                 }
                 _req_pending = false;
@@ -156,7 +160,7 @@ public:
                     const uint32_t request_size = static_cast<uint32_t>(request_count_for(nProcessOut - npublished));
                     zmq::message_t  request(sizeof(request_size));
                     std::memcpy(request.data(), &request_size, sizeof(request_size));
-                    if (!_transport.socket().send(request, zmq::send_flags::dontwait)) {
+                    if (!_transport.send(request, zmq::send_flags::dontwait)) {
                         break;
                     }
                     _req_pending = true;
@@ -167,7 +171,7 @@ public:
                 }
 
                 zmq::message_t msg;
-                if (!bool(_transport.socket().recv(msg))) {
+                if (!bool(_transport.recv(msg))) {
                     break;
                 }
                 _req_pending = false;
@@ -210,7 +214,7 @@ public:
                     const uint32_t request_size = 1;
                     zmq::message_t  request(sizeof(request_size));
                     std::memcpy(request.data(), &request_size, sizeof(request_size));
-                    if (!_transport.socket().send(request, zmq::send_flags::dontwait)) {
+                    if (!_transport.send(request, zmq::send_flags::dontwait)) {
                         break;
                     }
                     _req_pending = true;
@@ -221,7 +225,7 @@ public:
                 }
 
                 zmq::message_t msg;
-                if (!bool(_transport.socket().recv(msg))) {
+                if (!bool(_transport.recv(msg))) {
                     break;
                 }
                 _req_pending = false;
@@ -252,6 +256,9 @@ public:
         }
 
         outputSpan.publish(npublished);
+        if (npublished == 0 && _transport.is_async()) {
+            return gr::work::Status::INSUFFICIENT_INPUT_ITEMS; // nothing arrived yet: let the scheduler back off
+        }
         return gr::work::Status::OK;
     }
 };
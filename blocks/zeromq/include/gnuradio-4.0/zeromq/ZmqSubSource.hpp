@@ -35,6 +35,7 @@ public:
     bool           pass_tags = false;
     int            linger   = 1000;
     int            hwm      = -1;
+    bool           async_io = false;
     std::string    key;
 
     detail::ZmqSocketTransport _transport{zmq::socket_type::sub};
@@ -42,11 +43,14 @@ public:
     [[maybe_unused]] std::vector<T>                            _pending_items;
     [[maybe_unused]] std::vector<detail::ZmqTagHeaderRecord> _pending_tags;
 
-    GR_MAKE_REFLECTABLE(ZmqSubSource, out, endpoint, timeout, bind, pass_tags, linger, hwm, key);
+    GR_MAKE_REFLECTABLE(ZmqSubSource, out, endpoint, timeout, bind, pass_tags, linger, hwm, key, async_io);
 
     void start() {
         _transport.open(endpoint, bind, linger, hwm, false);
         _transport.socket().set(zmq::sockopt::subscribe, key);
+        if (async_io) {
+            _transport.enable_async(hwm);
+        }
     }
 
     [[nodiscard]] std::string last_endpoint() const { return _transport.last_endpoint(); }
@@ -76,14 +80,14 @@ public:
                 }
 
                 zmq::message_t msg;
-                [[maybe_unused]] const bool ok = bool(_transport.socket().recv(msg));
+                [[maybe_unused]] const bool ok = bool(_transport.recv(msg));
                 if (!ok) {
                     break;
                 }
 
-                if (_transport.socket().get(zmq::sockopt::rcvmore)) {
+                if (_transport.rcvmore()) {
                     zmq::message_t payload;
-                    [[maybe_unused]] const bool payload_ok = bool(_transport.socket().recv(payload));
+                    [[maybe_unused]] const bool payload_ok = bool(_transport.recv(payload));
                     if (!payload_ok) {
                         break;
                     }
@@ -161,14 +165,14 @@ public:
                 }
 
                 zmq::message_t msg;
-                [[maybe_unused]] const bool ok = bool(_transport.socket().recv(msg));
+                [[maybe_unused]] const bool ok = bool(_transport.recv(msg));
                 if (!ok) {
                     break;
                 }
 
-                if (_transport.socket().get(zmq::sockopt::rcvmore)) {
+                if (_transport.rcvmore()) {
                     zmq::message_t payload;
-                    [[maybe_unused]] const bool payload_ok = bool(_transport.socket().recv(payload));
+                    [[maybe_unused]] const bool payload_ok = bool(_transport.recv(payload));
                     if (!payload_ok) {
                         break;
                     }
@@ -245,14 +249,14 @@ public:
 
                 try {
                     zmq::message_t msg;
-                    [[maybe_unused]] const bool ok = bool(_transport.socket().recv(msg));
+                    [[maybe_unused]] const bool ok = bool(_transport.recv(msg));
                     if (!ok) {
                         break;
                     }
 
-                    if (_transport.socket().get(zmq::sockopt::rcvmore)) {
+                    if (_transport.rcvmore()) {
                         zmq::message_t payload;
-                        [[maybe_unused]] const bool payload_ok = bool(_transport.socket().recv(payload));
+                        [[maybe_unused]] const bool payload_ok = bool(_transport.recv(payload));
                         if (!payload_ok) {
                             break;
                         }
@@ -301,6 +305,9 @@ public:
         }
 
         outputSpan.publish(npublished);
+        if (npublished == 0 && _transport.is_async()) {
+            return gr::work::Status::INSUFFICIENT_INPUT_ITEMS; // nothing arrived yet: let the scheduler back off
+        }
         return gr::work::Status::OK;
     }
 };
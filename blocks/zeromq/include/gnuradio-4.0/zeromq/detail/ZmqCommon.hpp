@@ -1,18 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <utility>
 
 #include <zmq.hpp>
 
+#include <gnuradio-4.0/zeromq/detail/ZmqReactor.hpp>
+
 namespace gr::incubator::zeromq::detail {
 
 class ZmqSocketTransport {
 public:
-    explicit ZmqSocketTransport(zmq::socket_type type) : _socket(_context, type) {}
+    explicit ZmqSocketTransport(zmq::socket_type type) : _socket(_context, type), _type(type) {}
 
     ZmqSocketTransport(const ZmqSocketTransport&) = delete;
     ZmqSocketTransport& operator=(const ZmqSocketTransport&) = delete;
@@ -32,18 +38,68 @@ public:
         }
     }
 
+    // Hands the socket to the shared reactor thread. Afterwards the wait_*() calls no longer block: they report whether
+    // the reactor already received a message or has room to queue one. Each queue holds up to `hwm` messages (1000 if
+    // unset).
+    void enable_async(int hwm) {
+        if (_async) {
+            return;
+        }
+        const std::size_t capacity = hwm > 0 ? static_cast<std::size_t>(hwm) : std::size_t{1000};
+        _async                     = std::make_shared<ZmqAsyncSocket>(_socket, capacity, _type == zmq::socket_type::rep);
+        ZmqReactor::instance().add(_async);
+    }
+
+    [[nodiscard]] bool is_async() const noexcept { return _async != nullptr; }
+
     [[nodiscard]] bool wait_readable(int timeout_ms) {
+        if (_async) {
+            return _async->readable();
+        }
         zmq::pollitem_t items[] = {{static_cast<void*>(_socket), 0, ZMQ_POLLIN, 0}};
         zmq::poll(&items[0], 1, std::chrono::milliseconds{timeout_ms});
         return (items[0].revents & ZMQ_POLLIN) != 0;
     }
 
     [[nodiscard]] bool wait_writable(int timeout_ms) {
+        if (_async) {
+            return _async->writable();
+        }
         zmq::pollitem_t items[] = {{static_cast<void*>(_socket), 0, ZMQ_POLLOUT, 0}};
         zmq::poll(&items[0], 1, std::chrono::milliseconds{timeout_ms});
         return (items[0].revents & ZMQ_POLLOUT) != 0;
     }
 
+    // Receives the next frame; rcvmore() then tells whether more frames of the same message follow.
+    [[nodiscard]] bool recv(zmq::message_t& msg) {
+        if (_async) {
+            auto frame = _async->pop();
+            if (!frame) {
+                return false;
+            }
+            msg        = std::move(frame->data);
+            _last_more = frame->more;
+            return true;
+        }
+        const bool received = static_cast<bool>(_socket.recv(msg));
+        _last_more          = received && _socket.get(zmq::sockopt::rcvmore);
+        return received;
+    }
+
+    [[nodiscard]] bool rcvmore() const noexcept { return _last_more; }
+
+    // In async mode the message is queued for the reactor thread; false if the queue is full.
+    [[nodiscard]] bool send(zmq::message_t& msg, zmq::send_flags flags = zmq::send_flags::none) {
+        if (_async) {
+            if (!_async->push(std::move(msg), (static_cast<int>(flags) & ZMQ_SNDMORE) != 0)) {
+                return false;
+            }
+            ZmqReactor::instance().wake();
+            return true;
+        }
+        return static_cast<bool>(_socket.send(msg, flags));
+    }
+
     [[nodiscard]] std::string last_endpoint() const { return _socket.get(zmq::sockopt::last_endpoint); }
 
     [[nodiscard]] zmq::socket_t& socket() { return _socket; }
@@ -67,6 +123,15 @@ public:
             return;
         }
 
+        if (_async) { // the reactor must let go of the socket before it is closed
+            try {
+                flush_outbox();
+                ZmqReactor::instance().remove(_async);
+            } catch (...) {
+            }
+            _async.reset();
+        }
+
         try {
             if constexpr (requires(zmq::context_t& ctx) { ctx.shutdown(); }) {
                 _context.shutdown();
@@ -85,6 +150,16 @@ public:
 private:
     void set_linger(int linger) {
         _socket.set(zmq::sockopt::linger, linger);
+        _linger_ms = linger;
+    }
+
+    // Gives the reactor up to the socket's linger period (forever if negative, like ZMQ) to send what the block queued.
+    void flush_outbox() {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{std::max(_linger_ms, 0)};
+        while (_async->queued() != 0 && (_linger_ms < 0 || std::chrono::steady_clock::now() < deadline)) {
+            ZmqReactor::instance().wake();
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
     }
 
     void set_hwm(int hwm, bool sink) {
@@ -98,9 +173,13 @@ private:
         }
     }
 
-    zmq::context_t _context{1};
-    zmq::socket_t   _socket;
-    bool            _closed = false;
+    zmq::context_t                  _context{1};
+    zmq::socket_t                   _socket;
+    zmq::socket_type                _type;
+    std::shared_ptr<ZmqAsyncSocket> _async;
+    int                             _linger_ms = 0;
+    bool                            _last_more = false;
+    bool                            _closed    = false;
 };
 
 } // namespace gr::incubator::zeromq::detail
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <zmq.hpp>
+
+#include <gnuradio-4.0/scheduler/IoWakeup.hpp>
+
+namespace gr::incubator::zeromq::detail {
+
+struct ZmqFrame {
+    zmq::message_t data;
+    bool           more = false;
+};
+
+// Socket state shared between a block (running on any scheduler worker) and the reactor thread. Once registered, only
+// the reactor thread touches the socket; the block exchanges complete messages through the inbox and outbox.
+class ZmqAsyncSocket {
+public:
+    ZmqAsyncSocket(zmq::socket_t& socket, std::size_t capacity, bool reply_required) : _socket(&socket), _capacity(std::max<std::size_t>(1, capacity)), _reply_required(reply_required) {}
+
+    // block side, never blocks
+    [[nodiscard]] bool readable() {
+        std::lock_guard lock(_mutex);
+        return !_inbox.empty();
+    }
+
+    [[nodiscard]] bool writable() {
+        std::lock_guard lock(_mutex);
+        return _outbox_messages < _capacity;
+    }
+
+    // Complete messages still waiting for the reactor to send them.
+    [[nodiscard]] std::size_t queued() {
+        std::lock_guard lock(_mutex);
+        return _outbox_messages;
+    }
+
+    [[nodiscard]] std::optional<ZmqFrame> pop() {
+        std::lock_guard lock(_mutex);
+        if (_inbox.empty()) {
+            return std::nullopt;
+        }
+        ZmqFrame frame = std::move(_inbox.front());
+        _inbox.pop_front();
+        if (!frame.more) {
+            --_inbox_messages;
+        }
+        return frame;
+    }
+
+    // Queues a frame; the first frame of a message is refused while the outbox is full.
+    [[nodiscard]] bool push(zmq::message_t&& data, bool more) {
+        std::lock_guard lock(_mutex);
+        const bool      continues_message = !_outbox.empty() && _outbox.back().more;
+        if (!continues_message && _outbox_messages >= _capacity) {
+            return false;
+        }
+        _outbox.push_back({std::move(data), more});
+        if (!more) {
+            ++_outbox_messages;
+        }
+        return true;
+    }
+
+    // reactor side
+    [[nodiscard]] zmq::socket_t& socket() noexcept { return *_socket; }
+
+    [[nodiscard]] short events() {
+        std::lock_guard lock(_mutex);
+        short events = 0;
+        if (_inbox_messages < _capacity && !_awaiting_reply) {
+            events |= ZMQ_POLLIN;
+        }
+        if (_outbox_messages != 0) {
+            events |= ZMQ_POLLOUT;
+        }
+        return events;
+    }
+
+    // Moves all complete messages the socket holds into the inbox, up to the capacity. Returns whether any arrived.
+    bool receive_available() {
+        bool received = false;
+        while (true) {
+            {
+                std::lock_guard lock(_mutex);
+                if (_inbox_messages >= _capacity || _awaiting_reply) {
+                    break;
+                }
+            }
+            zmq::message_t first;
+            if (!_socket->recv(first, zmq::recv_flags::dontwait)) {
+                break;
+            }
+            std::vector<ZmqFrame> frames;
+            bool                  more = _socket->get(zmq::sockopt::rcvmore);
+            frames.push_back({std::move(first), more});
+            while (more) { // remaining parts of a multipart message are delivered atomically with the first one
+                zmq::message_t part;
+                if (!_socket->recv(part, zmq::recv_flags::dontwait)) {
+                    break;
+                }
+                more = _socket->get(zmq::sockopt::rcvmore);
+                frames.push_back({std::move(part), more});
+            }
+            frames.back().more = false;
+
+            std::lock_guard lock(_mutex);
+            for (ZmqFrame& frame : frames) {
+                _inbox.push_back(std::move(frame));
+            }
+            ++_inbox_messages;
+            _awaiting_reply = _reply_required;
+            received        = true;
+        }
+        return received;
+    }
+
+    // Sends queued complete messages until the socket would block; unsent frames stay queued, a partially sent message
+    // continues with its next frame. Returns whether any message was sent completely.
+    bool send_queued() {
+        bool sent_any = false;
+        while (true) {
+            std::vector<ZmqFrame> frames;
+            {
+                std::lock_guard lock(_mutex);
+                if (_outbox_messages == 0) {
+                    return sent_any;
+                }
+                bool more = true;
+                while (more) {
+                    more = _outbox.front().more;
+                    frames.push_back(std::move(_outbox.front()));
+                    _outbox.pop_front();
+                }
+                --_outbox_messages;
+            }
+            std::size_t sent = 0;
+            while (sent < frames.size() && _socket->send(frames[sent].data, frames[sent].more ? zmq::send_flags::sndmore | zmq::send_flags::dontwait : zmq::send_flags::dontwait)) {
+                ++sent;
+            }
+            if (sent != frames.size()) {
+                std::lock_guard lock(_mutex);
+                for (auto frame = frames.rbegin(); frame != frames.rend() - static_cast<std::ptrdiff_t>(sent); ++frame) {
+                    _outbox.push_front(std::move(*frame));
+                }
+                ++_outbox_messages;
+                return sent_any;
+            }
+            sent_any = true;
+            if (_reply_required) {
+                std::lock_guard lock(_mutex);
+                _awaiting_reply = false;
+            }
+        }
+    }
+
+private:
+    zmq::socket_t*       _socket;
+    std::size_t          _capacity;
+    bool                 _reply_required;
+    std::mutex           _mutex;
+    std::deque<ZmqFrame> _inbox;
+    std::deque<ZmqFrame> _outbox;
+    std::size_t          _inbox_messages  = 0;
+    std::size_t          _outbox_messages = 0;
+    bool                 _awaiting_reply  = false; // REP: the next request may only be read after the reply was sent
+};
+
+// Process-wide thread that waits on all registered sockets at once, so ZMQ blocks never block a scheduler worker.
+// Blocks polling an empty inbox report INSUFFICIENT_INPUT_ITEMS and are retried by the scheduler's idle policy; once
+// messages arrive or outbox space frees up, the reactor wakes parked scheduler workers through IoWakeup.
+class ZmqReactor {
+public:
+    static ZmqReactor& instance() {
+        static ZmqReactor reactor;
+        return reactor;
+    }
+
+    ZmqReactor(const ZmqReactor&)            = delete;
+    ZmqReactor& operator=(const ZmqReactor&) = delete;
+
+    ~ZmqReactor() {
+        _thread.request_stop();
+        wake();
+    }
+
+    void add(std::shared_ptr<ZmqAsyncSocket> socket) {
+        {
+            std::lock_guard lock(_registry_mutex);
+            _sockets.push_back(std::move(socket));
+            ++_generation;
+        }
+        wake();
+    }
+
+    // Returns once the reactor thread no longer touches the socket, which may then be closed by its owner.
+    void remove(const std::shared_ptr<ZmqAsyncSocket>& socket) {
+        std::uint64_t generation = 0;
+        {
+            std::lock_guard lock(_registry_mutex);
+            std::erase(_sockets, socket);
+            generation = ++_generation;
+        }
+        wake();
+        if (std::this_thread::get_id() == _thread.get_id()) {
+            return;
+        }
+        std::unique_lock lock(_registry_mutex);
+        _completed.wait(lock, [this, generation] { return _completed_generation >= generation; });
+    }
+
+    // Interrupts the current wait, e.g. after a block queued an outgoing message.
+    void wake() {
+        std::lock_guard lock(_wake_mutex);
+        zmq::message_t  signal(0);
+        std::ignore = _wake_send.send(signal, zmq::send_flags::dontwait);
+    }
+
+private:
+    zmq::context_t                               _context{1};
+    zmq::socket_t                                _wake_receive{_context, zmq::socket_type::pair};
+    zmq::socket_t                                _wake_send{_context, zmq::socket_type::pair};
+    std::mutex                                   _wake_mutex;
+    std::mutex                                   _registry_mutex;
+    std::condition_variable                      _completed;
+    std::vector<std::shared_ptr<ZmqAsyncSocket>> _sockets;
+    std::uint64_t                                _generation           = 0;
+    std::uint64_t                                _completed_generation = 0;
+    std::jthread                                 _thread; // last: stopped before the sockets close
+
+    ZmqReactor() {
+        _wake_receive.bind("inproc://gr4-incubator-zmq-reactor");
+        _wake_send.connect("inproc://gr4-incubator-zmq-reactor");
+        _thread = std::jthread([this](std::stop_token stop_token) { run(stop_token); });
+    }
+
+    void run(std::stop_token stop_token) {
+        std::vector<std::shared_ptr<ZmqAsyncSocket>> snapshot;
+        std::vector<std::shared_ptr<ZmqAsyncSocket>> active;
+        std::vector<zmq::pollitem_t>                 items;
+        while (!stop_token.stop_requested()) {
+            std::uint64_t generation = 0;
+            {
+                std::lock_guard lock(_registry_mutex);
+                generation = _generation;
+                snapshot   = _sockets;
+            }
+            items.assign(1, zmq::pollitem_t{static_cast<void*>(_wake_receive), 0, ZMQ_POLLIN, 0});
+            active.clear();
+            for (const std::shared_ptr<ZmqAsyncSocket>& socket : snapshot) {
+                if (const short events = socket->events(); events != 0) {
+                    items.push_back({static_cast<void*>(socket->socket()), 0, events, 0});
+                    active.push_back(socket);
+                }
+            }
+
+            try {
+                zmq::poll(items.data(), items.size(), std::chrono::milliseconds{100});
+            } catch (const zmq::error_t&) {
+                items.resize(1); // interrupted, rebuild the poll set
+                items[0].revents = 0;
+            }
+            if ((items[0].revents & ZMQ_POLLIN) != 0) {
+                zmq::message_t signal;
+                while (_wake_receive.recv(signal, zmq::recv_flags::dontwait)) {
+                }
+            }
+            bool progressed = false;
+            for (std::size_t i = 1; i < items.size(); ++i) {
+                if ((items[i].revents & ZMQ_POLLOUT) != 0) {
+                    progressed = active[i - 1]->send_queued() || progressed;
+                }
+                if ((items[i].revents & ZMQ_POLLIN) != 0) {
+                    progressed = active[i - 1]->receive_available() || progressed;
+                }
+            }
+            if (progressed) {
+                gr::incubator::scheduler::IoWakeup::notify();
+            }
+            active.clear();
+            snapshot.clear();
+
+            {
+                std::lock_guard lock(_registry_mutex);
+                _completed_generation = generation;
+            }
+            _completed.notify_all();
+        }
+        std::lock_guard lock(_registry_mutex);
+        _completed_generation = _generation;
+        _completed.notify_all();
+    }
+};
+
+} // namespace gr::incubator::zeromq::detail
@@ -32,6 +32,7 @@
 #include <gnuradio-4.0/zeromq/ZmqSubSource.hpp>
 #include <gnuradio-4.0/zeromq/ZmqPullSource.hpp>
 #include <gnuradio-4.0/zeromq/ZmqPushSink.hpp>
+#include <gnuradio-4.0/zeromq/detail/ZmqCommon.hpp>
 #include <gnuradio-4.0/zeromq/detail/ZmqTagHeaders.hpp>
 #include <zmq.hpp>
 
@@ -1687,6 +1688,123 @@ const suite ZmqBlocksTests = [] {
             responder.join();
         }
     };
+
+    "Pull source with async_io receives scalar raw payload"_test = [] {
+        gr::Graph fg;
+        using T = float;
+        constexpr gr::Size_t n_samples = 16;
+        const auto endpoint = endpoint_for(280);
+
+        auto& pull = fg.emplaceBlock<gr::incubator::zeromq::ZmqPullSource<T>>(make_props({
+            {"endpoint", gr::pmt::Value(endpoint)},
+            {"bind", gr::pmt::Value(true)},
+            {"async_io", gr::pmt::Value(true)},
+        }));
+        auto& sink = fg.emplaceBlock<gr::testing::CountingSink<T>>(make_props({
+            {"n_samples_max", gr::pmt::Value(n_samples)},
+        }));
+
+        expect(fg.connect<"out", "in">(pull, sink).has_value());
+
+        auto sender = spawn_push_sender(endpoint, to_bytes(std::vector<T>{1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 14.f, 15.f, 16.f}));
+
+        gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::multiThreaded> sched;
+        expect(sched.exchange(std::move(fg)).has_value());
+        expect(run_until_then_stop(sched, [&] { return sink.count >= n_samples; }, std::chrono::milliseconds(2000)));
+        expect(eq(sink.count, n_samples));
+
+        if (sender.joinable()) {
+            sender.join();
+        }
+    };
+
+    "Push sink with async_io sends scalar stream payload"_test = [] {
+        gr::Graph fg;
+        const auto endpoint = endpoint_for(281);
+        auto receiver = spawn_pull_receiver(endpoint, 1);
+
+        auto& source = fg.emplaceBlock<DelayedCountingSource<float>>(make_props({
+            {"n_samples_max", gr::pmt::Value(static_cast<gr::Size_t>(0))},
+            {"startup_delay_ms", gr::pmt::Value(static_cast<gr::Size_t>(50))},
+        }));
+        auto& push = fg.emplaceBlock<gr::incubator::zeromq::ZmqPushSink<float>>(make_props({
+            {"endpoint", gr::pmt::Value(endpoint)},
+            {"bind", gr::pmt::Value(true)},
+            {"async_io", gr::pmt::Value(true)},
+        }));
+
+        expect(fg.connect<"out", "in">(source, push).has_value());
+
+        gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::multiThreaded> sched;
+        expect(sched.exchange(std::move(fg)).has_value());
+        expect(run_until_then_stop(sched, [&] { return receiver.wait_for(std::chrono::milliseconds{0}) == std::future_status::ready; }, std::chrono::milliseconds(2000)));
+
+        auto messages = receiver.get();
+        expect(eq(messages.size(), static_cast<std::size_t>(1)));
+        if (!messages.empty()) {
+            expect(eq(messages.front().size() % sizeof(float), static_cast<std::size_t>(0)));
+        }
+    };
+
+    "Async transport flushes queued messages on close"_test = [] {
+        constexpr std::size_t n_messages = 16;
+        const auto            endpoint   = endpoint_for(283);
+        std::future<std::vector<std::vector<std::uint8_t>>> receiver;
+        {
+            zdetail::ZmqSocketTransport transport{zmq::socket_type::push};
+            transport.open(endpoint, true, 2000, -1, true);
+            transport.enable_async(-1);
+            for (std::size_t i = 0; i < n_messages; ++i) {
+                const auto     value = static_cast<float>(i);
+                zmq::message_t msg(sizeof(float));
+                std::memcpy(msg.data(), &value, sizeof(float));
+                expect(transport.send(msg));
+            }
+            receiver = spawn_pull_receiver(endpoint, n_messages); // no peer yet: everything is still in the outbox
+        } // close() right after publishing
+
+        auto messages = receiver.get();
+        expect(eq(messages.size(), n_messages));
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            float value = -1.f;
+            std::memcpy(&value, messages[i].data(), sizeof(float));
+            expect(eq(value, static_cast<float>(i)));
+        }
+    };
+
+    "Rep sink with async_io answers each request once"_test = [] {
+        gr::Graph fg;
+        using T = float;
+        const auto endpoint = endpoint_for(282);
+
+        auto& source = fg.emplaceBlock<DelayedCountingSource<T>>(make_props({
+            {"n_samples_max", gr::pmt::Value(static_cast<gr::Size_t>(5))},
+            {"startup_delay_ms", gr::pmt::Value(static_cast<gr::Size_t>(100))},
+        }));
+        auto& rep = fg.emplaceBlock<gr::incubator::zeromq::ZmqRepSink<T>>(make_props({
+            {"endpoint", gr::pmt::Value(endpoint)},
+            {"bind", gr::pmt::Value(true)},
+            {"async_io", gr::pmt::Value(true)},
+        }));
+
+        expect(fg.connect<"out", "in">(source, rep).has_value());
+
+        auto client = spawn_req_client(endpoint, std::vector<uint32_t>{2U, 3U}, std::chrono::milliseconds{10});
+
+        gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::multiThreaded> sched;
+        expect(sched.exchange(std::move(fg)).has_value());
+        expect(run_until_then_stop(sched, [&] { return client.wait_for(std::chrono::milliseconds{0}) == std::future_status::ready; }, std::chrono::milliseconds(3000)));
+
+        auto replies = client.get();
+        expect(eq(replies.size(), static_cast<std::size_t>(2)));
+        if (replies.size() == 2) {
+            expect(eq(replies[0].size(), 2U * sizeof(T)));
+            expect(eq(replies[1].size(), 3U * sizeof(T)));
+            const auto* second = reinterpret_cast<const T*>(replies[1].data());
+            expect(eq(second[0], 3.f));
+            expect(eq(second[2], 5.f));
+        }
+    };
 };
 
 int main() { return boost::ut::cfg<boost::ut::override>.run(); }
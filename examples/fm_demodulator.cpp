@@ -15,8 +15,7 @@
 #include <gnuradio-4.0/analog/QuadratureDemod.hpp>
 #include <gnuradio-4.0/analog/FmDeemphasisFilter.hpp>
 #include <gnuradio-4.0/audio/RtAudioSink.hpp>
-#include <gnuradio-4.0/filter/FirDecimator.hpp>
-#include <gnuradio-4.0/math/Rotator.hpp>
+#include <gnuradio-4.0/filter/FreqXlatingFirDecimator.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResampler.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResamplerTaps.hpp>
 #include <gnuradio-4.0/scheduler/BlockingBackoff.hpp>
@@ -91,16 +90,16 @@ int main(int argc, char** argv) {
     app.add_option("--soapy-driver", soapy_driver, "SoapySDR driver (e.g., rtlsdr)");
     app.add_option("--soapy-args", soapy_args, "SoapySDR device args");
     app.add_option("--soapy-freq", soapy_freq, "SoapySDR center frequency (Hz)");
-    app.add_option("--station-freq", station_freq, "FM station frequency (Hz); sets rotator shift from Soapy center");
+    app.add_option("--station-freq", station_freq, "FM station frequency (Hz); sets the channel filter center relative to the Soapy center");
     app.add_option("--frequency-shift", frequency_shift, "Explicit frequency shift for file/ZMQ or when --station-freq is omitted (Hz)");
     app.add_option("--soapy-bw", soapy_bw, "SoapySDR bandwidth (Hz)");
     app.add_option("--soapy-gain", soapy_gain, "SoapySDR gain (dB)");
     app.add_option("--soapy-antenna", soapy_antenna, "SoapySDR antenna name");
     app.add_option("--soapy-channel", soapy_channel, "SoapySDR RX channel index");
     app.add_option("--channel-decim", channel_decim, "RF channel decimation factor (0 = round RF rate / quad rate)");
-    app.add_option("--channel-cutoff", channel_cutoff, "FirDecimator low-pass cutoff frequency (Hz)");
-    app.add_option("--channel-transition", channel_transition, "FirDecimator transition width (Hz)");
-    app.add_option("--channel-attenuation", channel_attenuation, "FirDecimator stop-band attenuation (dB)");
+    app.add_option("--channel-cutoff", channel_cutoff, "Channel filter low-pass cutoff frequency (Hz)");
+    app.add_option("--channel-transition", channel_transition, "Channel filter transition width (Hz)");
+    app.add_option("--channel-attenuation", channel_attenuation, "Channel filter stop-band attenuation (dB)");
     app.add_option("--audio-frames-per-buf", audio_frames_per_buf, "RtAudio frames per buffer (0 = default)");
     app.add_option("--audio-latency", audio_latency_s, "RtAudio target latency seconds (0 = default)");
     app.add_option("--audio-api", audio_api, "RtAudio API: default|alsa|pulse|jack|oss|dummy");
@@ -126,13 +125,9 @@ int main(int argc, char** argv) {
     double max_dev = 75e3;
     double fm_demod_gain = quad_rate / (2 * M_PI * max_dev);
 
-    auto& rotator = fg.emplaceBlock<gr::blocks::math::Rotator<T>>(make_props({
-        {"sample_rate", gr::pmt::Value(static_cast<float>(rf_sample_rate))},
-        {"frequency_shift", gr::pmt::Value(static_cast<float>(effective_frequency_shift))},
-    }));
-
-    auto& channel_decimator = fg.emplaceBlock<gr::incubator::filter::FirDecimator<T>>(make_props({
+    auto& channel_decimator = fg.emplaceBlock<gr::incubator::filter::FreqXlatingFirDecimator<T>>(make_props({
         {"decim", gr::pmt::Value(effective_channel_decim)},
+        {"center_frequency", gr::pmt::Value(static_cast<float>(-effective_frequency_shift))},
         {"f_low", gr::pmt::Value(static_cast<float>(channel_cutoff))},
         {"sample_rate", gr::pmt::Value(static_cast<float>(rf_sample_rate))},
         {"transition_width", gr::pmt::Value(static_cast<float>(channel_transition))},
@@ -189,7 +184,7 @@ int main(int argc, char** argv) {
             {"repeat", gr::pmt::Value(repeat_file)},
             {"disconnect_on_done", gr::pmt::Value(true)},
         }));
-        if (auto conn = fg.connect<"out", "in">(source, rotator); !conn) {
+        if (auto conn = fg.connect<"out", "in">(source, channel_decimator); !conn) {
             throw gr::exception(std::format("connect failed: {}", conn.error().message));
         }
     } else if (source_type == "zmq") {
@@ -198,7 +193,7 @@ int main(int argc, char** argv) {
             {"timeout", gr::pmt::Value(zmq_timeout)},
             {"bind", gr::pmt::Value(zmq_bind)},
         }));
-        if (auto conn = fg.connect<"out", "in">(source, rotator); !conn) {
+        if (auto conn = fg.connect<"out", "in">(source, channel_decimator); !conn) {
             throw gr::exception(std::format("connect failed: {}", conn.error().message));
         }
     } else if (source_type == "soapy") {
@@ -212,16 +207,13 @@ int main(int argc, char** argv) {
             {"gain", gr::pmt::Value(soapy_gain)},
             {"antenna", gr::pmt::Value(soapy_antenna)},
         }));
-        if (auto conn = fg.connect<"out", "in">(source, rotator); !conn) {
+        if (auto conn = fg.connect<"out", "in">(source, channel_decimator); !conn) {
             throw gr::exception(std::format("connect failed: {}", conn.error().message));
         }
     } else {
         throw std::runtime_error("unknown source type");
     }
 
-    if (auto conn = fg.connect<"out", "in">(rotator, channel_decimator); !conn) {
-        throw gr::exception(std::format("connect failed: {}", conn.error().message));
-    }
     if (auto conn = fg.connect<"out", "in">(channel_decimator, quad_demod); !conn) {
         throw gr::exception(std::format("connect failed: {}", conn.error().message));
     }
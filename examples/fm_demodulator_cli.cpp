@@ -24,9 +24,8 @@
 #include <gnuradio-4.0/analog/QuadratureDemod.hpp>
 #include <gnuradio-4.0/analog/FmDeemphasisFilter.hpp>
 #include <gnuradio-4.0/audio/RtAudioSink.hpp>
-#include <gnuradio-4.0/filter/FirDecimator.hpp>
+#include <gnuradio-4.0/filter/FreqXlatingFirDecimator.hpp>
 #include <gnuradio-4.0/math/Math.hpp>
-#include <gnuradio-4.0/math/Rotator.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResampler.hpp>
 #include <gnuradio-4.0/pfb/PfbArbResamplerTaps.hpp>
 #include <gnuradio-4.0/scheduler/BlockingBackoff.hpp>
@@ -139,7 +138,7 @@ int main(int argc, char** argv) {
     app.add_option("--soapy-driver", soapy_driver, "SoapySDR driver");
     app.add_option("--soapy-args", soapy_args, "SoapySDR device args");
     app.add_option("--soapy-freq", soapy_freq, "SoapySDR center frequency (Hz)");
-    app.add_option("--station-freq", station_freq, "FM station frequency (Hz); sets rotator shift from Soapy center");
+    app.add_option("--station-freq", station_freq, "FM station frequency (Hz); sets the channel filter center relative to the Soapy center");
     app.add_option("--frequency-shift", frequency_shift, "Explicit frequency shift for file input or when --station-freq is omitted (Hz)");
     app.add_option("--soapy-bw", soapy_bw, "SoapySDR bandwidth (Hz)");
     app.add_option("--soapy-gain", soapy_gain, "SoapySDR gain (dB)");
@@ -147,9 +146,9 @@ int main(int argc, char** argv) {
     app.add_option("--soapy-channel", soapy_channel, "SoapySDR RX channel index");
     app.add_flag("--soapy-debug", soapy_debug, "Enable SoapyRx debug logging");
     app.add_option("--channel-decim", channel_decim, "RF channel decimation factor (0 = round RF rate / quad rate)");
-    app.add_option("--channel-cutoff", channel_cutoff, "FirDecimator low-pass cutoff frequency (Hz)");
-    app.add_option("--channel-transition", channel_transition, "FirDecimator transition width (Hz)");
-    app.add_option("--channel-attenuation", channel_attenuation, "FirDecimator stop-band attenuation (dB)");
+    app.add_option("--channel-cutoff", channel_cutoff, "Channel filter low-pass cutoff frequency (Hz)");
+    app.add_option("--channel-transition", channel_transition, "Channel filter transition width (Hz)");
+    app.add_option("--channel-attenuation", channel_attenuation, "Channel filter stop-band attenuation (dB)");
     app.add_option("--volume", volume, "Audio volume scalar (0..1)");
     app.add_option("--audio-api", audio_api, "RtAudio API: default|alsa|pulse|jack|oss|dummy");
     app.add_option("--watchdog-timeout-ms", watchdog_timeout_ms, "Scheduler watchdog timeout (ms, 0 disables)");
@@ -168,13 +167,9 @@ int main(int argc, char** argv) {
     quad_rate = rf_sample_rate / static_cast<double>(effective_channel_decim);
     const auto effective_frequency_shift = station_freq ? soapy_freq - *station_freq : frequency_shift;
 
-    auto& rotator = fg.emplaceBlock<gr::blocks::math::Rotator<T>>(make_props({
-        {"sample_rate", gr::pmt::Value(static_cast<float>(rf_sample_rate))},
-        {"frequency_shift", gr::pmt::Value(static_cast<float>(effective_frequency_shift))},
-    }));
-
-    auto& channel_decimator = fg.emplaceBlock<gr::incubator::filter::FirDecimator<T>>(make_props({
+    auto& channel_decimator = fg.emplaceBlock<gr::incubator::filter::FreqXlatingFirDecimator<T>>(make_props({
         {"decim", gr::pmt::Value(effective_channel_decim)},
+        {"center_frequency", gr::pmt::Value(static_cast<float>(-effective_frequency_shift))},
         {"f_low", gr::pmt::Value(static_cast<float>(channel_cutoff))},
         {"sample_rate", gr::pmt::Value(static_cast<float>(rf_sample_rate))},
         {"transition_width", gr::pmt::Value(static_cast<float>(channel_transition))},
@@ -220,7 +215,7 @@ int main(int argc, char** argv) {
             {"repeat", gr::pmt::Value(true)},
             {"disconnect_on_done", gr::pmt::Value(false)},
         }));
-        if (auto conn = fg.connect<"out", "in">(source, rotator); !conn) {
+        if (auto conn = fg.connect<"out", "in">(source, channel_decimator); !conn) {
             throw gr::exception(std::format("connect failed: {}", conn.error().message));
         }
     } else {
@@ -236,14 +231,11 @@ int main(int argc, char** argv) {
             {"debug", gr::pmt::Value(soapy_debug)},
             {"name", gr::pmt::Value(std::string(kSoapyName))},
         }));
-        if (auto conn = fg.connect<"out", "in">(source, rotator); !conn) {
+        if (auto conn = fg.connect<"out", "in">(source, channel_decimator); !conn) {
             throw gr::exception(std::format("connect failed: {}", conn.error().message));
         }
     }
 
-    if (auto conn = fg.connect<"out", "in">(rotator, channel_decimator); !conn) {
-        throw gr::exception(std::format("connect failed: {}", conn.error().message));
-    }
     if (auto conn = fg.connect<"out", "in">(channel_decimator, quad_demod); !conn) {
         throw gr::exception(std::format("connect failed: {}", conn.error().message));
     }
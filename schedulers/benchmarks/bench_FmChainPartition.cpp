@@ -0,0 +1,153 @@
+// bench_FmChainPartition.cpp — BlockingBackoff job list partitioning on the FM receiver chain
+// Chain: VectorSource → Rotator → FirDecimator(5) → QuadratureDemod → FmDeemphasisFilter → PfbArbResampler → VectorSink
+// Compares the round-robin plan with the traffic-aware plan fed with per-edge bandwidth
+// (samples/s × sizeof(T)) estimates and per-block costs, either estimated from MACs per
+// RF sample or measured (seconds spent in work(), from the telemetry of a calibration run),
+// with and without cache-fitted work() requests (FirDecimator and PfbArbResampler publish
+// working-set hints). Without hints every block costs 1 and every edge weighs 1.
+#include <gnuradio-4.0/Graph.hpp>
+#include <gnuradio-4.0/Scheduler.hpp>
+#include <gnuradio-4.0/analog/FmDeemphasisFilter.hpp>
+#include <gnuradio-4.0/analog/QuadratureDemod.hpp>
+#include <gnuradio-4.0/basic/VectorSink.hpp>
+#include <gnuradio-4.0/basic/VectorSource.hpp>
+#include <gnuradio-4.0/filter/FirDecimator.hpp>
+#include <gnuradio-4.0/math/Rotator.hpp>
+#include <gnuradio-4.0/pfb/PfbArbResampler.hpp>
+#include <gnuradio-4.0/scheduler/BlockingBackoff.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float       kRfRate    = 2'000'000.F;
+constexpr std::size_t kDecim     = 5UZ;
+constexpr float       kQuadRate  = kRfRate / static_cast<float>(kDecim);
+constexpr double      kAudioRate = 32'000.0;
+
+// A benchmark of a graph that did not run measures nothing: report the error and abort.
+template<typename TResult>
+void requireOk(const TResult& result, const char* what) {
+    if (!result) {
+        std::fprintf(stderr, "%s failed: %s\n", what, std::format("{}", result.error()).c_str());
+        std::abort();
+    }
+}
+
+void requireConnected(gr::ConnectionResult result) {
+    if (result != gr::ConnectionResult::SUCCESS) {
+        std::fputs("connecting the chain failed\n", stderr);
+        std::abort();
+    }
+}
+
+void setEntry(gr::property_map& map, std::string_view key, double value) { map.insert_or_assign(std::pmr::string(key.data(), key.size()), gr::pmt::Value(value)); }
+
+// Runs the chain once and returns the seconds each block spent in work(), in chain order. `measuredCosts` (same order)
+// replaces the MAC estimates as block_costs if given.
+std::vector<double> runChain(const char* config, const std::vector<std::complex<float>>& input, const std::string& strategy, bool withHints, gr::Size_t cacheLevel = 0U, const std::vector<double>& measuredCosts = {}) {
+    using C = std::complex<float>;
+
+    gr::Graph graph;
+    auto&     src       = graph.emplaceBlock<gr::incubator::basic::VectorSource<C>>({{"data", input}});
+    auto&     rotator   = graph.emplaceBlock<gr::blocks::math::Rotator<C>>(gr::property_map{{"sample_rate", kRfRate}, {"frequency_shift", 250'000.F}});
+    auto&     decimator = graph.emplaceBlock<gr::incubator::filter::FirDecimator<C>>(gr::property_map{{"decim", static_cast<uint32_t>(kDecim)}, {"sample_rate", kRfRate}, {"f_low", 120'000.F}, {"transition_width", 60'000.F}, {"attenuation_db", 60.F}});
+    auto&     demod     = graph.emplaceBlock<gr::incubator::analog::QuadratureDemod<float>>(gr::property_map{{"gain", static_cast<double>(kQuadRate) / (2.0 * M_PI * 75'000.0)}});
+    auto&     deemph    = graph.emplaceBlock<gr::incubator::analog::FmDeemphasisFilter<float>>(gr::property_map{{"sample_rate", kQuadRate}, {"tau", 75e-6F}});
+    auto&     resampler = graph.emplaceBlock<gr::incubator::pfb::PfbArbResampler<float>>(gr::property_map{{"rate", kAudioRate / static_cast<double>(kQuadRate)}, {"stop_band_attenuation", 80.0}});
+    auto&     sink      = graph.emplaceBlock<gr::incubator::basic::VectorSink<float>>({});
+
+    requireConnected(graph.connect<"out">(src).to<"in">(rotator));
+    requireConnected(graph.connect<"out">(rotator).to<"in">(decimator));
+    requireConnected(graph.connect<"out">(decimator).to<"in">(demod));
+    requireConnected(graph.connect<"out">(demod).to<"in">(deemph));
+    requireConnected(graph.connect<"out">(deemph).to<"in">(resampler));
+    requireConnected(graph.connect<"out">(resampler).to<"in">(sink));
+
+    const std::vector<std::string> names{src.unique_name, rotator.unique_name, decimator.unique_name, demod.unique_name, deemph.unique_name, resampler.unique_name, sink.unique_name};
+
+    gr::incubator::scheduler::BlockingBackoff<> sched;
+    sched.partition_strategy = strategy;
+    sched.chunk_cache_level  = cacheLevel;
+    sched.enable_telemetry   = true;
+    if (withHints) {
+        // rough MACs per RF input sample; FirDecimator dominates with ~100 taps per retained output
+        std::vector<double> costs{0.5, 4.0, 2.0 * 100.0 / static_cast<double>(kDecim) * 2.0, 8.0 / static_cast<double>(kDecim), 2.0 / static_cast<double>(kDecim), 2.0, 0.1};
+        if (measuredCosts.size() == costs.size()) {
+            costs = measuredCosts;
+        }
+        gr::property_map costMap;
+        for (std::size_t block = 0UZ; block < names.size(); ++block) {
+            setEntry(costMap, names[block], costs[block]);
+        }
+        sched.block_costs = costMap;
+
+        gr::property_map bandwidth;
+        const auto       edge = [](const auto& from, const auto& to) { return std::format("{}->{}", from.unique_name, to.unique_name); };
+        setEntry(bandwidth, edge(src, rotator), kRfRate * sizeof(C));
+        setEntry(bandwidth, edge(rotator, decimator), kRfRate * sizeof(C));
+        setEntry(bandwidth, edge(decimator, demod), kQuadRate * sizeof(C));
+        setEntry(bandwidth, edge(demod, deemph), kQuadRate * sizeof(float));
+        setEntry(bandwidth, edge(deemph, resampler), kQuadRate * sizeof(float));
+        setEntry(bandwidth, edge(resampler, sink), kAudioRate * sizeof(float));
+        sched.edge_bandwidth = bandwidth;
+    }
+    requireOk(sched.exchange(std::move(graph)), "exchange()");
+
+    const auto t0 = std::chrono::steady_clock::now();
+    requireOk(sched.runAndWait(), "runAndWait()");
+    const auto   t1 = std::chrono::steady_clock::now();
+    const double dt = std::chrono::duration<double>(t1 - t0).count();
+
+    const auto& partition = sched.partitionInfo();
+    std::printf("FmChain,%s,%zu,%.2f,%zu,%.0f\n", config, input.size(), static_cast<double>(input.size()) / dt / 1e6, partition.blocks.size(), partition.cutBandwidth);
+    for (std::size_t worker = 0UZ; worker < partition.blocks.size(); ++worker) {
+        std::string names;
+        for (const std::string& name : partition.blocks[worker]) {
+            names += names.empty() ? name : " " + name;
+        }
+        std::printf("#   worker %zu cost=%.2f: %s\n", worker, partition.cost[worker], names.c_str());
+    }
+    for (const auto& entry : sched.chunkPlan()) {
+        if (entry.chunkSamples != 0UZ) {
+            std::printf("#   chunk %s: %zu samples, %zu B working set\n", entry.name.c_str(), entry.chunkSamples, entry.workingSetBytes);
+        }
+    }
+
+    const auto          telemetry = sched.telemetry();
+    std::vector<double> workSeconds(names.size(), 0.0);
+    for (std::size_t block = 0UZ; block < names.size(); ++block) {
+        const auto entry = std::ranges::find(telemetry.blocks, names[block], &gr::incubator::scheduler::BlockingBackoff<>::BlockTelemetry::name);
+        if (entry != telemetry.blocks.end()) {
+            workSeconds[block] = entry->workSeconds;
+        }
+    }
+    return workSeconds;
+}
+
+} // namespace
+
+int main() {
+    constexpr std::size_t N_IN = 20'000'000UZ;
+
+    std::vector<std::complex<float>> input(N_IN);
+    for (std::size_t i = 0UZ; i < N_IN; ++i) {
+        input[i] = std::polar(1.F, 0.01F * static_cast<float>(i % 628UZ));
+    }
+
+    std::puts("chain,config,N,input_throughput_MSas,workers,cut_bandwidth");
+    const std::vector<double> measured = runChain("round_robin", input, "round_robin", false); // also the calibration run
+    runChain("traffic_aware_uniform", input, "traffic_aware", false);
+    runChain("traffic_aware_hinted", input, "traffic_aware", true);
+    runChain("traffic_aware_measured", input, "traffic_aware", true, 0U, measured);
+    runChain("traffic_aware_hinted_l1_chunks", input, "traffic_aware", true, 1U);
+    runChain("traffic_aware_hinted_l2_chunks", input, "traffic_aware", true, 2U);
+}
@@ -0,0 +1,339 @@
+// bench_SchedulerMatrix.cpp — scheduler comparison over synthetic topologies
+// Topologies: linear chains of 2..64 blocks (StampedSource → Copy × (n-2) → StampedSink),
+// fan-out/fan-in (one source feeding n Copy branches merged back by a tree of Merge2 blocks)
+// and n independent source → sink pairs.
+// Every topology runs under the upstream Simple scheduler (single and multi threaded) and
+// under BlockingBackoff with several idle settings. Reports throughput (samples delivered to
+// sinks per second), CPU utilisation (process CPU time / wall time, in cores) and p50/p99
+// latency of fixed-size chunks from the source's publish to the sink's consume.
+// Output is CSV by default, `--json` prints a JSON array instead.
+// Usage: bench_SchedulerMatrix [--json] [--samples N] [--chunk N]
+#include <gnuradio-4.0/Block.hpp>
+#include <gnuradio-4.0/Graph.hpp>
+#include <gnuradio-4.0/Scheduler.hpp>
+#include <gnuradio-4.0/scheduler/BlockingBackoff.hpp>
+#include <gnuradio-4.0/testing/NullSources.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+// time at which the last sample of every chunk was published (source) or consumed (sink)
+using ChunkStamps = std::vector<clock::time_point>;
+
+inline void stampChunks(ChunkStamps* stamps, std::size_t chunk, std::size_t begin, std::size_t end) {
+    if (stamps == nullptr) {
+        return;
+    }
+    const clock::time_point now = clock::now();
+    for (std::size_t index = (begin + chunk) / chunk; index * chunk <= end && index - 1UZ < stamps->size(); ++index) {
+        (*stamps)[index - 1UZ] = now;
+    }
+}
+
+template<typename T>
+struct StampedSource : gr::Block<StampedSource<T>> {
+    gr::PortOut<T> out;
+
+    gr::Annotated<gr::Size_t, "n_samples", gr::Doc<"Samples to produce">> n_samples = 1'000'000U;
+    gr::Annotated<gr::Size_t, "chunk", gr::Doc<"Latency chunk size">>     chunk     = 1024U;
+
+    GR_MAKE_REFLECTABLE(StampedSource, out, n_samples, chunk);
+
+    ChunkStamps* _stamps   = nullptr;
+    std::size_t  _produced = 0UZ;
+
+    void start() { _produced = 0UZ; }
+
+    [[nodiscard]] gr::work::Status processBulk(gr::OutputSpanLike auto& outSpan) {
+        const std::size_t total = static_cast<std::size_t>(n_samples.value);
+        if (_produced >= total) {
+            outSpan.publish(0UZ);
+            return gr::work::Status::DONE;
+        }
+        const std::size_t n = std::min(total - _produced, outSpan.size());
+        std::fill_n(outSpan.begin(), n, T{1});
+        outSpan.publish(n);
+        stampChunks(_stamps, static_cast<std::size_t>(chunk.value), _produced, _produced + n);
+        _produced += n;
+        return _produced >= total ? gr::work::Status::DONE : gr::work::Status::OK;
+    }
+};
+
+template<typename T>
+struct StampedSink : gr::Block<StampedSink<T>> {
+    gr::PortIn<T> in;
+
+    gr::Annotated<gr::Size_t, "chunk", gr::Doc<"Latency chunk size">> chunk = 1024U;
+
+    GR_MAKE_REFLECTABLE(StampedSink, in, chunk);
+
+    ChunkStamps* _stamps   = nullptr;
+    std::size_t  _consumed = 0UZ;
+
+    void start() { _consumed = 0UZ; }
+
+    [[nodiscard]] gr::work::Status processBulk(gr::InputSpanLike auto& inSpan) {
+        stampChunks(_stamps, static_cast<std::size_t>(chunk.value), _consumed, _consumed + inSpan.size());
+        _consumed += inSpan.size();
+        return gr::work::Status::OK;
+    }
+};
+
+template<typename T>
+struct Merge2 : gr::Block<Merge2<T>> {
+    gr::PortIn<T>  in0;
+    gr::PortIn<T>  in1;
+    gr::PortOut<T> out;
+
+    GR_MAKE_REFLECTABLE(Merge2, in0, in1, out);
+
+    [[nodiscard]] constexpr T processOne(T a, T b) const noexcept { return a + b; }
+};
+
+struct Options {
+    std::size_t nSamples = 4'000'000UZ;
+    std::size_t chunk    = 1024UZ;
+    bool        json     = false;
+};
+
+struct Endpoints {
+    std::vector<ChunkStamps>         published;
+    std::vector<ChunkStamps>         consumed;
+    std::vector<StampedSink<float>*> sinks;
+};
+
+struct Topology {
+    std::string                                 name;
+    std::function<void(gr::Graph&, Endpoints&)> build;
+};
+
+void reserveStamps(Endpoints& endpoints, std::size_t nPairs, const Options& options) {
+    const std::size_t nChunks = options.nSamples / options.chunk;
+    endpoints.published.assign(nPairs, ChunkStamps(nChunks));
+    endpoints.consumed.assign(nPairs, ChunkStamps(nChunks));
+}
+
+StampedSource<float>& addSource(gr::Graph& graph, Endpoints& endpoints, std::size_t pair, const Options& options) {
+    auto& source   = graph.emplaceBlock<StampedSource<float>>(gr::property_map{{"n_samples", static_cast<gr::Size_t>(options.nSamples)}, {"chunk", static_cast<gr::Size_t>(options.chunk)}});
+    source._stamps = &endpoints.published[pair];
+    return source;
+}
+
+StampedSink<float>& addSink(gr::Graph& graph, Endpoints& endpoints, std::size_t pair, const Options& options) {
+    auto& sink   = graph.emplaceBlock<StampedSink<float>>(gr::property_map{{"chunk", static_cast<gr::Size_t>(options.chunk)}});
+    sink._stamps = &endpoints.consumed[pair];
+    endpoints.sinks.push_back(&sink);
+    return sink;
+}
+
+Topology linearChain(std::size_t nBlocks, const Options& options) {
+    return {std::format("chain_{}", nBlocks), [nBlocks, options](gr::Graph& graph, Endpoints& endpoints) {
+                reserveStamps(endpoints, 1UZ, options);
+                auto& source = addSource(graph, endpoints, 0UZ, options);
+                if (nBlocks <= 2UZ) {
+                    std::ignore = graph.connect<"out", "in">(source, addSink(graph, endpoints, 0UZ, options));
+                    return;
+                }
+                auto* tail  = &graph.emplaceBlock<gr::testing::Copy<float>>();
+                std::ignore = graph.connect<"out", "in">(source, *tail);
+                for (std::size_t i = 3UZ; i < nBlocks; ++i) {
+                    auto& copy  = graph.emplaceBlock<gr::testing::Copy<float>>();
+                    std::ignore = graph.connect<"out", "in">(*tail, copy);
+                    tail        = &copy;
+                }
+                std::ignore = graph.connect<"out", "in">(*tail, addSink(graph, endpoints, 0UZ, options));
+            }};
+}
+
+// nBranches must be a power of two (a balanced merge tree)
+Topology fanOutFanIn(std::size_t nBranches, const Options& options) {
+    return {std::format("fan_{}", nBranches), [nBranches, options](gr::Graph& graph, Endpoints& endpoints) {
+                reserveStamps(endpoints, 1UZ, options);
+                auto&                                  source = addSource(graph, endpoints, 0UZ, options);
+                std::vector<gr::testing::Copy<float>*> branches;
+                for (std::size_t branch = 0UZ; branch < nBranches; ++branch) {
+                    auto& copy  = graph.emplaceBlock<gr::testing::Copy<float>>();
+                    std::ignore = graph.connect<"out", "in">(source, copy);
+                    branches.push_back(&copy);
+                }
+                std::vector<Merge2<float>*> level;
+                for (std::size_t i = 0UZ; i + 1UZ < branches.size(); i += 2UZ) {
+                    auto& merge = graph.emplaceBlock<Merge2<float>>();
+                    std::ignore = graph.connect<"out", "in0">(*branches[i], merge);
+                    std::ignore = graph.connect<"out", "in1">(*branches[i + 1UZ], merge);
+                    level.push_back(&merge);
+                }
+                while (level.size() > 1UZ) {
+                    std::vector<Merge2<float>*> next;
+                    for (std::size_t i = 0UZ; i + 1UZ < level.size(); i += 2UZ) {
+                        auto& merge = graph.emplaceBlock<Merge2<float>>();
+                        std::ignore = graph.connect<"out", "in0">(*level[i], merge);
+                        std::ignore = graph.connect<"out", "in1">(*level[i + 1UZ], merge);
+                        next.push_back(&merge);
+                    }
+                    level = std::move(next);
+                }
+                std::ignore = graph.connect<"out", "in">(*level.front(), addSink(graph, endpoints, 0UZ, options));
+            }};
+}
+
+Topology independentPairs(std::size_t nPairs, const Options& options) {
+    return {std::format("pairs_{}", nPairs), [nPairs, options](gr::Graph& graph, Endpoints& endpoints) {
+                reserveStamps(endpoints, nPairs, options);
+                for (std::size_t pair = 0UZ; pair < nPairs; ++pair) {
+                    auto& source = addSource(graph, endpoints, pair, options);
+                    auto& sink   = addSink(graph, endpoints, pair, options);
+                    std::ignore  = graph.connect<"out", "in">(source, sink);
+                }
+            }};
+}
+
+[[nodiscard]] double processCpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const auto seconds = [](const timeval& tv) { return static_cast<double>(tv.tv_sec) + 1e-6 * static_cast<double>(tv.tv_usec); };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+[[nodiscard]] double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const std::size_t index = std::min(values.size() - 1UZ, static_cast<std::size_t>(p * static_cast<double>(values.size())));
+    std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(index));
+    return values[index];
+}
+
+struct Result {
+    std::string topology;
+    std::string scheduler;
+    std::size_t nBlocks        = 0UZ;
+    double      throughputMSps = 0.0;
+    double      cpuCores       = 0.0; // process CPU seconds per wall second
+    double      latencyP50Us   = 0.0;
+    double      latencyP99Us   = 0.0;
+};
+
+void print(const Result& result, const Options& options, bool& first) {
+    if (options.json) {
+        std::printf("%s\n  {\"topology\": \"%s\", \"scheduler\": \"%s\", \"blocks\": %zu, \"throughput_MSps\": %.3f, \"cpu_cores\": %.3f, \"latency_p50_us\": %.1f, \"latency_p99_us\": %.1f}", first ? "[" : ",", result.topology.c_str(), result.scheduler.c_str(), result.nBlocks, result.throughputMSps, result.cpuCores, result.latencyP50Us, result.latencyP99Us);
+    } else {
+        if (first) {
+            std::puts("topology,scheduler,blocks,throughput_MSps,cpu_cores,latency_p50_us,latency_p99_us");
+        }
+        std::printf("%s,%s,%zu,%.3f,%.3f,%.1f,%.1f\n", result.topology.c_str(), result.scheduler.c_str(), result.nBlocks, result.throughputMSps, result.cpuCores, result.latencyP50Us, result.latencyP99Us);
+    }
+    std::fflush(stdout);
+    first = false;
+}
+
+template<typename TScheduler, typename TConfigure>
+Result run(const Topology& topology, const char* schedulerName, TConfigure&& configure) {
+    gr::Graph graph;
+    Endpoints endpoints;
+    topology.build(graph, endpoints);
+    const std::size_t nBlocks = graph.blocks().size();
+
+    TScheduler scheduler;
+    configure(scheduler);
+    std::ignore = scheduler.exchange(std::move(graph));
+
+    const double cpu0 = processCpuSeconds();
+    const auto   t0   = clock::now();
+    std::ignore       = scheduler.runAndWait();
+    const double wall = std::chrono::duration<double>(clock::now() - t0).count();
+    const double cpu  = processCpuSeconds() - cpu0;
+
+    std::size_t delivered = 0UZ;
+    for (const StampedSink<float>* sink : endpoints.sinks) {
+        delivered += sink->_consumed;
+    }
+    std::vector<double> latencyUs;
+    for (std::size_t pair = 0UZ; pair < endpoints.published.size(); ++pair) {
+        for (std::size_t index = 0UZ; index < endpoints.published[pair].size(); ++index) {
+            const clock::time_point published = endpoints.published[pair][index];
+            const clock::time_point consumed  = endpoints.consumed[pair][index];
+            if (published != clock::time_point{} && consumed != clock::time_point{}) {
+                latencyUs.push_back(std::chrono::duration<double, std::micro>(consumed - published).count());
+            }
+        }
+    }
+    return {.topology = topology.name, .scheduler = schedulerName, .nBlocks = nBlocks, .throughputMSps = static_cast<double>(delivered) / wall / 1e6, .cpuCores = cpu / wall, .latencyP50Us = percentile(latencyUs, 0.50), .latencyP99Us = percentile(latencyUs, 0.99)};
+}
+
+[[nodiscard]] std::size_t parseCount(std::string_view text, std::size_t fallback) {
+    std::size_t value = 0UZ;
+    return std::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc{} && value != 0UZ ? value : fallback;
+}
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    using BlockingBackoff = gr::incubator::scheduler::BlockingBackoff<>;
+    using SimpleSingle    = gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::singleThreaded>;
+    using SimpleMulti     = gr::scheduler::Simple<gr::scheduler::ExecutionPolicy::multiThreaded>;
+
+    bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--json") {
+            options.json = true;
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.nSamples = bench::parseCount(argv[++i], options.nSamples);
+        } else if (arg == "--chunk" && i + 1 < argc) {
+            options.chunk = bench::parseCount(argv[++i], options.chunk);
+        }
+    }
+
+    std::vector<bench::Topology> topologies;
+    for (const std::size_t nBlocks : {2UZ, 4UZ, 8UZ, 16UZ, 32UZ, 64UZ}) {
+        topologies.push_back(bench::linearChain(nBlocks, options));
+    }
+    for (const std::size_t nBranches : {2UZ, 4UZ, 8UZ}) {
+        topologies.push_back(bench::fanOutFanIn(nBranches, options));
+    }
+    for (const std::size_t nPairs : {2UZ, 8UZ, 32UZ}) {
+        topologies.push_back(bench::independentPairs(nPairs, options));
+    }
+
+    bool first = true;
+    for (const bench::Topology& topology : topologies) {
+        bench::print(bench::run<SimpleSingle>(topology, "simple", [](auto&) {}), options, first);
+        bench::print(bench::run<SimpleMulti>(topology, "simple_mt", [](auto&) {}), options, first);
+        bench::print(bench::run<BlockingBackoff>(topology, "bb_default", [](BlockingBackoff&) {}), options, first);
+        bench::print(bench::run<BlockingBackoff>(topology, "bb_spin", [](BlockingBackoff& sched) {
+            sched.active_spin_count  = gr::Size_t(64);
+            sched.initial_backoff_us = gr::Size_t(5);
+            sched.max_backoff_us     = gr::Size_t(100);
+        }), options, first);
+        bench::print(bench::run<BlockingBackoff>(topology, "bb_lazy", [](BlockingBackoff& sched) {
+            sched.active_spin_count  = gr::Size_t(0);
+            sched.initial_backoff_us = gr::Size_t(200);
+            sched.max_backoff_us     = gr::Size_t(5000);
+        }), options, first);
+        bench::print(bench::run<BlockingBackoff>(topology, "bb_park", [](BlockingBackoff& sched) { sched.idle_strategy = std::string("park"); }), options, first);
+        bench::print(bench::run<BlockingBackoff>(topology, "bb_adaptive", [](BlockingBackoff& sched) { sched.idle_strategy = std::string("adaptive"); }), options, first);
+        bench::print(bench::run<BlockingBackoff>(topology, "bb_traffic_aware_stealing", [](BlockingBackoff& sched) {
+            sched.partition_strategy = std::string("traffic_aware");
+            sched.work_stealing      = true;
+        }), options, first);
+    }
+    if (options.json) {
+        std::puts(first ? "[]" : "\n]");
+    }
+}
@@ -2,23 +2,297 @@
 #define GNURADIO_INCUBATOR_SCHEDULER_BLOCKINGBACKOFF_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <format>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <gnuradio-4.0/Graph.hpp>
 #include <gnuradio-4.0/Scheduler.hpp>
 
+#include <gnuradio-4.0/scheduler/ChunkPlanner.hpp>
+#include <gnuradio-4.0/scheduler/GraphPartition.hpp>
+#include <gnuradio-4.0/scheduler/IoWakeup.hpp>
+#include <gnuradio-4.0/scheduler/RealtimePriority.hpp>
+#include <gnuradio-4.0/scheduler/SharedWorkerPool.hpp>
+#include <gnuradio-4.0/scheduler/ThreadAffinity.hpp>
+#include <gnuradio-4.0/scheduler/WakeupEvent.hpp>
+
 namespace gr::incubator::scheduler {
 
+namespace detail {
+
+// Shared execution slot of one block. A worker must claim the slot before calling into the block so that
+// work stealing never runs the same block on two threads at once.
+struct BlockSlot {
+    explicit BlockSlot(std::shared_ptr<gr::BlockModel> block_) : block(std::move(block_)) {}
+
+    std::shared_ptr<gr::BlockModel> block;
+    std::atomic_flag                claimed;
+
+    // telemetry, only advanced by the worker holding the claim
+    std::atomic<std::uint64_t> nWorkCalls{0U};
+    std::atomic<std::uint64_t> nPerformedWork{0U};
+    std::atomic<std::uint64_t> workTimeNs{0U};
+
+    // cache-fitted work() request and the working set it corresponds to (0: no hint)
+    std::atomic<std::size_t> requestedWork{std::numeric_limits<std::size_t>::max()};
+    std::atomic<std::size_t> workingSetBytes{0UZ};
+
+    std::atomic<bool> heldByControl{false}; // the claim is held by the control thread, not by a worker
+
+    // work quantum (0: none), set before the slot is published; the deferral state is only touched by the claim holder
+    std::size_t                           minWorkItems = 0UZ;
+    std::chrono::steady_clock::time_point deferredSince{};
+    std::vector<std::size_t>              availableInput;
+
+    [[nodiscard]] bool tryClaim() noexcept { return !claimed.test_and_set(std::memory_order_acquire); }
+    void               release() noexcept { claimed.clear(std::memory_order_release); }
+};
+
+// Per-worker loop counters, only advanced by the owning worker.
+struct WorkerCounters {
+    std::atomic<std::uint64_t> nCycles{0U};
+    std::atomic<std::uint64_t> nIdleCycles{0U};
+    std::atomic<std::uint64_t> backoffTimeNs{0U};
+    std::atomic<std::uint64_t> nSteals{0U}; // work() calls with progress on blocks of other workers
+    std::atomic<std::uint64_t> nParks{0U};
+    std::atomic<std::uint64_t> nWakeups{0U}; // parked waits ended by a notification instead of park_timeout_us
+    std::atomic<bool>          realtime{false}; // realtime_policy was granted to this worker
+};
+
+inline void addRelaxed(std::atomic<std::uint64_t>& counter, std::uint64_t increment) noexcept { counter.store(counter.load(std::memory_order_relaxed) + increment, std::memory_order_relaxed); }
+
+[[nodiscard]] inline std::uint64_t elapsedNs(std::chrono::steady_clock::time_point start) noexcept { return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()); }
+
+// Runs a claimed slot, recording call count, performed work and time spent in work() if requested.
+[[nodiscard]] inline gr::work::Result workClaimed(BlockSlot& slot, bool telemetry) {
+    const std::size_t requestedWork = slot.requestedWork.load(std::memory_order_relaxed);
+    if (!telemetry) {
+        return slot.block->work(requestedWork);
+    }
+    const auto             start  = std::chrono::steady_clock::now();
+    const gr::work::Result result = slot.block->work(requestedWork);
+    addRelaxed(slot.workTimeNs, elapsedNs(start));
+    addRelaxed(slot.nWorkCalls, 1U);
+    addRelaxed(slot.nPerformedWork, result.performed_work);
+    return result;
+}
+
+// Work-quantum gate of a claimed slot: holds back work() while the inputs hold some, but fewer than `minWorkItems`
+// samples, for at most `maxDelay` after the first held-back call. Empty inputs pass, so that end-of-stream and tags of
+// upstream blocks are still noticed; blocks without inputs are never held back.
+[[nodiscard]] inline bool quantumReady(BlockSlot& slot, std::chrono::steady_clock::duration maxDelay) {
+    if (slot.minWorkItems == 0UZ) {
+        return true;
+    }
+    slot.availableInput.clear();
+    std::ignore                 = slot.block->availableInputSamples(slot.availableInput);
+    const std::size_t available = slot.availableInput.empty() ? 0UZ : std::ranges::min(slot.availableInput);
+    const auto        now       = std::chrono::steady_clock::now();
+    if (available == 0UZ || available >= slot.minWorkItems || (slot.deferredSince != std::chrono::steady_clock::time_point{} && now - slot.deferredSince >= maxDelay)) {
+        slot.deferredSince = {};
+        return true;
+    }
+    if (slot.deferredSince == std::chrono::steady_clock::time_point{}) {
+        slot.deferredSince = now;
+    }
+    return false;
+}
+
+// Job list of one worker as seen by other (stealing) workers. Only the owning worker replaces `slots`.
+struct WorkerQueue {
+    std::mutex                              mutex;
+    std::vector<std::shared_ptr<BlockSlot>> slots;
+};
+
+// Runs unclaimed blocks of the other (non real-time) workers, starting with the next runner, until one victim yields
+// progress. `runSlot` executes one claimed slot; productive steals are counted in `counters` if given.
+template<typename TRunSlot>
+[[nodiscard]] gr::work::Result stealOnce(std::size_t runnerId, std::span<const std::shared_ptr<WorkerQueue>> queues, std::vector<std::shared_ptr<BlockSlot>>& stolenSlots, TRunSlot&& runSlot, WorkerCounters* counters) {
+    constexpr std::size_t requestedWork = std::numeric_limits<std::size_t>::max();
+    for (std::size_t offset = 1UZ; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(runnerId + offset) % queues.size()];
+        {
+            std::unique_lock queueGuard(victim.mutex, std::try_to_lock);
+            if (!queueGuard.owns_lock()) {
+                continue;
+            }
+            stolenSlots = victim.slots;
+        }
+
+        std::size_t performedWork = 0UZ;
+        for (const std::shared_ptr<BlockSlot>& slot : stolenSlots) {
+            if (!slot->tryClaim()) {
+                continue;
+            }
+            const gr::work::Result result = runSlot(*slot);
+            slot->release();
+
+            performedWork += result.performed_work;
+            if (counters != nullptr && result.performed_work != 0UZ) {
+                addRelaxed(counters->nSteals, 1U);
+            }
+            if (result.status == gr::work::Status::ERROR) {
+                stolenSlots.clear();
+                return {requestedWork, performedWork, gr::work::Status::ERROR};
+            }
+        }
+        stolenSlots.clear();
+        if (performedWork != 0UZ) {
+            return {requestedWork, performedWork, gr::work::Status::OK};
+        }
+    }
+    return {requestedWork, 0UZ, gr::work::Status::OK};
+}
+
+[[nodiscard]] inline std::optional<double> numericValue(const gr::pmt::Value& value) {
+    if (const auto* v = value.template get_if<double>()) {
+        return *v;
+    }
+    if (const auto* v = value.template get_if<float>()) {
+        return static_cast<double>(*v);
+    }
+    if (const auto* v = value.template get_if<std::int64_t>()) {
+        return static_cast<double>(*v);
+    }
+    if (const auto* v = value.template get_if<std::int32_t>()) {
+        return static_cast<double>(*v);
+    }
+    if (const auto* v = value.template get_if<std::uint64_t>()) {
+        return static_cast<double>(*v);
+    }
+    if (const auto* v = value.template get_if<std::uint32_t>()) {
+        return static_cast<double>(*v);
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] inline std::optional<double> lookupNumeric(const gr::property_map& map, std::string_view key) {
+    for (const auto& [entryKey, value] : map) {
+        if (std::string_view(entryKey) == key) {
+            return numericValue(value);
+        }
+    }
+    return std::nullopt;
+}
+
+// EWMA of the time between bursts of input, i.e. between productive cycles that follow an idle one.
+struct ArrivalPredictor {
+    using clock = std::chrono::steady_clock;
+
+    double            intervalUs = 0.0;
+    bool              primed     = false;
+    bool              idleSeen   = false;
+    clock::time_point lastArrival{};
+
+    void onCycle(bool progress, clock::time_point now, double smoothing) noexcept {
+        if (!progress) {
+            idleSeen = true;
+            return;
+        }
+        if (lastArrival == clock::time_point{}) {
+            lastArrival = now;
+        } else if (idleSeen) {
+            const double sampleUs = std::chrono::duration<double, std::micro>(now - lastArrival).count();
+            intervalUs            = primed ? intervalUs + smoothing * (sampleUs - intervalUs) : sampleUs;
+            primed                = true;
+            lastArrival           = now;
+        }
+        idleSeen = false;
+    }
+
+    /// Time left until `1 - guard` of the predicted interval has passed, or 0 if unknown or already overdue.
+    [[nodiscard]] std::size_t sleepHintUs(clock::time_point now, double guard) const noexcept {
+        if (!primed) {
+            return 0UZ;
+        }
+        const double remainingUs = intervalUs * (1.0 - guard) - std::chrono::duration<double, std::micro>(now - lastArrival).count();
+        return remainingUs >= 1.0 ? static_cast<std::size_t>(remainingUs) : 0UZ;
+    }
+};
+
+struct WorkerPair {
+    std::size_t hot  = 0UZ; // most loaded worker
+    std::size_t cold = 0UZ; // least loaded live worker, equal to hot if there is none
+};
+
+// Rebalancing trigger for one interval of per-worker busy fractions: the most loaded worker if it is saturated and above
+// its even share by more than `imbalance`, paired with the least loaded worker that has not retired.
+[[nodiscard]] inline std::optional<WorkerPair> overloadedWorker(std::span<const double> load, const std::vector<bool>& retired, double saturation, double imbalance) {
+    if (load.empty()) {
+        return std::nullopt;
+    }
+    WorkerPair pair;
+    pair.hot  = static_cast<std::size_t>(std::distance(load.begin(), std::ranges::max_element(load)));
+    pair.cold = pair.hot;
+    for (std::size_t worker = 0UZ; worker < load.size(); ++worker) {
+        if ((worker >= retired.size() || !retired[worker]) && (pair.cold == pair.hot || load[worker] < load[pair.cold])) {
+            pair.cold = worker;
+        }
+    }
+    const double mean = std::ranges::fold_left(load, 0.0, std::plus<>()) / static_cast<double>(load.size());
+    if (load[pair.hot] < saturation || load[pair.hot] <= mean * (1.0 + imbalance)) {
+        return std::nullopt;
+    }
+    return pair;
+}
+
+// Block of the hot worker to migrate given the busy fractions of its blocks and the hot-cold load gap. Moving a block of
+// load b changes the pair's maximum to max(hot - b, cold + b): best near half the gap, useless beyond it.
+[[nodiscard]] inline std::optional<std::size_t> migrationCandidate(std::span<const double> blockLoad, double gap) {
+    std::optional<std::size_t> candidate;
+    double                     bestScore = std::numeric_limits<double>::max();
+    for (std::size_t block = 0UZ; block < blockLoad.size(); ++block) {
+        const double busy = blockLoad[block];
+        if (busy > 0.0 && busy < gap && std::abs(busy - 0.5 * gap) < bestScore) {
+            bestScore = std::abs(busy - 0.5 * gap);
+            candidate = block;
+        }
+    }
+    return candidate;
+}
+
+template<typename TMap, typename TValue>
+void setEntry(TMap& map, std::string_view key, TValue&& value) {
+    map.insert_or_assign(typename TMap::key_type(key.data(), key.size()), gr::pmt::Value(std::forward<TValue>(value)));
+}
+
+// Edge endpoints are exposed either as references or as (smart) pointers depending on the GR4 version.
+template<typename TBlockRef>
+[[nodiscard]] const gr::BlockModel* blockAddress(const TBlockRef& ref) noexcept {
+    if constexpr (requires { ref.get(); }) {
+        return ref.get();
+    } else if constexpr (std::is_pointer_v<TBlockRef>) {
+        return ref;
+    } else {
+        return std::addressof(ref);
+    }
+}
+
+} // namespace detail
+
 template<gr::scheduler::ExecutionPolicy execution = gr::scheduler::ExecutionPolicy::multiThreaded>
 struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>, execution> {
     using Base        = gr::scheduler::SchedulerBase<BlockingBackoff<execution>, execution>;
@@ -27,34 +301,256 @@ struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>
     BlockingBackoff() : Base() {}
     explicit BlockingBackoff(gr::property_map initParameters) : Base(std::move(initParameters)) {}
 
-    gr::Annotated<gr::Size_t, "initial_backoff_us", gr::Doc<"Initial sleep duration after no-progress worker cycles">>      initial_backoff_us = 50U;
-    gr::Annotated<gr::Size_t, "max_backoff_us", gr::Doc<"Maximum sleep duration after repeated no-progress worker cycles">> max_backoff_us     = 2000U;
-    gr::Annotated<gr::Size_t, "active_spin_count", gr::Doc<"No-progress worker cycles allowed before sleeping">>            active_spin_count  = 2U;
+    gr::Annotated<gr::Size_t, "initial_backoff_us", gr::Doc<"Initial sleep duration after no-progress worker cycles">>                                       initial_backoff_us    = 50U;
+    gr::Annotated<gr::Size_t, "max_backoff_us", gr::Doc<"Maximum sleep duration after repeated no-progress worker cycles">>                                  max_backoff_us        = 2000U;
+    gr::Annotated<gr::Size_t, "active_spin_count", gr::Doc<"No-progress worker cycles allowed before sleeping">>                                             active_spin_count     = 2U;
+    gr::Annotated<bool, "work_stealing", gr::Doc<"Idle workers execute runnable blocks from other workers' job lists">>                                      work_stealing         = false;
+    gr::Annotated<std::string, "partition_strategy", gr::Doc<"Job list assignment: 'round_robin' or 'traffic_aware'">>                                       partition_strategy    = std::string("round_robin");
+    gr::Annotated<float, "partition_imbalance", gr::Doc<"Allowed worker load above the even share for traffic_aware">>                                       partition_imbalance   = 0.25F;
+    gr::Annotated<gr::property_map, "block_costs", gr::Doc<"Relative per-block cost keyed by unique block name (default 1)">>                                block_costs{};
+    gr::Annotated<gr::property_map, "edge_bandwidth", gr::Doc<"Relative edge traffic keyed by '<source>-><destination>' unique names">>                      edge_bandwidth{};
+    gr::Annotated<std::string, "idle_strategy", gr::Doc<"Idle worker behaviour: 'backoff' (sleep), 'park' (block until woken) or 'adaptive'">>               idle_strategy         = std::string("backoff");
+    gr::Annotated<gr::Size_t, "park_timeout_us", gr::Doc<"Upper bound of one parked wait, bounds polling of sources and stop latency">>                      park_timeout_us       = 2000U;
+    gr::Annotated<std::string, "cpu_affinity", gr::Doc<"Worker CPUs: '' (unpinned), 'isolated' (isolcpus set) or a list like '2-5,8'">>                      cpu_affinity          = std::string("");
+    gr::Annotated<bool, "numa_thread_policy", gr::Doc<"Group pinned workers by NUMA node and give them MPOL_LOCAL (thread policy, buffers not moved)">>      numa_thread_policy    = true;
+    gr::Annotated<bool, "enable_telemetry", gr::Doc<"Record per-block work statistics and per-worker idle statistics">>                                      enable_telemetry      = false;
+    gr::Annotated<gr::Size_t, "telemetry_interval_ms", gr::Doc<"Period of the 'telemetry' notification on msgOut, 0 disables it">>                           telemetry_interval_ms = 0U;
+    gr::Annotated<float, "arrival_smoothing", gr::Doc<"EWMA weight of the newest inter-arrival sample for idle_strategy 'adaptive'">>                        arrival_smoothing     = 0.125F;
+    gr::Annotated<float, "arrival_guard", gr::Doc<"Fraction of the predicted inter-arrival time left unslept for 'adaptive'">>                               arrival_guard         = 0.2F;
+    gr::Annotated<std::string, "realtime_blocks", gr::Doc<"Comma separated name patterns of blocks that get a dedicated real-time worker">>                  realtime_blocks       = std::string("");
+    gr::Annotated<std::string, "realtime_policy", gr::Doc<"Scheduling class of real-time workers: 'fifo', 'rr' or 'none'">>                                  realtime_policy       = std::string("fifo");
+    gr::Annotated<gr::Size_t, "realtime_priority", gr::Doc<"Priority of real-time workers, clamped to the policy's range">>                                  realtime_priority     = 50U;
+    gr::Annotated<bool, "lock_memory", gr::Doc<"mlockall() the process when real-time workers are used">>                                                    lock_memory           = false;
+    gr::Annotated<bool, "control_thread", gr::Doc<"Handle scheduler and block messages on a dedicated thread instead of the workers">>                       control_thread        = false;
+    gr::Annotated<gr::Size_t, "control_period_us", gr::Doc<"Polling period of the control thread">>                                                          control_period_us     = 500U;
+    gr::Annotated<gr::Size_t, "chunk_cache_level", gr::Doc<"Cap work() requests so hinted working sets fit this cache level (1, 2, 3; 0 disables)">>         chunk_cache_level     = 0U;
+    gr::Annotated<float, "chunk_cache_fill", gr::Doc<"Fraction of the selected cache a block's working set may occupy">>                                     chunk_cache_fill      = 0.5F;
+    gr::Annotated<gr::Size_t, "min_chunk_samples", gr::Doc<"Lower bound of cache-fitted work() requests">>                                                   min_chunk_samples     = 256U;
+    gr::Annotated<gr::property_map, "min_work_items", gr::Doc<"Input samples a block waits for before work() is called, keyed by unique block name">>        min_work_items{};
+    gr::Annotated<gr::Size_t, "max_work_delay_us", gr::Doc<"Longest time a block is held back by min_work_items once input is pending">>                     max_work_delay_us     = 1000U;
+    gr::Annotated<std::string, "shared_pool", gr::Doc<"Name of a process-wide worker pool shared with other schedulers ('' uses own workers)">>              shared_pool           = std::string("");
+    gr::Annotated<gr::Size_t, "shared_pool_threads", gr::Doc<"Threads of the shared pool (0: hardware concurrency), pools are shared per name and size">>    shared_pool_threads   = 0U;
+    gr::Annotated<float, "graph_priority", gr::Doc<"Relative CPU share of this graph within the shared pool">>                                               graph_priority        = 1.0F;
+    gr::Annotated<gr::Size_t, "rebalance_interval_ms", gr::Doc<"Period of measuring worker load and migrating blocks off saturated workers, 0 disables it">> rebalance_interval_ms = 0U;
+    gr::Annotated<float, "rebalance_saturation", gr::Doc<"Busy fraction (time in work()) above which a worker counts as saturated">>                         rebalance_saturation  = 0.5F;
+    gr::Annotated<gr::Size_t, "rebalance_persistence", gr::Doc<"Consecutive saturated and imbalanced intervals before a block is migrated">>                 rebalance_persistence = 3U;
+    gr::Annotated<gr::Size_t, "worker_threads", gr::Doc<"Worker threads (job lists) to use, 0: all threads of the pool, never more than the pool has">>      worker_threads        = 0U;
 
-    GR_MAKE_REFLECTABLE(BlockingBackoff, initial_backoff_us, max_backoff_us, active_spin_count);
+    GR_MAKE_REFLECTABLE(BlockingBackoff, initial_backoff_us, max_backoff_us, active_spin_count, work_stealing, partition_strategy, partition_imbalance, block_costs, edge_bandwidth, idle_strategy, park_timeout_us, cpu_affinity, numa_thread_policy, enable_telemetry, telemetry_interval_ms, arrival_smoothing, arrival_guard, realtime_blocks, realtime_policy, realtime_priority, lock_memory, control_thread, control_period_us, chunk_cache_level, chunk_cache_fill, min_chunk_samples, min_work_items, max_work_delay_us, shared_pool, shared_pool_threads, graph_priority, rebalance_interval_ms, rebalance_saturation, rebalance_persistence, worker_threads);
+
+    struct PartitionInfo {
+        std::vector<std::vector<std::string>> blocks;              // unique block names per worker
+        std::vector<double>                   cost;                // summed block cost per worker
+        double                                cutBandwidth  = 0.0; // edge traffic crossing worker boundaries
+        std::size_t                           realtimeLanes = 0UZ; // trailing workers reserved for realtime_blocks
+    };
+
+    /// Job list assignment chosen by the last customInit(), for inspection and benchmarking.
+    [[nodiscard]] const PartitionInfo& partitionInfo() const noexcept { return _partitionInfo; }
+
+    struct BlockTelemetry {
+        std::string   name;
+        std::uint64_t workCalls     = 0U;
+        std::uint64_t performedWork = 0U; // samples reported by work(), the type-erased interface does not split in/out
+        double        workSeconds   = 0.0;
+    };
+
+    struct WorkerTelemetry {
+        std::uint64_t cycles         = 0U;
+        std::uint64_t idleCycles     = 0U; // cycles without stream progress
+        double        backoffSeconds = 0.0;
+        std::uint64_t steals         = 0U; // work() calls with progress on blocks of other workers (work_stealing)
+        std::uint64_t parks          = 0U; // parked waits (idle_strategy 'park')
+        std::uint64_t wakeups        = 0U; // parked waits ended by a notification rather than park_timeout_us
+        bool          realtime       = false; // runs under realtime_policy (recorded regardless of enable_telemetry)
+    };
+
+    struct Telemetry {
+        std::vector<BlockTelemetry>  blocks; // sorted by name
+        std::vector<WorkerTelemetry> workers;
+    };
+
+    /// Snapshot of the counters recorded since the last customInit() when enable_telemetry is set (zeros otherwise).
+    [[nodiscard]] Telemetry telemetry() const {
+        Telemetry       snapshot;
+        std::lock_guard slotGuard(_slotsMutex);
+        snapshot.blocks.reserve(_blockSlots.size());
+        for (const auto& [address, slot] : _blockSlots) {
+            snapshot.blocks.push_back({.name = std::string(slot->block->uniqueName()), .workCalls = slot->nWorkCalls.load(std::memory_order_relaxed), .performedWork = slot->nPerformedWork.load(std::memory_order_relaxed), .workSeconds = 1e-9 * static_cast<double>(slot->workTimeNs.load(std::memory_order_relaxed))});
+        }
+        std::ranges::sort(snapshot.blocks, {}, &BlockTelemetry::name);
+        snapshot.workers.reserve(_workerCounters.size());
+        for (const std::shared_ptr<detail::WorkerCounters>& counters : _workerCounters) {
+            snapshot.workers.push_back({.cycles = counters->nCycles.load(std::memory_order_relaxed), .idleCycles = counters->nIdleCycles.load(std::memory_order_relaxed), .backoffSeconds = 1e-9 * static_cast<double>(counters->backoffTimeNs.load(std::memory_order_relaxed)), .steals = counters->nSteals.load(std::memory_order_relaxed), .parks = counters->nParks.load(std::memory_order_relaxed), .wakeups = counters->nWakeups.load(std::memory_order_relaxed), .realtime = counters->realtime.load(std::memory_order_relaxed)});
+        }
+        return snapshot;
+    }
+
+    struct ChunkPlanEntry {
+        std::string name;
+        std::size_t chunkSamples    = 0UZ; // 0: unbounded (no working-set hint)
+        std::size_t workingSetBytes = 0UZ;
+    };
+
+    /// Cache-fitted work() requests currently applied per block (chunk_cache_level != 0), sorted by name.
+    [[nodiscard]] std::vector<ChunkPlanEntry> chunkPlan() const {
+        std::vector<ChunkPlanEntry> plan;
+        std::lock_guard             slotGuard(_slotsMutex);
+        plan.reserve(_blockSlots.size());
+        for (const auto& [address, slot] : _blockSlots) {
+            const std::size_t requested = slot->requestedWork.load(std::memory_order_relaxed);
+            plan.push_back({.name = std::string(slot->block->uniqueName()), .chunkSamples = requested == std::numeric_limits<std::size_t>::max() ? 0UZ : requested, .workingSetBytes = slot->workingSetBytes.load(std::memory_order_relaxed)});
+        }
+        std::ranges::sort(plan, {}, &ChunkPlanEntry::name);
+        return plan;
+    }
+
+    /// CPU of each pinned worker (runner i uses entry i modulo size), empty when workers are not pinned.
+    [[nodiscard]] const std::vector<int>& workerCpus() const noexcept { return _workerCpus; }
+
+    /// Wakes workers parked by idle_strategy = "park". I/O threads reach every scheduler through IoWakeup::notify().
+    void wake() noexcept { wakeWorkers(_allWorkers.load(std::memory_order_relaxed)); }
+
+    struct Migration {
+        std::string block;
+        std::size_t from = 0UZ; // worker index
+        std::size_t to   = 0UZ;
+    };
+
+    /// Blocks moved between workers by runtime rebalancing since the last customInit(), oldest first.
+    [[nodiscard]] std::vector<Migration> migrations() const {
+        std::lock_guard migrationGuard(_migrationMutex);
+        return _migrations;
+    }
+
+    /// Pool executing this graph when shared_pool is set (null otherwise), e.g. to inspect the per-graph CPU shares.
+    [[nodiscard]] const std::shared_ptr<SharedWorkerPool>& sharedPool() const noexcept { return _sharedPool; }
 
     void customInit() {
         [[maybe_unused]] const auto profilerEvent = this->_profilerHandler->startCompleteEvent("scheduler_blocking_backoff.init");
 
-        const gr::Graph   flatGraph = gr::graph::flatten(*this->_graph);
-        const std::size_t nBlocks   = flatGraph.blocks().size();
+        const gr::Graph flatGraph = gr::graph::flatten(*this->_graph);
 
-        std::size_t nBatches = 1UZ;
+        std::size_t nThreads = 1UZ;
         if constexpr (execution == gr::scheduler::ExecutionPolicy::multiThreaded) {
-            nBatches = std::max(1UZ, std::min(static_cast<std::size_t>(this->_pool->maxThreads()), nBlocks));
+            nThreads = std::max(1UZ, static_cast<std::size_t>(this->_pool->maxThreads()));
+            if (worker_threads.value != 0U) {
+                nThreads = std::min(nThreads, static_cast<std::size_t>(worker_threads.value));
+            }
+        }
+        // shared mode: the whole graph is one job of the named pool, so a graph never occupies more than one of its threads
+        _sharedPool.reset();
+        if (!shared_pool.value.empty()) {
+            _sharedPool = SharedWorkerPool::named(shared_pool.value, static_cast<std::size_t>(shared_pool_threads.value));
+            nThreads    = 1UZ;
+            warnIgnoredInSharedMode();
         }
 
+        // real-time blocks get lanes of their own (one per block while threads last), everything else is partitioned
+        const std::vector<std::string> realtimePatterns = realtime::splitPatterns(realtime_blocks.value);
+        std::vector<std::size_t>       streamBlocks;
+        std::vector<std::size_t>       realtimeBlocks;
+        for (std::size_t blockIndex = 0UZ; blockIndex < flatGraph.blocks().size(); ++blockIndex) {
+            (realtime::matchesAny(flatGraph.blocks()[blockIndex]->uniqueName(), realtimePatterns) ? realtimeBlocks : streamBlocks).push_back(blockIndex);
+        }
+        const std::size_t nRealtimeLanes = nThreads > 1UZ ? std::min(realtimeBlocks.size(), nThreads - 1UZ) : 0UZ;
+        if (nRealtimeLanes == 0UZ) {
+            streamBlocks.insert(streamBlocks.end(), realtimeBlocks.begin(), realtimeBlocks.end());
+            std::ranges::sort(streamBlocks);
+            realtimeBlocks.clear();
+        }
+
+        const std::size_t nBatches = std::max(1UZ, std::min(nThreads - nRealtimeLanes, streamBlocks.size()));
+        partition::Plan   plan     = planPartition(flatGraph, streamBlocks, nBatches);
+        if (streamBlocks.empty() && nRealtimeLanes != 0UZ) {
+            plan.batches.clear();
+            plan.batchCost.clear();
+        }
+        _realtimeLaneBegin = plan.batches.size();
+        for (std::size_t lane = 0UZ; lane < nRealtimeLanes; ++lane) {
+            std::vector<std::size_t>& batch = plan.batches.emplace_back();
+            double&                   cost  = plan.batchCost.emplace_back(0.0);
+            for (std::size_t index = lane; index < realtimeBlocks.size(); index += nRealtimeLanes) {
+                batch.push_back(realtimeBlocks[index]);
+                cost += blockCost(*flatGraph.blocks()[realtimeBlocks[index]]);
+            }
+        }
+        if (nRealtimeLanes != 0UZ) {
+            if (auto policy = realtime::parsePolicy(realtime_policy.value); !policy) {
+                this->emitErrorMessage("realtime_policy", policy.error()); // the lanes still run, just without a real-time class
+            }
+            if (lock_memory.value) {
+                if (auto locked = realtime::lockProcessMemory(); !locked) {
+                    this->emitErrorMessage("lock_memory", locked.error());
+                }
+            }
+        }
+
+        if (auto cpus = affinity::resolveCpus(cpu_affinity.value); cpus) {
+            _workerCpus = std::move(*cpus);
+        } else {
+            _workerCpus.clear(); // run unpinned rather than on a truncated CPU list
+            this->emitErrorMessage("cpu_affinity", cpus.error());
+        }
+        if (chunk_cache_level.value != 0U) {
+            _cacheSizes = chunking::detectCacheSizes();
+        }
+        if (numa_thread_policy.value) {
+            affinity::orderByNumaNode(_workerCpus);
+        }
+
+        {
+            std::lock_guard migrationGuard(_migrationMutex);
+            _pendingMigrations.clear();
+            _migrations.clear();
+            _nPendingMigrations.store(0UZ, std::memory_order_release);
+            _retiredWorkers.assign(plan.batches.size(), false);
+
+            _edgeEndpoints.clear();
+            for (const auto& edge : flatGraph.edges()) {
+                _edgeEndpoints.emplace_back(detail::blockAddress(edge.sourceBlock()), detail::blockAddress(edge.destinationBlock()));
+            }
+            _blockOwner.clear();
+            for (std::size_t worker = 0UZ; worker < plan.batches.size(); ++worker) {
+                for (const std::size_t blockIndex : plan.batches[worker]) {
+                    _blockOwner.insert_or_assign(flatGraph.blocks()[blockIndex].get(), worker);
+                }
+            }
+            updateNeighbourWorkers();
+            _allWorkers.store(plan.batches.size() >= kMaxWakeupEvents ? ~std::uint64_t{0} : workerBit(plan.batches.size()) - 1U, std::memory_order_relaxed);
+        }
+        _rebalanceBaseline.clear();
+        _rebalanceSaturatedCount = 0UZ;
+
         std::lock_guard lock(this->_executionOrderMutex);
         std::lock_guard guard(this->_adoptionBlocksMutex);
         this->_adoptionBlocks.clear();
-        this->_adoptionBlocks.resize(nBatches);
+        this->_adoptionBlocks.resize(plan.batches.size());
         this->_executionOrder->clear();
-        this->_executionOrder->reserve(nBatches);
-        for (std::size_t batchIndex = 0UZ; batchIndex < nBatches; ++batchIndex) {
-            std::vector<std::shared_ptr<gr::BlockModel>>& job = this->_executionOrder->emplace_back();
-            job.reserve(nBlocks / nBatches + 1UZ);
-            for (std::size_t blockIndex = batchIndex; blockIndex < nBlocks; blockIndex += nBatches) {
+        this->_executionOrder->reserve(plan.batches.size());
+        _partitionInfo = PartitionInfo{.blocks = {}, .cost = plan.batchCost, .cutBandwidth = plan.cutBandwidth, .realtimeLanes = nRealtimeLanes};
+        for (const std::vector<std::size_t>& batch : plan.batches) {
+            std::vector<std::shared_ptr<gr::BlockModel>>& job   = this->_executionOrder->emplace_back();
+            std::vector<std::string>&                     names = _partitionInfo.blocks.emplace_back();
+            job.reserve(batch.size());
+            for (const std::size_t blockIndex : batch) {
                 job.push_back(flatGraph.blocks()[blockIndex]);
+                names.emplace_back(flatGraph.blocks()[blockIndex]->uniqueName());
+            }
+        }
+
+        std::lock_guard slotGuard(_slotsMutex);
+        _blockSlots.clear();
+        _workerQueues.clear();
+        _workerQueues.reserve(plan.batches.size());
+        _workerCounters.clear();
+        _workerCounters.reserve(plan.batches.size());
+        for (const std::vector<std::shared_ptr<gr::BlockModel>>& job : *this->_executionOrder) {
+            std::shared_ptr<detail::WorkerQueue>& queue = _workerQueues.emplace_back(std::make_shared<detail::WorkerQueue>());
+            _workerCounters.push_back(std::make_shared<detail::WorkerCounters>());
+            queue->slots.reserve(job.size());
+            for (const std::shared_ptr<gr::BlockModel>& block : job) {
+                queue->slots.push_back(_blockSlots.emplace(block.get(), makeSlot(block)).first->second);
             }
         }
     }
@@ -66,10 +562,43 @@ struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>
 
         nRunningJobs->incrementAndGet();
         nRunningJobs->notify_all();
+        if (_sharedPool) {
+            submitSharedJob(runnerId, jobList, nRunningJobs);
+            return; // the job stays counted in nRunningJobs until the pool finishes it
+        }
         gr::thread_pool::thread::setThreadName(std::format("bb{}-{}", runnerId, gr::meta::shorten_type_name(this->unique_name)));
 
+        const bool controlled = control_thread.value;
+        if (controlled && runnerId == 0UZ) {
+            startControlThread(nRunningJobs);
+        }
+
         [[maybe_unused]] auto profilerHandler = this->_profiler.forThisThread();
 
+        affinity::ScopedThreadPinning pinning;
+        if (!_workerCpus.empty()) {
+            if (auto pinned = pinning.pin(_workerCpus[runnerId % _workerCpus.size()]); !pinned) {
+                this->emitErrorMessage("cpu_affinity", pinned.error());
+            } else if (numa_thread_policy.value) {
+                if (auto local = pinning.preferLocalMemory(); !local) {
+                    this->emitErrorMessage("numa_thread_policy", local.error());
+                }
+            }
+        }
+
+        realtime::ScopedRealtimePriority priority;
+        if (runnerId >= _realtimeLaneBegin) {
+            const realtime::Policy policy = realtime::parsePolicy(realtime_policy.value).value_or(realtime::Policy::None); // unknown names were reported by customInit()
+            if (auto applied = priority.apply(policy, static_cast<int>(realtime_priority.value)); !applied) {
+                this->emitErrorMessage("realtime_policy", applied.error());
+            } else if (policy != realtime::Policy::None) {
+                std::lock_guard slotGuard(_slotsMutex);
+                if (runnerId < _workerCounters.size()) {
+                    _workerCounters[runnerId]->realtime.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+
         std::vector<std::shared_ptr<gr::BlockModel>> localBlockList;
         {
             assert(jobList->size() > runnerId);
@@ -79,24 +608,83 @@ struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>
             std::ranges::copy(blocks, std::back_inserter(localBlockList));
         }
 
-        std::size_t inactiveCycleCount = 0UZ;
-        std::size_t backoffUs          = 0UZ;
-        std::size_t messageRatioCount  = 0UZ;
-        auto        activeState        = this->state();
+        const bool                                        realtimeLane = runnerId >= _realtimeLaneBegin;
+        const bool                                        stealing     = work_stealing.value && !realtimeLane;
+        const bool                                        parking      = idle_strategy.value == "park";
+        const bool                                        adaptive     = idle_strategy.value == "adaptive";
+        const bool                                        telemetry    = enable_telemetry.value;
+        const bool                                        chunked      = chunk_cache_level.value != 0U;
+        const bool                                        rebalancing  = rebalance_interval_ms.value != 0U && !realtimeLane;
+        const bool                                        measured     = telemetry || rebalancing; // per-block work time
+        const bool                                        batching     = !min_work_items.value.empty();
+        const bool                                        useSlots     = stealing || telemetry || controlled || chunked || rebalancing || batching;
+        const std::chrono::microseconds                   maxWorkDelay(max_work_delay_us.value);
+        const std::chrono::microseconds                   parkTimeout(batching ? std::min(park_timeout_us.value, max_work_delay_us.value) : park_timeout_us.value);
+        std::vector<std::shared_ptr<detail::WorkerQueue>> queues;
+        std::vector<std::shared_ptr<detail::BlockSlot>>   localSlots;
+        std::vector<std::shared_ptr<detail::BlockSlot>>   stolenSlots;
+        std::shared_ptr<detail::WorkerCounters>           counters     = std::make_shared<detail::WorkerCounters>();
+        if (useSlots) {
+            {
+                std::lock_guard slotGuard(_slotsMutex);
+                queues = _workerQueues;
+                if (runnerId < _workerCounters.size()) {
+                    counters = _workerCounters[runnerId];
+                }
+            }
+            publishSlots(runnerId, queues, localBlockList, localSlots);
+        }
+        if (chunked) {
+            planChunks(localSlots);
+        }
+
+        const std::chrono::milliseconds       telemetryInterval(telemetry && runnerId == 0UZ ? telemetry_interval_ms.value : 0U);
+        std::chrono::steady_clock::time_point nextTelemetry = std::chrono::steady_clock::now() + telemetryInterval;
+        const std::chrono::milliseconds       rebalanceInterval(rebalancing && runnerId == 0UZ ? rebalance_interval_ms.value : 0U);
+        std::chrono::steady_clock::time_point nextRebalance = std::chrono::steady_clock::now() + rebalanceInterval;
+        WakeupEvent&                          wakeup        = _wakeups[runnerId % kMaxWakeupEvents];
+
+        std::size_t              inactiveCycleCount = 0UZ;
+        std::size_t              backoffUs          = 0UZ;
+        std::size_t              predictedSleepUs   = 0UZ;
+        std::size_t              messageRatioCount  = 0UZ;
+        auto                     activeState        = this->state();
+        detail::ArrivalPredictor arrivals;
 
         do {
             [[maybe_unused]] auto profilerEvent = profilerHandler->startCompleteEvent("scheduler_blocking_backoff.work");
+            const std::uint32_t   wakeEpoch     = parking ? wakeup.epoch() : 0U; // sampled before the scan so no wake-up is lost
+
+            predictedSleepUs = 0UZ;
 
             const bool hasMessagesToProcess = messageRatioCount == 0UZ || this->msgIn.available() > 0UZ || this->_fromChildMessagePort.available() > 0UZ;
             if (hasMessagesToProcess) {
-                if (runnerId == 0UZ || nRunningJobs->value() == 0UZ) {
+                if (!controlled && (runnerId == 0UZ || nRunningJobs->value() == 0UZ)) {
                     this->processScheduledMessages();
                 }
 
                 this->cleanupZombieBlocks(localBlockList);
                 this->adoptBlocks(runnerId, localBlockList);
+                if (rebalancing) {
+                    handOverMigratingBlocks(runnerId, localBlockList);
+                }
 
-                std::ranges::for_each(localBlockList, &gr::BlockModel::processScheduledMessages);
+                if (useSlots) {
+                    if (!std::ranges::equal(localBlockList, localSlots, {}, {}, &detail::BlockSlot::block)) {
+                        publishSlots(runnerId, queues, localBlockList, localSlots);
+                    }
+                    if (!controlled) {
+                        processScheduledMessagesClaimed(localSlots);
+                    }
+                    if (chunked) {
+                        planChunks(localSlots); // settings (e.g. a longer filter) may have changed the hints
+                    }
+                } else {
+                    std::ranges::for_each(localBlockList, &gr::BlockModel::processScheduledMessages);
+                }
+                if (parking && this->state() != activeState) {
+                    wakeWorkers(_allWorkers.load(std::memory_order_relaxed));
+                }
                 activeState = this->state();
                 messageRatioCount++;
                 inactiveCycleCount = 0UZ;
@@ -115,10 +703,25 @@ struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>
                     if (gr::atomic_ref(this->_workQuiescenceRequested).load_acquire()) {
                         gr::atomic_ref(this->_nWorkersInWork).fetch_sub(1UZ);
                     } else {
-                        const gr::work::Result result = this->traverseBlockListOnce(localBlockList);
+                        bool             yieldedToControl = false;
+                        gr::work::Result result           = useSlots ? traverseSlotsOnce(localSlots, measured, maxWorkDelay, yieldedToControl) : this->traverseBlockListOnce(localBlockList);
+                        bool             stoleWork        = false;
+                        if (stealing && result.performed_work == 0UZ && result.status == gr::work::Status::OK) {
+                            const auto             runStolen = [measured, maxWorkDelay](detail::BlockSlot& slot) { return detail::quantumReady(slot, maxWorkDelay) ? detail::workClaimed(slot, measured) : gr::work::Result{std::numeric_limits<std::size_t>::max(), 0UZ, gr::work::Status::OK}; };
+                            const gr::work::Result stolen    = detail::stealOnce(runnerId, std::span<const std::shared_ptr<detail::WorkerQueue>>(queues).first(std::min(queues.size(), _realtimeLaneBegin)), stolenSlots, runStolen, telemetry ? counters.get() : nullptr);
+                            result.performed_work         = stolen.performed_work;
+                            stoleWork                     = stolen.performed_work != 0UZ;
+                            if (stolen.status == gr::work::Status::ERROR) {
+                                result.status = gr::work::Status::ERROR;
+                            }
+                        }
                         gr::atomic_ref(this->_nWorkersInWork).fetch_sub(1UZ);
 
                         if (result.status == gr::work::Status::DONE) {
+                            if (rebalancing && !retireWorker(runnerId)) {
+                                messageRatioCount = 0UZ; // a migrated block is waiting, adopt it on the next pass
+                                continue;
+                            }
                             break;
                         }
                         if (result.status == gr::work::Status::ERROR) {
@@ -126,7 +729,35 @@ struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>
                             break;
                         }
 
-                        updateBackoff(result.performed_work, inactiveCycleCount, backoffUs);
+                        if (parking && result.performed_work != 0UZ) {
+                            // only owners of connected blocks can be unblocked; a stolen block may belong to any worker
+                            wakeWorkers(stoleWork ? _allWorkers.load(std::memory_order_relaxed) : _neighbourWorkers[runnerId % kMaxWakeupEvents].load(std::memory_order_relaxed));
+                        }
+                        if (telemetry) {
+                            detail::addRelaxed(counters->nCycles, 1U);
+                            detail::addRelaxed(counters->nIdleCycles, result.performed_work == 0UZ ? 1U : 0U);
+                        }
+                        if (yieldedToControl && result.performed_work == 0UZ) {
+                            backoffUs = 0UZ; // not idle, a block was only held by the control thread: retry without sleeping
+                        } else {
+                            updateBackoff(result.performed_work, inactiveCycleCount, backoffUs);
+                        }
+                        if (adaptive) {
+                            const auto now = std::chrono::steady_clock::now();
+                            arrivals.onCycle(result.performed_work != 0UZ, now, static_cast<double>(arrival_smoothing.value));
+                            if (result.performed_work == 0UZ) {
+                                // sleep just short of the predicted next burst, then resume the regular spin/backoff ramp
+                                predictedSleepUs = std::min(arrivals.sleepHintUs(now, static_cast<double>(arrival_guard.value)), static_cast<std::size_t>(max_backoff_us.value));
+                                if (predictedSleepUs != 0UZ) {
+                                    inactiveCycleCount = 0UZ;
+                                    backoffUs          = 0UZ;
+                                }
+                            }
+                        }
+                        if (batching) { // no sleep may carry a held-back block past its deadline
+                            backoffUs        = std::min(backoffUs, static_cast<std::size_t>(max_work_delay_us.value));
+                            predictedSleepUs = std::min(predictedSleepUs, static_cast<std::size_t>(max_work_delay_us.value));
+                        }
                     }
                 }
             } else if (activeState == PAUSED) {
@@ -141,18 +772,487 @@ struct BlockingBackoff : gr::scheduler::SchedulerBase<BlockingBackoff<execution>
                 backoffUs          = 0UZ;
             }
 
-            if (backoffUs != 0UZ) {
-                std::this_thread::sleep_for(std::chrono::microseconds(backoffUs));
+            if (backoffUs != 0UZ || predictedSleepUs != 0UZ) {
+                const auto backoffStart = std::chrono::steady_clock::now();
+                if (parking) {
+                    if (telemetry) {
+                        detail::addRelaxed(counters->nParks, 1U); // counted on entry, so that observers can tell a worker is parked
+                    }
+                    const bool woken = wakeup.wait(wakeEpoch, parkTimeout);
+                    if (telemetry) {
+                        detail::addRelaxed(counters->nWakeups, woken ? 1U : 0U);
+                    }
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(predictedSleepUs != 0UZ ? predictedSleepUs : backoffUs));
+                }
+                if (telemetry) {
+                    detail::addRelaxed(counters->backoffTimeNs, detail::elapsedNs(backoffStart));
+                }
+            }
+
+            if (telemetryInterval.count() > 0 && std::chrono::steady_clock::now() >= nextTelemetry) {
+                nextTelemetry = std::chrono::steady_clock::now() + telemetryInterval;
+                publishTelemetry();
+            }
+            if (rebalanceInterval.count() > 0 && std::chrono::steady_clock::now() >= nextRebalance) {
+                nextRebalance = std::chrono::steady_clock::now() + rebalanceInterval;
+                planMigration(queues, 1e6 * static_cast<double>(rebalanceInterval.count()));
             }
 
             activeState = this->state();
         } while (gr::lifecycle::isActive(activeState));
 
+        if (parking) {
+            wakeWorkers(_allWorkers.load(std::memory_order_relaxed));
+        }
         std::ignore = nRunningJobs->subAndGet(1UZ);
         nRunningJobs->notify_all();
     }
 
 private:
+    static constexpr std::size_t kMaxWakeupEvents = 64UZ; // runner i parks on event i % 64, masks hold one bit per event
+
+    PartitionInfo                                                                  _partitionInfo;
+    std::array<WakeupEvent, kMaxWakeupEvents>                                      _wakeups;
+    std::array<std::atomic<std::uint64_t>, kMaxWakeupEvents>                       _neighbourWorkers{}; // per runner: owners of connected blocks
+    std::atomic<std::uint64_t>                                                     _allWorkers{0U};
+    std::vector<int>                                                               _workerCpus;
+    std::size_t                                                                    _realtimeLaneBegin = std::numeric_limits<std::size_t>::max();
+    std::jthread                                                                   _controlThread;
+    chunking::CacheSizes                                                           _cacheSizes;
+    std::shared_ptr<SharedWorkerPool>                                              _sharedPool;
+
+    struct PendingMigration {
+        const gr::BlockModel* block = nullptr;
+        Migration             record;
+    };
+
+    mutable std::mutex                                                             _migrationMutex;
+    std::vector<PendingMigration>                                                  _pendingMigrations;
+    std::vector<Migration>                                                         _migrations;
+    std::vector<bool>                                                              _retiredWorkers; // left with all blocks DONE
+    std::atomic<std::size_t>                                                       _nPendingMigrations{0UZ};
+    std::unordered_map<const detail::BlockSlot*, std::uint64_t>                    _rebalanceBaseline; // runner 0 only
+    std::size_t                                                                    _rebalanceSaturatedCount = 0UZ;
+    std::vector<std::pair<const gr::BlockModel*, const gr::BlockModel*>>           _edgeEndpoints; // source, destination
+    std::unordered_map<const gr::BlockModel*, std::size_t>                         _blockOwner;    // worker index, follows migrations
+    mutable std::mutex                                                             _slotsMutex;
+    std::unordered_map<const gr::BlockModel*, std::shared_ptr<detail::BlockSlot>> _blockSlots;
+    std::vector<std::shared_ptr<detail::WorkerQueue>>                              _workerQueues;
+    std::vector<std::shared_ptr<detail::WorkerCounters>>                           _workerCounters;
+    IoWakeup::Subscription                                                         _ioWakeup{[this] { wake(); }}; // last: unsubscribed before the events go
+
+    [[nodiscard]] static constexpr std::uint64_t workerBit(std::size_t worker) noexcept { return std::uint64_t{1} << (worker % kMaxWakeupEvents); }
+
+    void wakeWorkers(std::uint64_t workers) noexcept {
+        for (; workers != 0U; workers &= workers - 1U) {
+            _wakeups[static_cast<std::size_t>(std::countr_zero(workers))].notifyAll();
+        }
+    }
+
+    // Recomputes which workers a productive worker wakes: the owners of blocks sharing an edge with one of its blocks, in
+    // either direction, as published samples unblock consumers and consumed samples unblock producers on a full buffer.
+    // Called with _migrationMutex held (or before the workers start).
+    void updateNeighbourWorkers() {
+        std::array<std::uint64_t, kMaxWakeupEvents> neighbours{};
+        for (const auto& [source, destination] : _edgeEndpoints) {
+            const auto sourceOwner      = _blockOwner.find(source);
+            const auto destinationOwner = _blockOwner.find(destination);
+            if (sourceOwner == _blockOwner.end() || destinationOwner == _blockOwner.end() || sourceOwner->second == destinationOwner->second) {
+                continue;
+            }
+            neighbours[sourceOwner->second % kMaxWakeupEvents] |= workerBit(destinationOwner->second);
+            neighbours[destinationOwner->second % kMaxWakeupEvents] |= workerBit(sourceOwner->second);
+        }
+        for (std::size_t worker = 0UZ; worker < kMaxWakeupEvents; ++worker) {
+            _neighbourWorkers[worker].store(neighbours[worker], std::memory_order_relaxed);
+        }
+    }
+
+    // Runner 0: measures the busy fraction of every stream worker over the last interval. Once the busiest worker has been
+    // saturated and above its even share (partition_imbalance) for rebalance_persistence intervals, the block that best
+    // halves the gap to the least loaded worker is queued for migration. One migration is in flight at a time.
+    void planMigration(const std::vector<std::shared_ptr<detail::WorkerQueue>>& queues, double intervalNs) {
+        const std::size_t nWorkers = std::min(queues.size(), _realtimeLaneBegin);
+        if (nWorkers < 2UZ || _nPendingMigrations.load(std::memory_order_acquire) != 0UZ) {
+            return;
+        }
+        std::vector<bool> retired;
+        {
+            std::lock_guard migrationGuard(_migrationMutex);
+            retired = _retiredWorkers;
+        }
+        retired.resize(nWorkers, false);
+
+        std::vector<double>                                                load(nWorkers, 0.0);
+        std::vector<std::vector<std::pair<const gr::BlockModel*, double>>> blockLoad(nWorkers);
+        std::unordered_map<const detail::BlockSlot*, std::uint64_t>        baseline;
+        std::vector<std::shared_ptr<detail::BlockSlot>>                    slots;
+        std::unordered_map<const gr::BlockModel*, std::string>             names;
+        for (std::size_t worker = 0UZ; worker < nWorkers; ++worker) {
+            {
+                std::lock_guard queueGuard(queues[worker]->mutex);
+                slots = queues[worker]->slots;
+            }
+            for (const std::shared_ptr<detail::BlockSlot>& slot : slots) {
+                const std::uint64_t workTimeNs = slot->workTimeNs.load(std::memory_order_relaxed);
+                const auto          previous   = _rebalanceBaseline.find(slot.get());
+                const double        busy       = previous == _rebalanceBaseline.end() ? 0.0 : static_cast<double>(workTimeNs - previous->second) / intervalNs;
+                baseline.emplace(slot.get(), workTimeNs);
+                load[worker] += busy;
+                blockLoad[worker].emplace_back(slot->block.get(), busy);
+                names.emplace(slot->block.get(), slot->block->uniqueName());
+            }
+        }
+        _rebalanceBaseline = std::move(baseline);
+
+        const std::optional<detail::WorkerPair> pair = detail::overloadedWorker(load, retired, static_cast<double>(rebalance_saturation.value), static_cast<double>(partition_imbalance.value));
+        if (!pair) {
+            _rebalanceSaturatedCount = 0UZ;
+            return;
+        }
+        if (++_rebalanceSaturatedCount < std::max(1UZ, static_cast<std::size_t>(rebalance_persistence.value))) {
+            return;
+        }
+        _rebalanceSaturatedCount = 0UZ;
+
+        const auto [hot, cold] = *pair;
+        if (cold == hot || blockLoad[hot].size() < 2UZ) {
+            return; // no live receiver, or a single block that cannot be split
+        }
+        std::vector<double> busy;
+        std::ranges::transform(blockLoad[hot], std::back_inserter(busy), &std::pair<const gr::BlockModel*, double>::second);
+        const std::optional<std::size_t> candidate = detail::migrationCandidate(busy, load[hot] - load[cold]);
+        if (!candidate) {
+            return;
+        }
+        const gr::BlockModel* block = blockLoad[hot][*candidate].first;
+        std::lock_guard       migrationGuard(_migrationMutex);
+        _pendingMigrations.push_back({.block = block, .record = {.block = names[block], .from = hot, .to = cold}});
+        _nPendingMigrations.fetch_add(1UZ, std::memory_order_release);
+    }
+
+    // Owner side of a migration: only the worker owning a job list may edit it, so the donor moves the block into the
+    // target's _adoptionBlocks entry, from where the target picks it up with adoptBlocks() on its next message pass.
+    void handOverMigratingBlocks(std::size_t runnerId, std::vector<std::shared_ptr<gr::BlockModel>>& localBlockList) {
+        if (_nPendingMigrations.load(std::memory_order_acquire) == 0UZ) {
+            return;
+        }
+        std::lock_guard migrationGuard(_migrationMutex);
+        for (auto pending = _pendingMigrations.begin(); pending != _pendingMigrations.end();) {
+            if (pending->record.from != runnerId) {
+                ++pending;
+                continue;
+            }
+            const auto block = std::ranges::find(localBlockList, pending->block, &std::shared_ptr<gr::BlockModel>::get);
+            if (block != localBlockList.end() && !_retiredWorkers[pending->record.to]) {
+                {
+                    std::lock_guard adoptionGuard(this->_adoptionBlocksMutex);
+                    this->_adoptionBlocks[pending->record.to].push_back(std::move(*block));
+                }
+                localBlockList.erase(block);
+                _blockOwner.insert_or_assign(pending->block, pending->record.to);
+                updateNeighbourWorkers();
+                _wakeups[pending->record.to % kMaxWakeupEvents].notifyAll(); // adopt without waiting out a park
+                _migrations.push_back(std::move(pending->record));
+            }
+            pending = _pendingMigrations.erase(pending);
+            _nPendingMigrations.fetch_sub(1UZ, std::memory_order_release);
+        }
+    }
+
+    // A worker whose blocks are all DONE may only leave if no migrated block is waiting for it; afterwards it receives none.
+    [[nodiscard]] bool retireWorker(std::size_t runnerId) {
+        std::lock_guard migrationGuard(_migrationMutex);
+        {
+            std::lock_guard adoptionGuard(this->_adoptionBlocksMutex);
+            if (runnerId < this->_adoptionBlocks.size() && !this->_adoptionBlocks[runnerId].empty()) {
+                return false;
+            }
+        }
+        if (runnerId < _retiredWorkers.size()) {
+            _retiredWorkers[runnerId] = true;
+        }
+        return true;
+    }
+
+    // Started by runner 0. Counts as a running job until it is the last one, so stop requests and settings keep being
+    // handled while any worker streams. Blocks are only touched while claimed, i.e. never concurrently with work().
+    void startControlThread(const std::shared_ptr<gr::Sequence>& nRunningJobs) {
+        if (_controlThread.joinable()) {
+            _controlThread.join(); // left over from a previous run, already finished
+        }
+        std::vector<std::shared_ptr<detail::WorkerQueue>> queues;
+        {
+            std::lock_guard slotGuard(_slotsMutex);
+            queues = _workerQueues;
+        }
+        nRunningJobs->incrementAndGet();
+        _controlThread = std::jthread([this, nRunningJobs, queues = std::move(queues)](std::stop_token stopToken) {
+            gr::thread_pool::thread::setThreadName(std::format("bbctl-{}", gr::meta::shorten_type_name(this->unique_name)));
+            std::vector<std::shared_ptr<detail::BlockSlot>> slots;
+            while (true) {
+                this->processScheduledMessages();
+                for (const std::shared_ptr<detail::WorkerQueue>& queue : queues) {
+                    {
+                        std::lock_guard queueGuard(queue->mutex);
+                        slots = queue->slots;
+                    }
+                    processScheduledMessagesClaimed(slots, true);
+                }
+                if (stopToken.stop_requested() || !gr::lifecycle::isActive(this->state()) || nRunningJobs->value() <= 1UZ) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(control_period_us.value));
+            }
+            slots.clear();
+            std::ignore = nRunningJobs->subAndGet(1UZ);
+            nRunningJobs->notify_all();
+        });
+    }
+
+    struct SharedJobState {
+        std::vector<std::shared_ptr<gr::BlockModel>> blocks;
+        std::size_t                                  messageRatioCount = 0UZ;
+    };
+
+    // Shared mode: the job list becomes a step function of the shared pool, one message/work pass per step. The pool
+    // does the spinning and back-off; pinning, parking, stealing, real-time lanes and the control thread do not apply.
+    void submitSharedJob(std::size_t runnerId, const std::shared_ptr<gr::scheduler::JobLists>& jobList, std::shared_ptr<gr::Sequence> nRunningJobs) {
+        auto jobState = std::make_shared<SharedJobState>();
+        {
+            assert(jobList->size() > runnerId);
+            std::lock_guard lock(this->_executionOrderMutex);
+            jobState->blocks = jobList->at(runnerId);
+        }
+        SharedWorkerPool::JobOptions options{
+            .name           = std::format("{}-{}", this->unique_name, runnerId),
+            .weight         = static_cast<double>(graph_priority.value),
+            .idleSpinCount  = static_cast<std::size_t>(active_spin_count.value),
+            .initialBackoff = std::chrono::microseconds(initial_backoff_us.value),
+            .maxBackoff     = std::chrono::microseconds(max_backoff_us.value),
+        };
+        _sharedPool->submit([this, runnerId, jobState = std::move(jobState), nRunningJobs = std::move(nRunningJobs)] { return sharedStep(runnerId, *jobState, *nRunningJobs); }, std::move(options));
+    }
+
+    // The shared step only runs the plain message/work pass, so per-worker options are not applied in shared mode.
+    void warnIgnoredInSharedMode() {
+        const std::array<std::pair<std::string_view, bool>, 10UZ> options{{
+            {"worker_threads", worker_threads.value != 0U},
+            {"work_stealing", work_stealing.value},
+            {"idle_strategy", idle_strategy.value != "backoff"},
+            {"cpu_affinity", !cpu_affinity.value.empty()},
+            {"enable_telemetry", enable_telemetry.value},
+            {"realtime_blocks", !realtime_blocks.value.empty()},
+            {"control_thread", control_thread.value},
+            {"chunk_cache_level", chunk_cache_level.value != 0U},
+            {"min_work_items", !min_work_items.value.empty()},
+            {"rebalance_interval_ms", rebalance_interval_ms.value != 0U},
+        }};
+        std::string ignored;
+        for (const auto& [option, set] : options) {
+            if (set) {
+                ignored += ignored.empty() ? std::string(option) : std::format(", {}", option);
+            }
+        }
+        if (!ignored.empty()) {
+            this->emitErrorMessage("shared_pool", gr::Error{std::format("ignoring {} in shared_pool '{}' mode", ignored, shared_pool.value)});
+        }
+    }
+
+    [[nodiscard]] SharedWorkerPool::StepResult sharedStep(std::size_t runnerId, SharedJobState& job, gr::Sequence& nRunningJobs) {
+        using enum gr::lifecycle::State;
+        using enum SharedWorkerPool::StepResult;
+
+        const auto finish = [&nRunningJobs] {
+            std::ignore = nRunningJobs.subAndGet(1UZ);
+            nRunningJobs.notify_all();
+            return Finished;
+        };
+
+        const bool hasMessagesToProcess = job.messageRatioCount == 0UZ || this->msgIn.available() > 0UZ || this->_fromChildMessagePort.available() > 0UZ;
+        if (hasMessagesToProcess) {
+            if (runnerId == 0UZ || nRunningJobs.value() == 0UZ) {
+                this->processScheduledMessages();
+            }
+            this->cleanupZombieBlocks(job.blocks);
+            this->adoptBlocks(runnerId, job.blocks);
+            std::ranges::for_each(job.blocks, &gr::BlockModel::processScheduledMessages);
+            job.messageRatioCount++;
+        } else if (std::has_single_bit(this->process_stream_to_message_ratio.value)) {
+            job.messageRatioCount = (job.messageRatioCount + 1U) & (this->process_stream_to_message_ratio.value - 1U);
+        } else {
+            job.messageRatioCount = (job.messageRatioCount + 1U) % this->process_stream_to_message_ratio.value;
+        }
+
+        const gr::lifecycle::State activeState = this->state();
+        if (!gr::lifecycle::isActive(activeState)) {
+            return finish();
+        }
+        if (activeState != RUNNING) {
+            job.messageRatioCount = 0UZ;
+            return Idle;
+        }
+        if (gr::atomic_ref(this->_workQuiescenceRequested).load_acquire()) {
+            return Idle;
+        }
+        gr::atomic_ref(this->_nWorkersInWork).fetch_add(1UZ);
+        if (gr::atomic_ref(this->_workQuiescenceRequested).load_acquire()) {
+            gr::atomic_ref(this->_nWorkersInWork).fetch_sub(1UZ);
+            return Idle;
+        }
+        const gr::work::Result result = this->traverseBlockListOnce(job.blocks);
+        gr::atomic_ref(this->_nWorkersInWork).fetch_sub(1UZ);
+
+        if (result.status == gr::work::Status::DONE) {
+            return finish();
+        }
+        if (result.status == gr::work::Status::ERROR) {
+            this->emitErrorMessageIfAny("LifecycleState (ERROR)", this->changeStateTo(ERROR));
+            return finish();
+        }
+        return result.performed_work != 0UZ ? Progress : Idle;
+    }
+
+    void planChunks(const std::vector<std::shared_ptr<detail::BlockSlot>>& slots) const {
+        const std::size_t cacheBytes = _cacheSizes.level(static_cast<std::size_t>(chunk_cache_level.value));
+        for (const std::shared_ptr<detail::BlockSlot>& slot : slots) {
+            if (!slot->tryClaim()) {
+                continue; // re-planned on the next message pass
+            }
+            const gr::property_map& meta           = slot->block->metaInformation();
+            const double            fixedBytes     = detail::lookupNumeric(meta, chunking::kWorkingSetFixedBytes).value_or(0.0);
+            const double            bytesPerSample = detail::lookupNumeric(meta, chunking::kWorkingSetBytesPerSample).value_or(0.0);
+            slot->release();
+
+            const std::size_t chunk = chunking::fitChunk(fixedBytes, bytesPerSample, cacheBytes, static_cast<double>(chunk_cache_fill.value), static_cast<std::size_t>(min_chunk_samples.value));
+            slot->requestedWork.store(chunk, std::memory_order_relaxed);
+            slot->workingSetBytes.store(bytesPerSample > 0.0 ? static_cast<std::size_t>(fixedBytes + bytesPerSample * static_cast<double>(chunk)) : 0UZ, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] double blockCost(const gr::BlockModel& block) const {
+        const std::optional<double> cost = detail::lookupNumeric(block_costs.value, block.uniqueName());
+        return cost && *cost > 0.0 ? *cost : 1.0;
+    }
+
+    // Partitions the flat graph blocks listed in `members`; batches of the returned plan hold flat graph indices.
+    [[nodiscard]] partition::Plan planPartition(const gr::Graph& flatGraph, std::span<const std::size_t> members, std::size_t nBatches) const {
+        const auto&                                            blocks = flatGraph.blocks();
+        std::unordered_map<const gr::BlockModel*, std::size_t> indexOf;
+        std::vector<double>                                    memberCost;
+        memberCost.reserve(members.size());
+        for (const std::size_t blockIndex : members) {
+            indexOf.emplace(blocks[blockIndex].get(), memberCost.size());
+            memberCost.push_back(blockCost(*blocks[blockIndex]));
+        }
+
+        std::vector<partition::Edge> edges;
+        edges.reserve(flatGraph.edges().size());
+        for (const auto& edge : flatGraph.edges()) {
+            const auto source      = indexOf.find(detail::blockAddress(edge.sourceBlock()));
+            const auto destination = indexOf.find(detail::blockAddress(edge.destinationBlock()));
+            if (source == indexOf.end() || destination == indexOf.end()) {
+                continue;
+            }
+            const std::string key       = std::format("{}->{}", blocks[members[source->second]]->uniqueName(), blocks[members[destination->second]]->uniqueName());
+            const double      bandwidth = detail::lookupNumeric(edge_bandwidth.value, key).value_or(edge.weight() > 0 ? static_cast<double>(edge.weight()) : 1.0);
+            edges.push_back({.source = source->second, .destination = destination->second, .bandwidth = bandwidth});
+        }
+
+        partition::Plan plan;
+        switch (partition::parseStrategy(partition_strategy.value)) {
+        case partition::Strategy::TrafficAware: plan = partition::trafficAware(memberCost, edges, nBatches, static_cast<double>(partition_imbalance.value)); break;
+        case partition::Strategy::RoundRobin: plan = partition::roundRobin(memberCost, edges, nBatches); break;
+        }
+        for (std::vector<std::size_t>& batch : plan.batches) {
+            std::ranges::transform(batch, batch.begin(), [members](std::size_t member) { return members[member]; });
+        }
+        return plan;
+    }
+
+    [[nodiscard]] std::shared_ptr<detail::BlockSlot> makeSlot(const std::shared_ptr<gr::BlockModel>& block) const {
+        auto                        slot         = std::make_shared<detail::BlockSlot>(block);
+        const std::optional<double> minWorkItems = detail::lookupNumeric(min_work_items.value, block->uniqueName());
+        slot->minWorkItems                       = minWorkItems && *minWorkItems > 1.0 ? static_cast<std::size_t>(*minWorkItems) : 0UZ;
+        return slot;
+    }
+
+    [[nodiscard]] std::shared_ptr<detail::BlockSlot> slotFor(const std::shared_ptr<gr::BlockModel>& block) {
+        std::lock_guard slotGuard(_slotsMutex);
+        auto [it, inserted] = _blockSlots.try_emplace(block.get(), nullptr);
+        if (inserted || it->second->block != block) {
+            it->second = makeSlot(block);
+        }
+        return it->second;
+    }
+
+    void publishSlots(std::size_t runnerId, const std::vector<std::shared_ptr<detail::WorkerQueue>>& queues, const std::vector<std::shared_ptr<gr::BlockModel>>& blocks, std::vector<std::shared_ptr<detail::BlockSlot>>& localSlots) {
+        localSlots.clear();
+        localSlots.reserve(blocks.size());
+        for (const std::shared_ptr<gr::BlockModel>& block : blocks) {
+            localSlots.push_back(slotFor(block));
+        }
+        if (runnerId < queues.size()) {
+            std::lock_guard queueGuard(queues[runnerId]->mutex);
+            queues[runnerId]->slots = localSlots;
+        }
+    }
+
+    static void processScheduledMessagesClaimed(const std::vector<std::shared_ptr<detail::BlockSlot>>& slots, bool controlThread = false) {
+        for (const std::shared_ptr<detail::BlockSlot>& slot : slots) {
+            if (slot->tryClaim()) { // a block currently executed by a thief handles its messages on the next pass
+                slot->heldByControl.store(controlThread, std::memory_order_relaxed);
+                slot->block->processScheduledMessages();
+                slot->heldByControl.store(false, std::memory_order_relaxed);
+                slot->release();
+            }
+        }
+    }
+
+    void publishTelemetry() {
+        const Telemetry  snapshot = telemetry();
+        gr::property_map blocks;
+        for (const BlockTelemetry& block : snapshot.blocks) {
+            detail::setEntry(blocks, block.name, gr::property_map{{"work_calls", block.workCalls}, {"performed_work", block.performedWork}, {"work_time_s", block.workSeconds}});
+        }
+        gr::property_map workers;
+        for (std::size_t worker = 0UZ; worker < snapshot.workers.size(); ++worker) {
+            const WorkerTelemetry& counters = snapshot.workers[worker];
+            detail::setEntry(workers, std::to_string(worker), gr::property_map{{"cycles", counters.cycles}, {"idle_cycles", counters.idleCycles}, {"backoff_time_s", counters.backoffSeconds}, {"steals", counters.steals}, {"parks", counters.parks}, {"wakeups", counters.wakeups}, {"realtime", counters.realtime}});
+        }
+        gr::sendMessage<gr::message::Command::Notify>(this->msgOut, this->unique_name, "telemetry", gr::property_map{{"blocks", std::move(blocks)}, {"workers", std::move(workers)}});
+    }
+
+    // Same contract as SchedulerBase::traverseBlockListOnce(), but skips blocks claimed by another worker or the control
+    // thread; the latter sets `yieldedToControl`.
+    [[nodiscard]] static gr::work::Result traverseSlotsOnce(const std::vector<std::shared_ptr<detail::BlockSlot>>& slots, bool telemetry, std::chrono::microseconds maxWorkDelay, bool& yieldedToControl) {
+        constexpr std::size_t requestedWork        = std::numeric_limits<std::size_t>::max();
+        std::size_t           performedWork        = 0UZ;
+        bool                  unfinishedBlockExist = false;
+        for (const std::shared_ptr<detail::BlockSlot>& slot : slots) {
+            if (!slot->tryClaim()) {
+                unfinishedBlockExist = true;
+                yieldedToControl     = yieldedToControl || slot->heldByControl.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (!detail::quantumReady(*slot, maxWorkDelay)) {
+                slot->release();
+                unfinishedBlockExist = true;
+                continue;
+            }
+            const gr::work::Result result = detail::workClaimed(*slot, telemetry);
+            slot->release();
+
+            performedWork += result.performed_work;
+            if (result.status == gr::work::Status::ERROR) {
+                return {requestedWork, performedWork, gr::work::Status::ERROR};
+            }
+            unfinishedBlockExist = unfinishedBlockExist || result.status != gr::work::Status::DONE;
+        }
+        return {requestedWork, performedWork, unfinishedBlockExist ? gr::work::Status::OK : gr::work::Status::DONE};
+    }
+
     void updateBackoff(std::size_t performedWork, std::size_t& inactiveCycleCount, std::size_t& backoffUs) const {
         if (performedWork != 0UZ) {
             inactiveCycleCount = 0UZ;
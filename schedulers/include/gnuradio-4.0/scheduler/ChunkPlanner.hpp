@@ -0,0 +1,103 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_CHUNKPLANNER_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_CHUNKPLANNER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <gnuradio-4.0/algorithm/dsp_kernels/WorkingSetHint.hpp>
+
+namespace gr::incubator::scheduler::chunking {
+
+/// meta_information keys through which blocks describe the memory they touch per work() call:
+/// `fixed + bytesPerSample * nInputSamples` (taps, history, and input plus output spans), published by the blocks
+/// through dsp_kernels::publishWorkingSetHint().
+inline constexpr std::string_view kWorkingSetFixedBytes     = dsp_kernels::kWorkingSetFixedBytes;
+inline constexpr std::string_view kWorkingSetBytesPerSample = dsp_kernels::kWorkingSetBytesPerSample;
+
+struct CacheSizes {
+    std::size_t l1d = 32UZ * 1024UZ;
+    std::size_t l2  = 1024UZ * 1024UZ;
+    std::size_t l3  = 8UZ * 1024UZ * 1024UZ;
+
+    [[nodiscard]] std::size_t level(std::size_t cacheLevel) const noexcept {
+        switch (cacheLevel) {
+        case 1UZ: return l1d;
+        case 2UZ: return l2;
+        default: return l3;
+        }
+    }
+};
+
+[[nodiscard]] inline std::size_t parseCacheSize(std::string_view text) noexcept {
+    std::size_t value    = 0UZ;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{}) {
+        return 0UZ;
+    }
+    switch (end != text.data() + text.size() ? *end : ' ') {
+    case 'K': return value * 1024UZ;
+    case 'M': return value * 1024UZ * 1024UZ;
+    case 'G': return value * 1024UZ * 1024UZ * 1024UZ;
+    default: return value;
+    }
+}
+
+/// Data/unified cache sizes of CPU 0 from sysfs, with conservative defaults where unavailable.
+[[nodiscard]] inline CacheSizes detectCacheSizes() {
+    CacheSizes      sizes;
+    std::error_code ec;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator("/sys/devices/system/cpu/cpu0/cache", ec)) {
+        if (!entry.path().filename().string().starts_with("index")) {
+            continue;
+        }
+        const auto read = [&entry](const char* name) {
+            std::ifstream file(entry.path() / name);
+            std::string   value;
+            std::getline(file, value);
+            return value;
+        };
+        if (read("type") == "Instruction") {
+            continue;
+        }
+        const std::size_t size = parseCacheSize(read("size"));
+        if (size == 0UZ) {
+            continue;
+        }
+        const std::string level = read("level");
+        if (level == "1") {
+            sizes.l1d = size;
+        } else if (level == "2") {
+            sizes.l2 = size;
+        } else if (level == "3") {
+            sizes.l3 = size;
+        }
+    }
+    return sizes;
+}
+
+/// Largest input chunk, a multiple of `quantum` and at least `minChunk`, whose working set fills at most
+/// `fill * cacheBytes`. Returns max size_t (no limit) for blocks without a per-sample footprint.
+[[nodiscard]] inline std::size_t fitChunk(double fixedBytes, double bytesPerSample, std::size_t cacheBytes, double fill, std::size_t minChunk, std::size_t quantum = 64UZ) noexcept {
+    if (!(bytesPerSample > 0.0)) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    const double budget  = static_cast<double>(cacheBytes) * std::clamp(fill, 0.0, 1.0) - std::max(0.0, fixedBytes);
+    const double samples = budget > 0.0 ? std::floor(budget / bytesPerSample) : 0.0;
+    std::size_t  chunk   = samples >= static_cast<double>(std::numeric_limits<std::size_t>::max() / 2UZ) ? std::numeric_limits<std::size_t>::max() / 2UZ : static_cast<std::size_t>(samples);
+    if (quantum > 1UZ) {
+        chunk -= chunk % quantum;
+    }
+    return std::max(chunk, std::max(1UZ, minChunk));
+}
+
+} // namespace gr::incubator::scheduler::chunking
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_CHUNKPLANNER_HPP
@@ -0,0 +1,173 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_GRAPHPARTITION_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_GRAPHPARTITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace gr::incubator::scheduler::partition {
+
+enum class Strategy { RoundRobin, TrafficAware };
+
+[[nodiscard]] constexpr Strategy parseStrategy(std::string_view name) noexcept { return name == "traffic_aware" ? Strategy::TrafficAware : Strategy::RoundRobin; }
+
+struct Edge {
+    std::size_t source;
+    std::size_t destination;
+    double      bandwidth; // relative traffic, e.g. samples/s * sizeof(T)
+};
+
+struct Plan {
+    std::vector<std::vector<std::size_t>> batches;            // block indices per worker, ascending
+    std::vector<double>                   batchCost;          // summed block cost per worker
+    double                                cutBandwidth = 0.0; // traffic crossing worker boundaries
+};
+
+namespace detail {
+
+struct DisjointSets {
+    explicit DisjointSets(std::size_t n) : parent(n) { std::iota(parent.begin(), parent.end(), 0UZ); }
+
+    std::vector<std::size_t> parent;
+
+    [[nodiscard]] std::size_t find(std::size_t index) noexcept {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index         = parent[index];
+        }
+        return index;
+    }
+};
+
+inline void finalise(Plan& plan, std::span<const double> blockCost, std::span<const Edge> edges, const std::vector<std::size_t>& assignment) {
+    std::erase_if(plan.batches, [](const std::vector<std::size_t>& batch) { return batch.empty(); });
+    if (plan.batches.empty()) {
+        plan.batches.emplace_back(); // keep one (idle) worker for an empty graph
+    }
+    plan.batchCost.assign(plan.batches.size(), 0.0);
+    std::vector<std::size_t> batchOf(assignment.size(), 0UZ);
+    for (std::size_t batchIndex = 0UZ; batchIndex < plan.batches.size(); ++batchIndex) {
+        std::ranges::sort(plan.batches[batchIndex]);
+        for (const std::size_t block : plan.batches[batchIndex]) {
+            batchOf[block] = batchIndex;
+            plan.batchCost[batchIndex] += blockCost[block];
+        }
+    }
+    plan.cutBandwidth = 0.0;
+    for (const Edge& edge : edges) {
+        if (edge.source < batchOf.size() && edge.destination < batchOf.size() && batchOf[edge.source] != batchOf[edge.destination]) {
+            plan.cutBandwidth += edge.bandwidth;
+        }
+    }
+}
+
+} // namespace detail
+
+/// Deals blocks into batches by index modulo, the historical BlockingBackoff plan.
+[[nodiscard]] inline Plan roundRobin(std::span<const double> blockCost, std::span<const Edge> edges, std::size_t nBatches) {
+    const std::size_t nBlocks = blockCost.size();
+    nBatches                  = std::max(1UZ, std::min(nBatches, nBlocks));
+
+    Plan                     plan;
+    std::vector<std::size_t> assignment(nBlocks, 0UZ);
+    plan.batches.resize(nBatches);
+    for (std::size_t block = 0UZ; block < nBlocks; ++block) {
+        assignment[block] = block % nBatches;
+        plan.batches[block % nBatches].push_back(block);
+    }
+    detail::finalise(plan, blockCost, edges, assignment);
+    return plan;
+}
+
+/// Greedy traffic-aware partitioning.
+///
+/// Edges are contracted in order of decreasing bandwidth as long as the merged cluster stays below the per-worker
+/// capacity `max(maxBlockCost, totalCost / nBatches) * (1 + imbalance)`. The resulting clusters are then placed
+/// largest first on the worker with the highest traffic affinity that still has room, falling back to the least
+/// loaded worker. Neighbours exchanging the most data therefore share a worker (and its caches) unless doing so
+/// would overload it.
+[[nodiscard]] inline Plan trafficAware(std::span<const double> blockCost, std::span<const Edge> edges, std::size_t nBatches, double imbalance = 0.25) {
+    const std::size_t nBlocks = blockCost.size();
+    nBatches                  = std::max(1UZ, std::min(nBatches, nBlocks));
+    if (nBlocks == 0UZ) {
+        return roundRobin(blockCost, edges, nBatches);
+    }
+
+    const double totalCost = std::reduce(blockCost.begin(), blockCost.end(), 0.0);
+    const double maxCost   = *std::ranges::max_element(blockCost);
+    const double capacity  = std::max(maxCost, totalCost / static_cast<double>(nBatches)) * (1.0 + std::max(0.0, imbalance));
+
+    std::vector<Edge> sortedEdges(edges.begin(), edges.end());
+    std::erase_if(sortedEdges, [nBlocks](const Edge& edge) { return edge.source >= nBlocks || edge.destination >= nBlocks || edge.source == edge.destination; });
+    std::ranges::stable_sort(sortedEdges, std::ranges::greater{}, &Edge::bandwidth);
+
+    detail::DisjointSets clusters(nBlocks);
+    std::vector<double>  clusterCost(blockCost.begin(), blockCost.end());
+    for (const Edge& edge : sortedEdges) {
+        const std::size_t a = clusters.find(edge.source);
+        const std::size_t b = clusters.find(edge.destination);
+        if (a != b && clusterCost[a] + clusterCost[b] <= capacity) {
+            clusters.parent[b] = a;
+            clusterCost[a] += clusterCost[b];
+        }
+    }
+
+    std::vector<std::size_t> roots;
+    for (std::size_t block = 0UZ; block < nBlocks; ++block) {
+        if (clusters.find(block) == block) {
+            roots.push_back(block);
+        }
+    }
+    std::ranges::stable_sort(roots, std::ranges::greater{}, [&clusterCost](std::size_t root) { return clusterCost[root]; });
+
+    std::vector<std::size_t> assignment(nBlocks, nBatches);
+    std::vector<double>      load(nBatches, 0.0);
+    std::vector<double>      affinity(nBatches, 0.0);
+    for (const std::size_t root : roots) {
+        std::ranges::fill(affinity, 0.0);
+        for (const Edge& edge : sortedEdges) {
+            const bool fromCluster = clusters.find(edge.source) == root;
+            const bool toCluster   = clusters.find(edge.destination) == root;
+            if (fromCluster != toCluster) {
+                const std::size_t other = fromCluster ? edge.destination : edge.source;
+                if (assignment[other] < nBatches) {
+                    affinity[assignment[other]] += edge.bandwidth;
+                }
+            }
+        }
+
+        std::size_t target = nBatches;
+        for (std::size_t batch = 0UZ; batch < nBatches; ++batch) {
+            if (load[batch] + clusterCost[root] > capacity) {
+                continue;
+            }
+            if (target == nBatches || affinity[batch] > affinity[target] || (affinity[batch] == affinity[target] && load[batch] < load[target])) {
+                target = batch;
+            }
+        }
+        if (target == nBatches) {
+            target = static_cast<std::size_t>(std::distance(load.begin(), std::ranges::min_element(load)));
+        }
+        load[target] += clusterCost[root];
+        for (std::size_t block = 0UZ; block < nBlocks; ++block) {
+            if (clusters.find(block) == root) {
+                assignment[block] = target;
+            }
+        }
+    }
+
+    Plan plan;
+    plan.batches.resize(nBatches);
+    for (std::size_t block = 0UZ; block < nBlocks; ++block) {
+        plan.batches[assignment[block]].push_back(block);
+    }
+    detail::finalise(plan, blockCost, edges, assignment);
+    return plan;
+}
+
+} // namespace gr::incubator::scheduler::partition
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_GRAPHPARTITION_HPP
@@ -0,0 +1,78 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_IOWAKEUP_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_IOWAKEUP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gr::incubator::scheduler {
+
+/// Process-wide wake hook between I/O threads and schedulers.
+///
+/// Blocks whose data arrives on a thread of their own (the ZMQ reactor, SDR reader threads) cannot publish into their
+/// output port from there, so a scheduler whose workers are parked would only see the data after park_timeout_us.
+/// Schedulers that park subscribe a callback that wakes their workers, and the I/O thread calls `notify()` once the
+/// data is where the block's next work() call will find it. Without subscribers `notify()` is a single relaxed load.
+class IoWakeup {
+public:
+    using Callback = std::function<void()>; // must not throw
+
+    /// Keeps `callback` subscribed for its lifetime. Unsubscribing waits for a running notify(), so the callback may
+    /// capture an object that outlives the subscription.
+    class Subscription {
+        std::uint64_t _id;
+
+    public:
+        explicit Subscription(Callback callback) : _id(instance().subscribe(std::move(callback))) {}
+        Subscription(const Subscription&)            = delete;
+        Subscription& operator=(const Subscription&) = delete;
+        ~Subscription() { instance().unsubscribe(_id); }
+    };
+
+    /// Wakes every subscribed scheduler; called by I/O threads after new input became available.
+    static void notify() noexcept { instance().notifyAll(); }
+
+    [[nodiscard]] static std::size_t subscribers() noexcept { return instance()._nSubscribers.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex                                      _mutex;
+    std::vector<std::pair<std::uint64_t, Callback>> _callbacks;
+    std::uint64_t                                   _nextId = 0U;
+    std::atomic<std::size_t>                        _nSubscribers{0UZ};
+
+    [[nodiscard]] static IoWakeup& instance() noexcept {
+        static IoWakeup hub;
+        return hub;
+    }
+
+    [[nodiscard]] std::uint64_t subscribe(Callback callback) {
+        std::lock_guard guard(_mutex);
+        _callbacks.emplace_back(_nextId, std::move(callback));
+        _nSubscribers.store(_callbacks.size(), std::memory_order_relaxed);
+        return _nextId++;
+    }
+
+    void unsubscribe(std::uint64_t id) noexcept {
+        std::lock_guard guard(_mutex);
+        std::erase_if(_callbacks, [id](const auto& entry) { return entry.first == id; });
+        _nSubscribers.store(_callbacks.size(), std::memory_order_relaxed);
+    }
+
+    void notifyAll() noexcept {
+        if (_nSubscribers.load(std::memory_order_relaxed) == 0UZ) {
+            return;
+        }
+        std::lock_guard guard(_mutex);
+        for (const auto& [id, callback] : _callbacks) {
+            callback();
+        }
+    }
+};
+
+} // namespace gr::incubator::scheduler
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_IOWAKEUP_HPP
@@ -0,0 +1,123 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_REALTIMEPRIORITY_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_REALTIMEPRIORITY_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <expected>
+#include <format>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#include <gnuradio-4.0/Message.hpp>
+
+namespace gr::incubator::scheduler::realtime {
+
+enum class Policy { None, Fifo, RoundRobin };
+
+/// Maps the `realtime_policy` setting ('fifo', 'rr' or 'none') onto a scheduling class, anything else is an error.
+[[nodiscard]] inline std::expected<Policy, gr::Error> parsePolicy(std::string_view name) {
+    if (name == "fifo") {
+        return Policy::Fifo;
+    }
+    if (name == "rr") {
+        return Policy::RoundRobin;
+    }
+    if (name == "none") {
+        return Policy::None;
+    }
+    return std::unexpected(gr::Error{std::format("unknown real-time policy '{}', expected 'fifo', 'rr' or 'none'", name)});
+}
+
+/// Splits a comma separated list of block name patterns, dropping surrounding blanks and empty entries.
+[[nodiscard]] inline std::vector<std::string> splitPatterns(std::string_view list) {
+    std::vector<std::string> patterns;
+    while (!list.empty()) {
+        const std::size_t comma   = list.find(',');
+        std::string_view  pattern = list.substr(0UZ, comma);
+        list                      = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1UZ);
+        while (!pattern.empty() && pattern.front() == ' ') {
+            pattern.remove_prefix(1UZ);
+        }
+        while (!pattern.empty() && pattern.back() == ' ') {
+            pattern.remove_suffix(1UZ);
+        }
+        if (!pattern.empty()) {
+            patterns.emplace_back(pattern);
+        }
+    }
+    return patterns;
+}
+
+/// True if `uniqueName` (which embeds the block type, e.g. "gr::incubator::soapy::SoapyRx<...>#3") contains one of `patterns`.
+[[nodiscard]] inline bool matchesAny(std::string_view uniqueName, const std::vector<std::string>& patterns) noexcept {
+    return std::ranges::any_of(patterns, [uniqueName](const std::string& pattern) { return uniqueName.find(pattern) != std::string_view::npos; });
+}
+
+/// Locks current and future pages of the process into RAM (mlockall). Process-wide and never undone.
+[[nodiscard]] inline std::expected<void, gr::Error> lockProcessMemory() {
+#if defined(__linux__)
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        return std::unexpected(gr::Error{std::format("mlockall() refused: {}", std::system_category().message(errno))});
+    }
+    return {};
+#else
+    return std::unexpected(gr::Error{"locking process memory is only supported on Linux"});
+#endif
+}
+
+/// Raises the calling thread to a real-time scheduling class and restores the previous class on destruction, since
+/// pool threads are reused by other tasks. Requires CAP_SYS_NICE or a suitable RLIMIT_RTPRIO.
+class ScopedRealtimePriority {
+#if defined(__linux__)
+    int         _previousPolicy = SCHED_OTHER;
+    sched_param _previousParam{};
+    bool        _restore = false;
+#endif
+
+public:
+    ScopedRealtimePriority()                                         = default;
+    ScopedRealtimePriority(const ScopedRealtimePriority&)            = delete;
+    ScopedRealtimePriority& operator=(const ScopedRealtimePriority&) = delete;
+
+    ~ScopedRealtimePriority() {
+#if defined(__linux__)
+        if (_restore) {
+            pthread_setschedparam(pthread_self(), _previousPolicy, &_previousParam);
+        }
+#endif
+    }
+
+    /// Moves the calling thread into `policy` (Policy::None leaves it untouched). Fails where unsupported or if the kernel refused.
+    [[nodiscard]] std::expected<void, gr::Error> apply(Policy policy, int priority) {
+        if (policy == Policy::None) {
+            return {};
+        }
+#if defined(__linux__)
+        const int nativePolicy = policy == Policy::Fifo ? SCHED_FIFO : SCHED_RR;
+        if (!_restore && pthread_getschedparam(pthread_self(), &_previousPolicy, &_previousParam) == 0) {
+            _restore = true;
+        }
+        sched_param param{};
+        param.sched_priority = std::clamp(priority, sched_get_priority_min(nativePolicy), sched_get_priority_max(nativePolicy));
+        if (const int error = pthread_setschedparam(pthread_self(), nativePolicy, &param); error != 0) {
+            return std::unexpected(gr::Error{std::format("{} priority {} refused: {}", policy == Policy::Fifo ? "SCHED_FIFO" : "SCHED_RR", param.sched_priority, std::system_category().message(error))});
+        }
+        return {};
+#else
+        static_cast<void>(priority);
+        return std::unexpected(gr::Error{"real-time scheduling classes are only supported on Linux"});
+#endif
+    }
+};
+
+} // namespace gr::incubator::scheduler::realtime
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_REALTIMEPRIORITY_HPP
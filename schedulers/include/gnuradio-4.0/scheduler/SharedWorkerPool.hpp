@@ -0,0 +1,200 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_SHAREDWORKERPOOL_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_SHAREDWORKERPOOL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gr::incubator::scheduler {
+
+/// Bounded set of threads executing the job lists of many schedulers (one job per list).
+///
+/// A job is a step function that runs one pass over its blocks. Steps of one job never run concurrently. Threads
+/// pick the runnable job with the smallest virtual time (stride scheduling): every step advances a job's virtual time
+/// by its wall time divided by its weight, so CPU time is shared in proportion to the weights. Idle jobs back off
+/// exponentially and are not picked before their back-off expired.
+class SharedWorkerPool {
+public:
+    using clock = std::chrono::steady_clock;
+
+    enum class StepResult { Progress, Idle, Finished };
+    using Step       = std::function<StepResult()>;
+    using TimeSource = clock::time_point (*)() noexcept; // measures step times; a manual clock makes the accounting exact
+
+    struct JobOptions {
+        std::string               name;
+        double                    weight         = 1.0;
+        std::size_t               idleSpinCount  = 2UZ;
+        std::chrono::microseconds initialBackoff = std::chrono::microseconds(50);
+        std::chrono::microseconds maxBackoff     = std::chrono::microseconds(2000);
+    };
+
+    struct JobStats {
+        std::string name;
+        double      weight   = 1.0;
+        double      cpuShare = 0.0; // fraction of the busy time of all jobs
+    };
+
+    explicit SharedWorkerPool(std::size_t nThreads = 0UZ, TimeSource now = &clock::now) : _now(now) {
+        const std::size_t n = resolveThreads(nThreads);
+        _threads.reserve(n);
+        for (std::size_t i = 0UZ; i < n; ++i) {
+            _threads.emplace_back([this](std::stop_token stopToken) { run(stopToken); });
+        }
+    }
+
+    SharedWorkerPool(const SharedWorkerPool&)            = delete;
+    SharedWorkerPool& operator=(const SharedWorkerPool&) = delete;
+
+    ~SharedWorkerPool() {
+        for (std::jthread& thread : _threads) {
+            thread.request_stop();
+        }
+        _condition.notify_all();
+        _threads.clear(); // joins
+    }
+
+    /// Process-wide pool registered under `name` and its thread count `nThreads` (0: hardware concurrency), created on
+    /// first use and destroyed when the last scheduler using it lets go. Requests for the same name with a different
+    /// thread count get a pool of their own rather than silently sharing one of another size.
+    [[nodiscard]] static std::shared_ptr<SharedWorkerPool> named(std::string_view name, std::size_t nThreads = 0UZ) {
+        static std::mutex                                                          registryMutex;
+        static std::map<std::string, std::weak_ptr<SharedWorkerPool>, std::less<>> registry;
+
+        const std::size_t threads = resolveThreads(nThreads);
+        const std::string key     = std::format("{}/{}", name, threads);
+        std::lock_guard   lock(registryMutex);
+        auto              it = registry.find(key);
+        if (it != registry.end()) {
+            if (std::shared_ptr<SharedWorkerPool> pool = it->second.lock()) {
+                return pool;
+            }
+        }
+        auto pool = std::make_shared<SharedWorkerPool>(threads);
+        registry.insert_or_assign(key, pool);
+        return pool;
+    }
+
+    void submit(Step step, JobOptions options) {
+        {
+            std::lock_guard lock(_mutex);
+            auto            job = std::make_shared<Job>();
+            job->step           = std::move(step);
+            job->options        = std::move(options);
+            job->options.weight = std::max(job->options.weight, 1e-3);
+            job->virtualTime    = minimumVirtualTime(); // joins at the front, without credit for the time it was absent
+            _jobs.push_back(std::move(job));
+        }
+        _condition.notify_one();
+    }
+
+    [[nodiscard]] std::size_t nThreads() const noexcept { return _threads.size(); }
+
+    [[nodiscard]] std::size_t nJobs() const {
+        std::lock_guard lock(_mutex);
+        return _jobs.size();
+    }
+
+    [[nodiscard]] std::vector<JobStats> jobStats() const {
+        std::lock_guard       lock(_mutex);
+        std::vector<JobStats> stats;
+        double                total = 0.0;
+        for (const std::shared_ptr<Job>& job : _jobs) {
+            total += job->busySeconds;
+        }
+        for (const std::shared_ptr<Job>& job : _jobs) {
+            stats.push_back({.name = job->options.name, .weight = job->options.weight, .cpuShare = total > 0.0 ? job->busySeconds / total : 0.0});
+        }
+        return stats;
+    }
+
+private:
+    struct Job {
+        Step                      step;
+        JobOptions                options;
+        double                    virtualTime = 0.0;
+        double                    busySeconds = 0.0;
+        bool                      running     = false;
+        std::size_t               idleSteps   = 0UZ;
+        std::chrono::microseconds backoff{0};
+        clock::time_point         notBefore{};
+    };
+
+    TimeSource                        _now;
+    mutable std::mutex                _mutex;
+    std::condition_variable_any       _condition;
+    std::vector<std::shared_ptr<Job>> _jobs;
+    std::vector<std::jthread>         _threads; // last: joined before the job list goes away
+
+    [[nodiscard]] static std::size_t resolveThreads(std::size_t nThreads) noexcept { return nThreads != 0UZ ? nThreads : std::max(1U, std::thread::hardware_concurrency()); }
+
+    [[nodiscard]] double minimumVirtualTime() const noexcept {
+        double minimum = std::numeric_limits<double>::max();
+        for (const std::shared_ptr<Job>& job : _jobs) {
+            minimum = std::min(minimum, job->virtualTime);
+        }
+        return _jobs.empty() ? 0.0 : minimum;
+    }
+
+    void run(std::stop_token stopToken) {
+        std::unique_lock lock(_mutex);
+        while (!stopToken.stop_requested()) {
+            const clock::time_point now = _now();
+            std::shared_ptr<Job>    next;
+            clock::time_point       wakeUp = now + std::chrono::milliseconds(1);
+            for (const std::shared_ptr<Job>& job : _jobs) {
+                if (job->running) {
+                    continue;
+                }
+                if (job->notBefore > now) {
+                    wakeUp = std::min(wakeUp, job->notBefore);
+                    continue;
+                }
+                if (!next || job->virtualTime < next->virtualTime) {
+                    next = job;
+                }
+            }
+            if (!next) {
+                _condition.wait_for(lock, stopToken, wakeUp - now, [] { return false; });
+                continue;
+            }
+
+            next->running = true;
+            lock.unlock();
+            const clock::time_point start  = _now();
+            const StepResult        result = next->step();
+            const double            busy   = std::chrono::duration<double>(_now() - start).count();
+            lock.lock();
+
+            next->running = false;
+            next->busySeconds += busy;
+            next->virtualTime += busy / next->options.weight;
+            if (result == StepResult::Finished) {
+                std::erase(_jobs, next);
+            } else if (result == StepResult::Progress) {
+                next->idleSteps = 0UZ;
+                next->backoff   = std::chrono::microseconds(0);
+            } else if (++next->idleSteps > next->options.idleSpinCount) {
+                next->backoff   = next->backoff.count() == 0 ? next->options.initialBackoff : std::min(next->backoff * 2, next->options.maxBackoff);
+                next->notBefore = _now() + next->backoff;
+            }
+        }
+    }
+};
+
+} // namespace gr::incubator::scheduler
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_SHAREDWORKERPOOL_HPP
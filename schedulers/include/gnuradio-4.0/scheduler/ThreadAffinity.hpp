@@ -0,0 +1,201 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_THREADAFFINITY_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_THREADAFFINITY_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <gnuradio-4.0/Message.hpp>
+
+namespace gr::incubator::scheduler::affinity {
+
+#if defined(__linux__)
+inline constexpr int kMaxCpus = CPU_SETSIZE;
+#else
+inline constexpr int kMaxCpus = 1024;
+#endif
+
+/// Parses a Linux CPU list as used by `isolcpus=`, cpusets and sysfs, e.g. "0-3,8,10-11". Malformed entries are ignored,
+/// CPUs beyond what a cpu_set_t can hold (kMaxCpus) are an error.
+[[nodiscard]] inline std::expected<std::vector<int>, gr::Error> parseCpuList(std::string_view list) {
+    const std::string_view fullList = list;
+    std::vector<int>       cpus;
+    while (!list.empty()) {
+        const std::size_t comma = list.find(',');
+        std::string_view  token = list.substr(0UZ, comma);
+        list                    = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1UZ);
+
+        while (!token.empty() && (token.front() == ' ' || token.front() == '\n')) {
+            token.remove_prefix(1UZ);
+        }
+        while (!token.empty() && (token.back() == ' ' || token.back() == '\n')) {
+            token.remove_suffix(1UZ);
+        }
+        const std::size_t dash       = token.find('-');
+        int               first      = -1;
+        int               last       = -1;
+        const auto        firstParse = std::from_chars(token.data(), token.data() + token.substr(0UZ, dash).size(), first);
+        const auto        lastParse  = dash == std::string_view::npos ? firstParse : std::from_chars(token.data() + dash + 1UZ, token.data() + token.size(), last);
+        if (firstParse.ec == std::errc::result_out_of_range || lastParse.ec == std::errc::result_out_of_range || first >= kMaxCpus || last >= kMaxCpus) {
+            return std::unexpected(gr::Error{std::format("CPU list '{}' names CPUs beyond the supported {}", fullList, kMaxCpus)});
+        }
+        if (firstParse.ec != std::errc{} || lastParse.ec != std::errc{}) {
+            continue;
+        }
+        if (dash == std::string_view::npos) {
+            last = first;
+        }
+        for (int cpu = first; cpu >= 0 && cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::ranges::sort(cpus);
+    const auto duplicates = std::ranges::unique(cpus);
+    cpus.erase(duplicates.begin(), duplicates.end());
+    return cpus;
+}
+
+[[nodiscard]] inline std::optional<std::string> readFirstLine(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::string   line;
+    if (!file || !std::getline(file, line)) {
+        return std::nullopt;
+    }
+    return line;
+}
+
+/// CPUs removed from the general scheduler domain via the `isolcpus=` kernel parameter (empty if none or unknown).
+[[nodiscard]] inline std::vector<int> isolatedCpus() { return parseCpuList(readFirstLine("/sys/devices/system/cpu/isolated").value_or(std::string{})).value_or(std::vector<int>{}); }
+
+/// NUMA node owning `cpu`, or 0 on single-node systems and where sysfs is not available.
+[[nodiscard]] inline int numaNodeOf(int cpu) {
+    std::error_code                           ec;
+    const std::filesystem::directory_iterator nodes("/sys/devices/system/node", ec);
+    if (ec) {
+        return 0;
+    }
+    for (const std::filesystem::directory_entry& entry : nodes) {
+        const std::string name = entry.path().filename().string();
+        int               node = -1;
+        if (!name.starts_with("node") || std::from_chars(name.data() + 4, name.data() + name.size(), node).ec != std::errc{}) {
+            continue;
+        }
+        if (std::ranges::binary_search(parseCpuList(readFirstLine(entry.path() / "cpulist").value_or(std::string{})).value_or(std::vector<int>{}), cpu)) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+/// Resolves the `cpu_affinity` setting: "" (no pinning), "isolated" (the isolcpus set) or an explicit CPU list.
+[[nodiscard]] inline std::expected<std::vector<int>, gr::Error> resolveCpus(std::string_view spec) {
+    if (spec.empty()) {
+        return std::vector<int>{};
+    }
+    if (spec == "isolated") {
+        return isolatedCpus();
+    }
+    return parseCpuList(spec);
+}
+
+/// Stable-orders `cpus` by NUMA node so that consecutive workers (which exchange the most data under the
+/// traffic-aware plan) share a socket before spilling onto the next one.
+inline void orderByNumaNode(std::vector<int>& cpus) {
+    std::vector<std::pair<int, int>> keyed;
+    keyed.reserve(cpus.size());
+    for (const int cpu : cpus) {
+        keyed.emplace_back(numaNodeOf(cpu), cpu);
+    }
+    std::ranges::stable_sort(keyed, {}, &std::pair<int, int>::first);
+    std::ranges::transform(keyed, cpus.begin(), &std::pair<int, int>::second);
+}
+
+/// Affinity and memory policy of the calling thread, restored on destruction. Pool threads are reused by other tasks, so a pinned
+/// scheduler worker must not leak its pinning.
+class ScopedThreadPinning {
+#if defined(__linux__)
+    static constexpr int kMpolDefault = 0; // <linux/mempolicy.h>, not always installed
+    static constexpr int kMpolLocal   = 4;
+
+    cpu_set_t _previous{};
+    bool      _restore           = false;
+    bool      _resetMemoryPolicy = false;
+#endif
+
+public:
+    ScopedThreadPinning()                                      = default;
+    ScopedThreadPinning(const ScopedThreadPinning&)            = delete;
+    ScopedThreadPinning& operator=(const ScopedThreadPinning&) = delete;
+
+    ~ScopedThreadPinning() {
+#if defined(__linux__)
+        if (_restore) {
+            pthread_setaffinity_np(pthread_self(), sizeof(_previous), &_previous);
+        }
+        if (_resetMemoryPolicy) {
+            ::syscall(SYS_set_mempolicy, kMpolDefault, nullptr, 0UL);
+        }
+#endif
+    }
+
+    /// Pins the calling thread to `cpu`. Fails where unsupported or if the kernel refused.
+    [[nodiscard]] std::expected<void, gr::Error> pin(int cpu) {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return std::unexpected(gr::Error{std::format("CPU {} is outside the supported 0..{}", cpu, CPU_SETSIZE - 1)});
+        }
+        if (!_restore && pthread_getaffinity_np(pthread_self(), sizeof(_previous), &_previous) == 0) {
+            _restore = true;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<std::size_t>(cpu), &set);
+        if (const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); error != 0) {
+            return std::unexpected(gr::Error{std::format("pinning to CPU {} refused: {}", cpu, std::system_category().message(error))});
+        }
+        return {};
+#else
+        static_cast<void>(cpu);
+        return std::unexpected(gr::Error{"thread pinning is only supported on Linux"});
+#endif
+    }
+
+    /// Makes later page allocations of the calling thread prefer its NUMA node (MPOL_LOCAL). This is a thread policy only:
+    /// pages touched before, e.g. the stream buffers allocated while the graph was built, stay where they are.
+    [[nodiscard]] std::expected<void, gr::Error> preferLocalMemory() {
+#if defined(__linux__)
+        if (::syscall(SYS_set_mempolicy, kMpolLocal, nullptr, 0UL) != 0) {
+            if (errno == ENOSYS) {
+                return {}; // kernel without NUMA support: all memory is local
+            }
+            return std::unexpected(gr::Error{std::format("set_mempolicy(MPOL_LOCAL) refused: {}", std::system_category().message(errno))});
+        }
+        _resetMemoryPolicy = true;
+        return {};
+#else
+        return std::unexpected(gr::Error{"NUMA memory policies are only supported on Linux"});
+#endif
+    }
+};
+
+} // namespace gr::incubator::scheduler::affinity
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_THREADAFFINITY_HPP
@@ -0,0 +1,78 @@
+#ifndef GNURADIO_INCUBATOR_SCHEDULER_WAKEUPEVENT_HPP
+#define GNURADIO_INCUBATOR_SCHEDULER_WAKEUPEVENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gr::incubator::scheduler {
+
+/// Epoch based parking primitive for idle scheduler workers.
+///
+/// A worker samples `epoch()` before it scans its blocks and, if the scan made no progress, calls
+/// `wait(sampledEpoch, timeout)`. Any `notifyAll()` issued after the sample (e.g. by a worker that published
+/// samples, or by an I/O thread that saw its device become readable) bumps the epoch, so the wait either returns
+/// immediately or is woken: no notification between scan and park is lost. `notifyAll()` only enters the kernel
+/// when somebody is actually parked. On Linux this is a private futex, elsewhere a condition variable.
+class WakeupEvent {
+    std::atomic<std::uint32_t> _epoch{0U};
+    std::atomic<std::uint32_t> _nWaiters{0U};
+#if !defined(__linux__)
+    std::mutex              _mutex;
+    std::condition_variable _condition;
+#endif
+
+public:
+    WakeupEvent()                              = default;
+    WakeupEvent(const WakeupEvent&)            = delete;
+    WakeupEvent& operator=(const WakeupEvent&) = delete;
+
+    [[nodiscard]] std::uint32_t epoch() const noexcept { return _epoch.load(std::memory_order_seq_cst); }
+    [[nodiscard]] std::uint32_t waiters() const noexcept { return _nWaiters.load(std::memory_order_relaxed); }
+
+    void notifyAll() noexcept {
+        _epoch.fetch_add(1U, std::memory_order_seq_cst);
+        if (_nWaiters.load(std::memory_order_seq_cst) == 0U) {
+            return;
+        }
+#if defined(__linux__)
+        ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&_epoch), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#else
+        std::lock_guard lock(_mutex); // pairs with the epoch re-check under the lock in wait()
+        _condition.notify_all();
+#endif
+    }
+
+    /// Blocks until the epoch differs from `sampledEpoch` or `timeout` expired. Returns true if woken by a notification.
+    bool wait(std::uint32_t sampledEpoch, std::chrono::microseconds timeout) noexcept {
+        static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+        _nWaiters.fetch_add(1U, std::memory_order_seq_cst);
+#if defined(__linux__)
+        if (_epoch.load(std::memory_order_seq_cst) == sampledEpoch) {
+            const auto       seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            const ::timespec relative{.tv_sec = static_cast<std::time_t>(seconds.count()), .tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds).count())};
+            ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&_epoch), FUTEX_WAIT_PRIVATE, sampledEpoch, &relative, nullptr, 0); // EAGAIN, EINTR and ETIMEDOUT all just return
+        }
+#else
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait_for(lock, timeout, [&] { return _epoch.load(std::memory_order_seq_cst) != sampledEpoch; });
+        }
+#endif
+        _nWaiters.fetch_sub(1U, std::memory_order_relaxed);
+        return _epoch.load(std::memory_order_acquire) != sampledEpoch;
+    }
+};
+
+} // namespace gr::incubator::scheduler
+
+#endif // GNURADIO_INCUBATOR_SCHEDULER_WAKEUPEVENT_HPP
@@ -1,12 +1,217 @@
 #include <boost/ut.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <format>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include <gnuradio-4.0/Graph.hpp>
+#include <gnuradio-4.0/Message.hpp>
 #include <gnuradio-4.0/scheduler/BlockingBackoff.hpp>
+#include <gnuradio-4.0/scheduler/ChunkPlanner.hpp>
+#include <gnuradio-4.0/scheduler/GraphPartition.hpp>
+#include <gnuradio-4.0/scheduler/IoWakeup.hpp>
+#include <gnuradio-4.0/scheduler/RealtimePriority.hpp>
+#include <gnuradio-4.0/scheduler/SharedWorkerPool.hpp>
+#include <gnuradio-4.0/scheduler/ThreadAffinity.hpp>
+#include <gnuradio-4.0/scheduler/WakeupEvent.hpp>
 #include <gnuradio-4.0/testing/NullSources.hpp>
 
+namespace {
+
+// sourceA -> copyA -> sinkA next to sourceB -> sinkB: the multi job graph most scheduler modes are run on
+struct TwoChains {
+    gr::Graph                         graph;
+    gr::testing::CountingSink<float>* sinkA = nullptr;
+    gr::testing::CountingSink<float>* sinkB = nullptr;
+};
+
+[[nodiscard]] TwoChains makeTwoChains(gr::Size_t nSamples) {
+    TwoChains chains;
+    auto&     sourceA = chains.graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", nSamples}});
+    auto&     copyA   = chains.graph.emplaceBlock<gr::testing::Copy<float>>();
+    auto&     sinkA   = chains.graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+    auto&     sourceB = chains.graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", nSamples}});
+    auto&     sinkB   = chains.graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+    boost::ut::expect(chains.graph.connect<"out", "in">(sourceA, copyA).has_value());
+    boost::ut::expect(chains.graph.connect<"out", "in">(copyA, sinkA).has_value());
+    boost::ut::expect(chains.graph.connect<"out", "in">(sourceB, sinkB).has_value());
+    chains.sinkA = &sinkA;
+    chains.sinkB = &sinkB;
+    return chains;
+}
+
+// Messages published on `port` since the last call
+[[nodiscard]] std::vector<gr::Message> drainMessages(gr::MsgPortIn& port) {
+    auto&      reader   = port.streamReader();
+    const auto messages = reader.get<gr::SpanReleasePolicy::ProcessAll>(reader.available());
+    return {messages.begin(), messages.end()};
+}
+
+[[nodiscard]] bool hasError(const std::vector<gr::Message>& messages, std::string_view endpoint) {
+    return std::ranges::any_of(messages, [endpoint](const gr::Message& message) { return message.endpoint == endpoint && !message.data.has_value(); });
+}
+
+// Entry `key` of `map` if it holds a `T`
+template<typename T>
+[[nodiscard]] const T* entry(const gr::property_map& map, std::string_view key) {
+    const auto it = map.find(std::pmr::string(key));
+    return it == map.end() ? nullptr : it->second.get_if<T>();
+}
+
+// Copy publishing a working-set hint of 64 B per input sample, as the filter blocks do, and recording its largest input chunk
+template<typename T>
+struct HintedCopy : gr::Block<HintedCopy<T>> {
+    gr::PortIn<T>  in;
+    gr::PortOut<T> out;
+
+    GR_MAKE_REFLECTABLE(HintedCopy, in, out);
+
+    std::size_t maxChunk = 0UZ;
+
+    void settingsChanged(const gr::property_map& /*oldSettings*/, const gr::property_map& /*newSettings*/) {
+        auto& meta = this->meta_information.value;
+        meta.insert_or_assign(std::pmr::string(gr::incubator::scheduler::chunking::kWorkingSetBytesPerSample, meta.get_allocator().resource()), gr::pmt::Value(64.0));
+    }
+
+    template<typename TSpanIn, typename TSpanOut>
+    [[nodiscard]] gr::work::Status processBulk(const TSpanIn& inSpan, TSpanOut& outSpan) {
+        maxChunk = std::max(maxChunk, inSpan.size());
+        std::ranges::copy(inSpan, outSpan.begin());
+        return gr::work::Status::OK;
+    }
+};
+
+// Copy scaling by `gain`, publishing each applied gain for threads observing it while the block streams
+template<typename T>
+struct GainCopy : gr::Block<GainCopy<T>> {
+    gr::PortIn<T>  in;
+    gr::PortOut<T> out;
+
+    gr::Annotated<float, "gain", gr::Doc<"Scale factor">> gain = 1.F;
+
+    GR_MAKE_REFLECTABLE(GainCopy, in, out, gain);
+
+    std::atomic<float> appliedGain{1.F};
+
+    void settingsChanged(const gr::property_map& /*oldSettings*/, const gr::property_map& /*newSettings*/) { appliedGain.store(gain.value, std::memory_order_release); }
+
+    [[nodiscard]] constexpr T processOne(T input) const noexcept { return input * static_cast<T>(gain.value); }
+};
+
+// Copy busy-waiting `costNsPerSample` per sample, a block whose cost the test raises while the graph runs
+template<typename T>
+struct SpinningCopy : gr::Block<SpinningCopy<T>> {
+    gr::PortIn<T>  in;
+    gr::PortOut<T> out;
+
+    GR_MAKE_REFLECTABLE(SpinningCopy, in, out);
+
+    std::atomic<std::uint64_t> costNsPerSample{0U};
+
+    template<typename TSpanIn, typename TSpanOut>
+    [[nodiscard]] gr::work::Status processBulk(const TSpanIn& inSpan, TSpanOut& outSpan) {
+        const auto cost = std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(costNsPerSample.load(std::memory_order_relaxed) * inSpan.size()));
+        for (const auto until = std::chrono::steady_clock::now() + cost; std::chrono::steady_clock::now() < until;) {
+        }
+        std::ranges::copy(inSpan, outSpan.begin());
+        return gr::work::Status::OK;
+    }
+};
+
+// Source publishing at most `chunk` samples per work() call, so that consumers see small inputs unless they are batched;
+// with `period_us` set, one chunk per period like a receiver streaming at a fixed rate
+template<typename T>
+struct ChunkedSource : gr::Block<ChunkedSource<T>> {
+    gr::PortOut<T> out;
+
+    gr::Annotated<gr::Size_t, "n_samples", gr::Doc<"Samples to produce">>                              n_samples = 1024U;
+    gr::Annotated<gr::Size_t, "chunk", gr::Doc<"Most samples published per call">>                     chunk     = 64U;
+    gr::Annotated<gr::Size_t, "period_us", gr::Doc<"Time between two chunks, 0: as fast as possible">> period_us = 0U;
+
+    GR_MAKE_REFLECTABLE(ChunkedSource, out, n_samples, chunk, period_us);
+
+    std::size_t                           _produced = 0UZ;
+    std::chrono::steady_clock::time_point _nextChunk{};
+
+    [[nodiscard]] gr::work::Status processBulk(gr::OutputSpanLike auto& outSpan) {
+        if (period_us.value != 0U) {
+            const auto now = std::chrono::steady_clock::now();
+            if (_nextChunk == std::chrono::steady_clock::time_point{}) {
+                _nextChunk = now;
+            }
+            if (now < _nextChunk) {
+                outSpan.publish(0UZ);
+                return gr::work::Status::OK;
+            }
+            _nextChunk += std::chrono::microseconds(period_us.value);
+        }
+        const std::size_t total = static_cast<std::size_t>(n_samples.value);
+        const std::size_t n     = std::min({total - std::min(total, _produced), static_cast<std::size_t>(chunk.value), outSpan.size()});
+        std::fill_n(outSpan.begin(), n, T{1});
+        outSpan.publish(n);
+        _produced += n;
+        return _produced >= total ? gr::work::Status::DONE : gr::work::Status::OK;
+    }
+};
+
+// Source publishing `n_samples` once another thread set `ready`, like a block whose device is read by an I/O thread
+template<typename T>
+struct SignalledSource : gr::Block<SignalledSource<T>> {
+    gr::PortOut<T> out;
+
+    gr::Annotated<gr::Size_t, "n_samples", gr::Doc<"Samples published once ready">> n_samples = 64U;
+
+    GR_MAKE_REFLECTABLE(SignalledSource, out, n_samples);
+
+    const std::atomic<bool>* ready = nullptr;
+
+    [[nodiscard]] gr::work::Status processBulk(gr::OutputSpanLike auto& outSpan) {
+        if (ready == nullptr || !ready->load(std::memory_order_acquire)) {
+            outSpan.publish(0UZ);
+            return gr::work::Status::OK;
+        }
+        const std::size_t n = std::min(static_cast<std::size_t>(n_samples.value), outSpan.size());
+        std::fill_n(outSpan.begin(), n, T{1});
+        outSpan.publish(n);
+        return gr::work::Status::DONE;
+    }
+};
+
+// Sink holding its worker inside the first work() call for `stall_ms`, then setting `released`: the other blocks of that
+// worker can only progress meanwhile if another worker steals them
+template<typename T>
+struct StallingSink : gr::Block<StallingSink<T>> {
+    gr::PortIn<T> in;
+
+    gr::Annotated<gr::Size_t, "stall_ms", gr::Doc<"Time the first work() call blocks its worker">> stall_ms = 200U;
+
+    GR_MAKE_REFLECTABLE(StallingSink, in, stall_ms);
+
+    std::atomic<bool> released{false};
+
+    [[nodiscard]] gr::work::Status processBulk(gr::InputSpanLike auto& /*inSpan*/) {
+        if (!released.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(stall_ms.value));
+            released.store(true, std::memory_order_release);
+        }
+        return gr::work::Status::OK;
+    }
+};
+
+} // namespace
+
 const boost::ut::suite<"BlockingBackoff"> BlockingBackoffTests = [] {
     using namespace boost::ut;
 
@@ -63,6 +268,884 @@ const boost::ut::suite<"BlockingBackoff"> BlockingBackoffTests = [] {
         std::ignore = scheduler.changeStateTo(gr::lifecycle::State::INITIALISED);
         expect(scheduler.jobs()->size() > 1UZ);
     };
+
+    "steal pass runs unclaimed blocks of other job lists"_test = [] {
+        using namespace gr::incubator::scheduler;
+        using Queues = std::vector<std::shared_ptr<detail::WorkerQueue>>;
+
+        // worker 0 (the thief) has nothing, worker 1 holds two idle blocks, worker 2 one block with work and one claimed by
+        // its owner; slots carry no block, the run callback stands in for work()
+        Queues queues{std::make_shared<detail::WorkerQueue>(), std::make_shared<detail::WorkerQueue>(), std::make_shared<detail::WorkerQueue>()};
+        for (std::size_t i = 0UZ; i < 2UZ; ++i) {
+            queues[1]->slots.push_back(std::make_shared<detail::BlockSlot>(nullptr));
+            queues[2]->slots.push_back(std::make_shared<detail::BlockSlot>(nullptr));
+        }
+        const std::shared_ptr<detail::BlockSlot> busy     = queues[2]->slots[0];
+        const std::shared_ptr<detail::BlockSlot> runnable = queues[2]->slots[1];
+        expect(busy->tryClaim());
+
+        std::vector<const detail::BlockSlot*>           ran;
+        detail::WorkerCounters                          counters;
+        std::vector<std::shared_ptr<detail::BlockSlot>> stolenSlots;
+        const auto                                      run = [&ran, &runnable](detail::BlockSlot& slot) {
+            ran.push_back(&slot);
+            return gr::work::Result{std::numeric_limits<std::size_t>::max(), &slot == runnable.get() ? 64UZ : 0UZ, gr::work::Status::OK};
+        };
+
+        const gr::work::Result result = detail::stealOnce(0UZ, std::span<const std::shared_ptr<detail::WorkerQueue>>(queues), stolenSlots, run, &counters);
+        expect(eq(result.performed_work, 64UZ));
+        expect(result.status == gr::work::Status::OK);
+        expect(eq(ran.size(), 3UZ)) << "both idle blocks of worker 1, then the unclaimed block of worker 2";
+        expect(std::ranges::find(ran, busy.get()) == ran.end()) << "claimed blocks are never run by a thief";
+        expect(eq(counters.nSteals.load(), 1U));
+        expect(runnable->tryClaim()) << "stolen blocks are released after the pass";
+        runnable->release();
+        busy->release();
+
+        ran.clear();
+        const gr::work::Result own = detail::stealOnce(2UZ, std::span<const std::shared_ptr<detail::WorkerQueue>>(queues).first(2UZ), stolenSlots, run, &counters);
+        expect(eq(own.performed_work, 0UZ));
+        expect(eq(ran.size(), 2UZ)) << "only the listed (non real-time) job lists are visited";
+        expect(eq(counters.nSteals.load(), 1U));
+    };
+
+    "work stealing completes a chain dealt over the workers"_test = [] {
+        constexpr gr::Size_t nSamples = 1U << 18U;
+
+        // one chain dealt round robin over the workers: downstream workers starve until their input arrives and steal
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", nSamples}});
+        auto&     copy1  = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     copy2  = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     copy3  = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+        expect(graph.connect<"out", "in">(source, copy1).has_value());
+        expect(graph.connect<"out", "in">(copy1, copy2).has_value());
+        expect(graph.connect<"out", "in">(copy2, copy3).has_value());
+        expect(graph.connect<"out", "in">(copy3, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.work_stealing = true;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, nSamples));
+    };
+
+    "idle workers steal from a worker held inside work()"_test = [] {
+        constexpr gr::Size_t nSamples = 1U << 20U;
+
+        // worker 1: stallSource -> stall next to sourceA -> sinkA, worker 0: an idle source that only starts once the stall
+        // ends (block costs steer traffic_aware). Whichever worker enters the stall, the other one has to steal to progress.
+        gr::Graph graph;
+        auto&     idleSource  = graph.emplaceBlock<SignalledSource<float>>(gr::property_map{{"n_samples", gr::Size_t(64)}});
+        auto&     idleSink    = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(64)}});
+        auto&     stallSource = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(64)}});
+        auto&     stall       = graph.emplaceBlock<StallingSink<float>>();
+        auto&     sourceA     = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", nSamples}});
+        auto&     sinkA       = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+        expect(graph.connect<"out", "in">(idleSource, idleSink).has_value());
+        expect(graph.connect<"out", "in">(stallSource, stall).has_value());
+        expect(graph.connect<"out", "in">(sourceA, sinkA).has_value());
+        idleSource.ready = &stall.released;
+
+        gr::property_map costs;
+        costs.insert_or_assign(std::pmr::string(idleSource.unique_name), gr::pmt::Value(2.0));
+        costs.insert_or_assign(std::pmr::string(idleSink.unique_name), gr::pmt::Value(2.0));
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.worker_threads     = gr::Size_t(2);
+        scheduler.partition_strategy = std::string("traffic_aware");
+        scheduler.block_costs        = costs;
+        scheduler.work_stealing      = true;
+        scheduler.enable_telemetry   = true;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        std::ignore = scheduler.changeStateTo(gr::lifecycle::State::INITIALISED);
+        const auto& partition = scheduler.partitionInfo();
+        expect(eq(partition.blocks.size(), 2UZ)) << fatal;
+        expect(eq(partition.blocks[0].size(), 2UZ)) << "the idle chain fills one worker";
+        expect(eq(partition.blocks[1].size(), 4UZ)) << "the stall shares the other worker with chain A";
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sinkA.count.value, nSamples));
+        expect(eq(idleSink.count.value, gr::Size_t(64)));
+
+        const auto          telemetry = scheduler.telemetry();
+        const std::uint64_t steals    = std::ranges::fold_left(telemetry.workers, std::uint64_t{0}, [](std::uint64_t sum, const auto& worker) { return sum + worker.steals; });
+        expect(gt(steals, 0U)) << "a worker with nothing runnable must steal the blocks held up behind the stall";
+    };
+
+    "traffic aware partition contracts the heaviest edges first"_test = [] {
+        using namespace gr::incubator::scheduler;
+        // source -> rotator -> decimator -> demod -> sink, the decimator dominating the cost
+        const std::vector<double>          cost{1.0, 2.0, 10.0, 1.0, 1.0};
+        const std::vector<partition::Edge> edges{{0UZ, 1UZ, 16.0}, {1UZ, 2UZ, 16.0}, {2UZ, 3UZ, 2.0}, {3UZ, 4UZ, 2.0}};
+
+        const partition::Plan roundRobin = partition::roundRobin(cost, edges, 2UZ);
+        const partition::Plan traffic    = partition::trafficAware(cost, edges, 2UZ);
+
+        expect(eq(roundRobin.batches.size(), 2UZ));
+        expect(eq(traffic.batches.size(), 2UZ));
+        expect(lt(traffic.cutBandwidth, roundRobin.cutBandwidth));
+        expect(eq(traffic.cutBandwidth, 16.0)); // only the rotator -> decimator edge, the decimator cannot absorb more
+    };
+
+    "traffic aware plan keeps connected blocks on one worker"_test = [] {
+        auto [graph, sinkA, sinkB] = makeTwoChains(gr::Size_t(8));
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.partition_strategy  = std::string("traffic_aware");
+        scheduler.partition_imbalance = 4.F;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        std::ignore = scheduler.changeStateTo(gr::lifecycle::State::INITIALISED);
+        const auto& partition = scheduler.partitionInfo();
+        expect(eq(partition.cutBandwidth, 0.0));
+        expect(eq(partition.blocks.size(), scheduler.jobs()->size()));
+    };
+
+    "wakeup event does not lose notifications"_test = [] {
+        using namespace std::chrono_literals;
+        gr::incubator::scheduler::WakeupEvent event;
+
+        const std::uint32_t stale = event.epoch();
+        event.notifyAll();
+        expect(event.wait(stale, 1s)) << "notification between sample and wait must not park";
+
+        const std::uint32_t current = event.epoch();
+        expect(!event.wait(current, 1ms)) << "no notification -> timeout";
+
+        const std::uint32_t sampled = event.epoch();
+        std::jthread        notifier([&event] {
+            std::this_thread::sleep_for(5ms);
+            event.notifyAll();
+        });
+        const auto start = std::chrono::steady_clock::now();
+        expect(event.wait(sampled, 10s));
+        expect(lt(std::chrono::steady_clock::now() - start, 5s));
+    };
+
+    "parked workers are woken by connected workers"_test = [] {
+        constexpr gr::Size_t nSamples = 1U << 16U;
+
+        // a chain dealt over the workers: downstream workers park until their upstream neighbour publishes samples
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", nSamples}});
+        auto&     copy1  = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     copy2  = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+        expect(graph.connect<"out", "in">(source, copy1).has_value());
+        expect(graph.connect<"out", "in">(copy1, copy2).has_value());
+        expect(graph.connect<"out", "in">(copy2, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.idle_strategy    = std::string("park");
+        scheduler.park_timeout_us  = gr::Size_t(1'000'000); // a timed-out wait would stall the test, so progress means wake-ups
+        scheduler.enable_telemetry = true;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, nSamples));
+
+        const auto          telemetry = scheduler.telemetry();
+        const std::uint64_t parks     = std::ranges::fold_left(telemetry.workers, std::uint64_t{0}, [](std::uint64_t sum, const auto& worker) { return sum + worker.parks; });
+        const std::uint64_t wakeups   = std::ranges::fold_left(telemetry.workers, std::uint64_t{0}, [](std::uint64_t sum, const auto& worker) { return sum + worker.wakeups; });
+        expect(gt(telemetry.workers.size(), 1UZ));
+        expect(gt(parks, 0U)) << "starved downstream workers must park";
+        expect(gt(wakeups, 0U)) << "parked workers must be woken by their upstream neighbour";
+        expect(le(wakeups, parks));
+        expect(lt(std::chrono::steady_clock::now() - start, std::chrono::seconds(10))) << "parks must not run into the timeout";
+    };
+
+    "io wakeup ends a parked wait long before park_timeout_us"_test = [] {
+        using namespace std::chrono_literals;
+        using namespace gr::incubator::scheduler;
+        constexpr auto kParkTimeout = 2s;
+
+        std::atomic<bool> ready{false};
+        gr::Graph         graph;
+        auto&             source = graph.emplaceBlock<SignalledSource<float>>(gr::property_map{{"n_samples", gr::Size_t(64)}});
+        auto&             sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(64)}});
+        expect(graph.connect<"out", "in">(source, sink).has_value());
+        source.ready = &ready;
+
+        BlockingBackoff<> scheduler;
+        scheduler.idle_strategy    = std::string("park");
+        scheduler.park_timeout_us  = static_cast<gr::Size_t>(std::chrono::microseconds(kParkTimeout).count());
+        scheduler.enable_telemetry = true;
+        scheduler.worker_threads   = gr::Size_t(1);
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        // the I/O thread waits until the worker parked on the idle source, then hands over data and notifies
+        std::chrono::steady_clock::time_point signalled;
+        std::jthread                          io([&scheduler, &ready, &signalled] {
+            const auto giveUp = std::chrono::steady_clock::now() + 10s;
+            while (std::chrono::steady_clock::now() < giveUp && std::ranges::fold_left(scheduler.telemetry().workers, std::uint64_t{0}, [](std::uint64_t sum, const auto& worker) { return sum + worker.parks; }) == 0U) {
+                std::this_thread::sleep_for(1ms);
+            }
+            signalled = std::chrono::steady_clock::now();
+            ready.store(true, std::memory_order_release);
+            IoWakeup::notify();
+        });
+        expect(scheduler.runAndWait().has_value());
+        const auto finished = std::chrono::steady_clock::now();
+        io.join();
+
+        expect(eq(sink.count.value, gr::Size_t(64)));
+        const auto telemetry = scheduler.telemetry();
+        expect(gt(telemetry.workers.front().parks, 0U)) << fatal;
+        expect(gt(telemetry.workers.front().wakeups, 0U)) << "the parked wait must end by the notification";
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(finished - signalled);
+        expect(lt(latency, std::chrono::duration_cast<std::chrono::microseconds>(kParkTimeout) / 20)) << std::format("wakeup-to-completion latency {}", latency);
+    };
+
+    "cpu lists are parsed like isolcpus"_test = [] {
+        using gr::incubator::scheduler::affinity::parseCpuList;
+        using gr::incubator::scheduler::affinity::kMaxCpus;
+        expect(eq(parseCpuList("0-3,8,10-11\n").value_or(std::vector<int>{}), std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+        expect(eq(parseCpuList(" 4, 2,2 ").value_or(std::vector<int>{}), std::vector<int>{2, 4}));
+        expect(parseCpuList("").value_or(std::vector<int>{-1}).empty());
+        expect(eq(parseCpuList("x,1").value_or(std::vector<int>{}), std::vector<int>{1}));
+        expect(!parseCpuList("0-4000000000").has_value()) << "unbounded ranges must not allocate";
+        expect(!parseCpuList(std::format("1,{}", kMaxCpus)).has_value());
+        expect(parseCpuList(std::format("{}", kMaxCpus - 1)).has_value());
+    };
+
+    "pinned workers complete graph"_test = [] {
+        gr::Graph graph;
+        auto&     sourceA = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(1024)}});
+        auto&     sinkA   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(1024)}});
+        auto&     sourceB = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(1024)}});
+        auto&     sinkB   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(1024)}});
+
+        expect(graph.connect<"out", "in">(sourceA, sinkA).has_value());
+        expect(graph.connect<"out", "in">(sourceB, sinkB).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.cpu_affinity = std::string("0");
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(scheduler.workerCpus(), std::vector<int>{0}));
+        expect(eq(sinkA.count.value, gr::Size_t(1024)));
+        expect(eq(sinkB.count.value, gr::Size_t(1024)));
+    };
+
+    "refused pinning is reported"_test = [] {
+        using gr::incubator::scheduler::affinity::kMaxCpus;
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(256)}});
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(256)}});
+        expect(graph.connect<"out", "in">(source, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.cpu_affinity = std::format("{}", kMaxCpus - 1); // a valid CPU number no runner has online
+        gr::MsgPortIn fromScheduler;
+        expect(scheduler.msgOut.connect(fromScheduler) == gr::ConnectionResult::SUCCESS) << fatal;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, gr::Size_t(256))) << "workers run unpinned";
+        expect(hasError(drainMessages(fromScheduler), "cpu_affinity"));
+    };
+
+    "telemetry records per block work and per worker cycles"_test = [] {
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(2048)}});
+        auto&     copy   = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(2048)}});
+
+        expect(graph.connect<"out", "in">(source, copy).has_value());
+        expect(graph.connect<"out", "in">(copy, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.enable_telemetry = true;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, gr::Size_t(2048)));
+
+        const auto telemetry = scheduler.telemetry();
+        expect(eq(telemetry.blocks.size(), 3UZ));
+        for (const auto& block : telemetry.blocks) {
+            expect(gt(block.workCalls, 0U)) << block.name;
+            expect(gt(block.performedWork, 0U)) << block.name;
+        }
+        expect(!telemetry.workers.empty());
+        expect(gt(telemetry.workers.front().cycles, 0U));
+    };
+
+    "telemetry is published on msgOut every telemetry_interval_ms"_test = [] {
+        constexpr gr::Size_t nSamples = 64U * 100U; // one chunk per ms, about 100 ms of streaming
+
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<ChunkedSource<float>>(gr::property_map{{"n_samples", nSamples}, {"chunk", gr::Size_t(64)}, {"period_us", gr::Size_t(1000)}});
+        auto&     copy   = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+        expect(graph.connect<"out", "in">(source, copy).has_value());
+        expect(graph.connect<"out", "in">(copy, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.enable_telemetry      = true;
+        scheduler.telemetry_interval_ms = gr::Size_t(5);
+        gr::MsgPortIn fromScheduler;
+        expect(scheduler.msgOut.connect(fromScheduler) == gr::ConnectionResult::SUCCESS) << fatal;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, nSamples));
+
+        std::vector<gr::Message> reports;
+        std::ranges::copy_if(drainMessages(fromScheduler), std::back_inserter(reports), [](const gr::Message& message) { return message.endpoint == "telemetry" && message.data.has_value(); });
+        expect(gt(reports.size(), 1UZ)) << "a run spanning many intervals must be reported more than once" << fatal;
+        expect(eq(reports.back().serviceName, std::string(scheduler.unique_name)));
+
+        const gr::property_map& report = *reports.back().data;
+        const auto*             blocks = entry<gr::property_map>(report, "blocks");
+        expect(blocks != nullptr) << fatal;
+        expect(eq(blocks->size(), 3UZ));
+        for (const auto& [name, value] : *blocks) {
+            const auto* counters = value.get_if<gr::property_map>();
+            expect(counters != nullptr) << fatal;
+            const auto* workCalls = entry<std::uint64_t>(*counters, "work_calls");
+            expect(workCalls != nullptr && *workCalls > 0U) << std::string(name);
+            expect(entry<std::uint64_t>(*counters, "performed_work") != nullptr) << std::string(name);
+            expect(entry<double>(*counters, "work_time_s") != nullptr) << std::string(name);
+        }
+
+        const auto* workers = entry<gr::property_map>(report, "workers");
+        expect(workers != nullptr) << fatal;
+        expect(eq(workers->size(), scheduler.telemetry().workers.size()));
+        for (const auto& [worker, value] : *workers) {
+            const auto* counters = value.get_if<gr::property_map>();
+            expect(counters != nullptr) << fatal;
+            for (const std::string_view key : {"cycles", "idle_cycles", "steals", "parks", "wakeups"}) {
+                expect(entry<std::uint64_t>(*counters, key) != nullptr) << std::format("worker {}: {}", worker, key);
+            }
+            expect(entry<double>(*counters, "backoff_time_s") != nullptr) << std::format("worker {}", worker);
+            expect(entry<bool>(*counters, "realtime") != nullptr) << std::format("worker {}", worker);
+        }
+        const auto* firstWorker = entry<gr::property_map>(*workers, "0");
+        expect(firstWorker != nullptr) << fatal;
+        const auto* cycles = entry<std::uint64_t>(*firstWorker, "cycles");
+        expect(cycles != nullptr && *cycles > 0U) << "runner 0 publishes, so it has cycled";
+    };
+
+    "arrival predictor tracks the burst interval"_test = [] {
+        using namespace std::chrono_literals;
+        gr::incubator::scheduler::detail::ArrivalPredictor predictor;
+        const auto                                         t0 = std::chrono::steady_clock::time_point{} + 1s;
+
+        expect(eq(predictor.sleepHintUs(t0, 0.2), 0UZ)) << "no prediction before two bursts";
+        for (int burst = 0; burst < 8; ++burst) {
+            const auto arrival = t0 + burst * 1ms;
+            predictor.onCycle(true, arrival, 0.125);
+            predictor.onCycle(true, arrival + 10us, 0.125); // same burst, must not count as an arrival
+            predictor.onCycle(false, arrival + 20us, 0.125);
+        }
+        expect(approx(predictor.intervalUs, 1000.0, 1.0));
+
+        const auto lastArrival = t0 + 7ms;
+        expect(eq(predictor.sleepHintUs(lastArrival + 100us, 0.2), 700UZ));
+        expect(eq(predictor.sleepHintUs(lastArrival + 900us, 0.2), 0UZ)) << "overdue bursts fall back to the backoff ramp";
+    };
+
+    "arrival predictor sleeps just under a jittered period"_test = [] {
+        using namespace std::chrono_literals;
+        constexpr double                                   kSmoothing = 0.125;
+        gr::incubator::scheduler::detail::ArrivalPredictor predictor;
+
+        auto       arrival = std::chrono::steady_clock::time_point{} + 1s;
+        const auto burst   = [&predictor, &arrival](std::chrono::microseconds period) {
+            arrival += period;
+            predictor.onCycle(true, arrival, kSmoothing);
+            predictor.onCycle(false, arrival + 5us, kSmoothing);
+        };
+
+        // a source delivering every 500 us +- 40 us
+        for (int i = 0; i < 64; ++i) {
+            burst(i % 2 == 0 ? 460us : 540us);
+        }
+        expect(approx(predictor.intervalUs, 500.0, 5.0));
+        for (const double guard : {0.05, 0.2, 0.5}) {
+            const std::size_t hint = predictor.sleepHintUs(arrival, guard);
+            expect(lt(hint, 500UZ)) << std::format("guard {}: wakes up before the mean period", guard);
+            expect(approx(static_cast<double>(hint), (1.0 - guard) * predictor.intervalUs, 1.0)) << std::format("guard {}: sleeps through all but the guard", guard);
+            expect(approx(static_cast<double>(predictor.sleepHintUs(arrival + 100us, guard)), static_cast<double>(hint) - 100.0, 1.0)) << "time already idle is deducted";
+        }
+        expect(le(predictor.sleepHintUs(arrival, 0.2), 460UZ)) << "a 20 % guard also covers the early bursts";
+
+        // the source slows down to 2 ms: the estimate follows and the sleep grows with it
+        for (int i = 0; i < 64; ++i) {
+            burst(2ms);
+        }
+        expect(approx(predictor.intervalUs, 2000.0, 2.0));
+        expect(approx(static_cast<double>(predictor.sleepHintUs(arrival, 0.2)), 1600.0, 2.0));
+        expect(lt(predictor.sleepHintUs(arrival, 0.2), 2000UZ));
+    };
+
+    "realtime blocks get dedicated lanes"_test = [] {
+        using namespace gr::incubator::scheduler;
+        auto [graph, sinkA, sinkB] = makeTwoChains(gr::Size_t(1024));
+
+        // whether this runner may use SCHED_FIFO at all (CAP_SYS_NICE or RLIMIT_RTPRIO), probed on a scratch thread
+        bool granted = false;
+        std::thread([&granted] {
+            realtime::ScopedRealtimePriority probe;
+            granted = probe.apply(realtime::Policy::Fifo, 1).has_value();
+        }).join();
+
+        BlockingBackoff<> scheduler;
+        scheduler.realtime_blocks   = std::string("CountingSink");
+        scheduler.realtime_policy   = std::string("fifo");
+        scheduler.realtime_priority = gr::Size_t(1);
+        scheduler.work_stealing     = true;
+        scheduler.worker_threads    = gr::Size_t(2); // one stream worker and one real-time lane, independent of the runner's cores
+        gr::MsgPortIn fromScheduler;
+        expect(scheduler.msgOut.connect(fromScheduler) == gr::ConnectionResult::SUCCESS) << fatal;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        std::ignore = scheduler.changeStateTo(gr::lifecycle::State::INITIALISED);
+
+        const auto& partition = scheduler.partitionInfo();
+        const auto  isSink    = [](const std::string& name) { return name.contains("CountingSink"); };
+        expect(eq(partition.blocks.size(), 2UZ)) << fatal;
+        expect(eq(partition.realtimeLanes, 1UZ));
+        expect(eq(partition.blocks[1].size(), 2UZ)) << "both sinks share the only real-time lane";
+        expect(std::ranges::all_of(partition.blocks[1], isSink)) << "real-time lanes hold nothing but real-time blocks";
+        expect(std::ranges::none_of(partition.blocks[0], isSink));
+        expect(eq(partition.blocks[0].size(), 3UZ));
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sinkA->count.value, gr::Size_t(1024)));
+        expect(eq(sinkB->count.value, gr::Size_t(1024)));
+
+        const auto telemetry = scheduler.telemetry();
+        expect(eq(telemetry.workers.size(), 2UZ)) << fatal;
+        expect(!telemetry.workers[0].realtime) << "stream workers keep the default class";
+        expect(eq(telemetry.workers[1].realtime, granted)) << "the lane reports whether SCHED_FIFO was granted";
+        expect(eq(hasError(drainMessages(fromScheduler), "realtime_policy"), !granted)) << "a refused real-time class must be reported";
+    };
+
+    "unknown realtime policy is reported"_test = [] {
+        auto [graph, sinkA, sinkB] = makeTwoChains(gr::Size_t(256));
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.realtime_blocks = std::string("CountingSink");
+        scheduler.realtime_policy = std::string("deadline");
+        scheduler.worker_threads  = gr::Size_t(2);
+        gr::MsgPortIn fromScheduler;
+        expect(scheduler.msgOut.connect(fromScheduler) == gr::ConnectionResult::SUCCESS) << fatal;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sinkA->count.value, gr::Size_t(256))) << "the lanes still run, without a real-time class";
+        expect(hasError(drainMessages(fromScheduler), "realtime_policy"));
+        expect(std::ranges::none_of(scheduler.telemetry().workers, [](const auto& worker) { return worker.realtime; }));
+    };
+
+    "control thread handles messages while workers stream"_test = [] {
+        using namespace std::chrono_literals;
+        using Scheduler                = gr::incubator::scheduler::BlockingBackoff<>;
+        constexpr std::size_t nUpdates = 64UZ;
+
+        // an endless chain, stopped once the last update of the burst reached the gain
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<ChunkedSource<float>>(gr::property_map{{"n_samples", std::numeric_limits<gr::Size_t>::max()}, {"chunk", gr::Size_t(1024)}});
+        auto&     gain   = graph.emplaceBlock<GainCopy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", std::numeric_limits<gr::Size_t>::max()}});
+
+        expect(graph.connect<"out", "in">(source, gain).has_value());
+        expect(graph.connect<"out", "in">(gain, sink).has_value());
+
+        Scheduler scheduler;
+        scheduler.control_thread   = true;
+        scheduler.enable_telemetry = true;
+        gr::MsgPortOut toScheduler;
+        expect(toScheduler.connect(scheduler.msgIn) == gr::ConnectionResult::SUCCESS) << fatal;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        const auto streamed = [&scheduler, sinkName = std::string(sink.unique_name)] {
+            const auto telemetry = scheduler.telemetry();
+            const auto block     = std::ranges::find(telemetry.blocks, sinkName, &Scheduler::BlockTelemetry::name);
+            return block == telemetry.blocks.end() ? std::uint64_t{0} : block->performedWork;
+        };
+
+        std::uint64_t beforeBurst = 0U;
+        std::uint64_t afterBurst  = 0U;
+        std::jthread  controller([&] {
+            const auto giveUp = std::chrono::steady_clock::now() + 10s;
+            while (std::chrono::steady_clock::now() < giveUp && streamed() == 0U) {
+                std::this_thread::sleep_for(1ms);
+            }
+            beforeBurst = streamed();
+            for (std::size_t update = 1UZ; update <= nUpdates; ++update) {
+                gr::sendMessage<gr::message::Command::Set>(toScheduler, std::string(gain.unique_name), gr::block::property::kSetting, gr::property_map{{"gain", static_cast<float>(update)}});
+                std::this_thread::sleep_for(100us);
+            }
+            while (std::chrono::steady_clock::now() < giveUp && gain.appliedGain.load(std::memory_order_acquire) != static_cast<float>(nUpdates)) {
+                std::this_thread::sleep_for(1ms);
+            }
+            afterBurst  = streamed();
+            std::ignore = scheduler.changeStateTo(gr::lifecycle::State::REQUESTED_STOP);
+        });
+        expect(scheduler.runAndWait().has_value());
+        controller.join();
+
+        expect(eq(gain.appliedGain.load(std::memory_order_acquire), static_cast<float>(nUpdates))) << "the last update of the burst must be applied";
+        expect(eq(gain.gain.value, static_cast<float>(nUpdates)));
+        expect(gt(beforeBurst, 0U)) << "the burst starts while samples flow";
+        expect(gt(afterBurst, beforeBurst)) << "workers must keep streaming while the control thread handles the burst";
+    };
+
+    "chunk planner fits working sets into the cache budget"_test = [] {
+        using namespace gr::incubator::scheduler::chunking;
+        expect(eq(parseCacheSize("48K"), 48UZ * 1024UZ));
+        expect(eq(parseCacheSize("2M\n"), 2UZ * 1024UZ * 1024UZ));
+        expect(eq(parseCacheSize("x"), 0UZ));
+
+        // 101 float taps + 128 complex history, 8 B in + 1.6 B out per input sample, half of a 1 MiB L2
+        const std::size_t chunk = fitChunk(101.0 * 4.0 + 128.0 * 8.0, 9.6, 1024UZ * 1024UZ, 0.5, 256UZ);
+        expect(eq(chunk % 64UZ, 0UZ));
+        expect(le(101.0 * 4.0 + 128.0 * 8.0 + 9.6 * static_cast<double>(chunk), 512.0 * 1024.0));
+        expect(gt(101.0 * 4.0 + 128.0 * 8.0 + 9.6 * static_cast<double>(chunk + 64UZ), 512.0 * 1024.0));
+
+        expect(eq(fitChunk(1e9, 8.0, 32768UZ, 0.5, 256UZ), 256UZ)) << "oversized fixed part falls back to the minimum chunk";
+        expect(eq(fitChunk(0.0, 0.0, 32768UZ, 0.5, 256UZ), std::numeric_limits<std::size_t>::max())) << "no hint, no limit";
+    };
+
+    "cache fitted chunking completes graph"_test = [] {
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(8192)}});
+        auto&     copy   = graph.emplaceBlock<gr::testing::Copy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(8192)}});
+
+        expect(graph.connect<"out", "in">(source, copy).has_value());
+        expect(graph.connect<"out", "in">(copy, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.chunk_cache_level = gr::Size_t(1);
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, gr::Size_t(8192)));
+        const auto plan = scheduler.chunkPlan();
+        expect(eq(plan.size(), 3UZ));
+        expect(std::ranges::all_of(plan, [](const auto& entry) { return entry.chunkSamples == 0UZ; })) << "testing blocks publish no working-set hints";
+    };
+
+    "cache fitted chunking caps work requests of hinted blocks"_test = [] {
+        using namespace gr::incubator::scheduler;
+        constexpr gr::Size_t nSamples = 1U << 16U;
+
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", nSamples}});
+        auto&     copy   = graph.emplaceBlock<HintedCopy<float>>();
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+        expect(graph.connect<"out", "in">(source, copy).has_value());
+        expect(graph.connect<"out", "in">(copy, sink).has_value());
+
+        BlockingBackoff<> scheduler;
+        scheduler.chunk_cache_level = gr::Size_t(1);
+        scheduler.chunk_cache_fill  = 0.5F;
+        scheduler.min_chunk_samples = gr::Size_t(64);
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, nSamples));
+
+        const std::size_t expected = chunking::fitChunk(0.0, 64.0, chunking::detectCacheSizes().l1d, 0.5, 64UZ);
+        const auto        plan     = scheduler.chunkPlan();
+        const auto        entry    = std::ranges::find(plan, std::string(copy.unique_name), &BlockingBackoff<>::ChunkPlanEntry::name);
+        expect(entry != plan.end()) << fatal;
+        expect(eq(entry->chunkSamples, expected));
+        expect(eq(entry->workingSetBytes, 64UZ * expected));
+        expect(lt(expected, static_cast<std::size_t>(nSamples)));
+        expect(gt(copy.maxChunk, 0UZ));
+        expect(le(copy.maxChunk, expected)) << "work() must not hand the hinted block more than its cache-fitted chunk";
+    };
+
+    "shared pool splits cpu time by priority"_test = [] {
+        using gr::incubator::scheduler::SharedWorkerPool;
+        // manual clock: every charged step costs exactly one quantum, so the stride accounting is deterministic
+        static std::atomic<std::int64_t> ticks{0};
+        constexpr std::int64_t           kQuantumUs = 100;
+        constexpr std::size_t            kQuanta    = 400UZ;
+        SharedWorkerPool                 pool(1UZ, [] noexcept { return SharedWorkerPool::clock::time_point(std::chrono::microseconds(ticks.load())); });
+
+        std::atomic<bool>        go{false};
+        std::atomic<bool>        stop{false};
+        std::atomic<std::size_t> charged{0UZ};
+        const auto               step = [&] {
+            if (stop.load()) {
+                return SharedWorkerPool::StepResult::Finished;
+            }
+            if (go.load() && charged.load() < kQuanta) { // free until both jobs joined, and once the quanta are spent
+                ++charged;
+                ticks += kQuantumUs;
+            }
+            return SharedWorkerPool::StepResult::Progress;
+        };
+        pool.submit(step, {.name = "low", .weight = 1.0});
+        pool.submit(step, {.name = "high", .weight = 3.0});
+        go = true;
+        while (charged.load() < kQuanta) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        const auto stats = pool.jobStats();
+        expect(eq(stats.size(), 2UZ));
+        const auto high = std::ranges::find(stats, std::string("high"), &SharedWorkerPool::JobStats::name);
+        expect(high != stats.end()) << fatal;
+        expect(approx(high->cpuShare, 0.75, 1.0 / static_cast<double>(kQuanta))) << std::format("share of the weight 3 job: {}", high->cpuShare); // exact up to the tie at the last pick
+
+        stop = true;
+        while (pool.nJobs() != 0UZ) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    "per-worker options ignored in shared mode are reported"_test = [] {
+        gr::Graph graph;
+        auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(256)}});
+        auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(256)}});
+        expect(graph.connect<"out", "in">(source, sink).has_value());
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.shared_pool   = std::string("qa_ignored");
+        scheduler.work_stealing = true;
+        gr::MsgPortIn fromScheduler;
+        expect(scheduler.msgOut.connect(fromScheduler) == gr::ConnectionResult::SUCCESS) << fatal;
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        expect(scheduler.runAndWait().has_value());
+        expect(eq(sink.count.value, gr::Size_t(256)));
+        expect(hasError(drainMessages(fromScheduler), "shared_pool"));
+    };
+
+    "shared pools are keyed by name and thread count"_test = [] {
+        using gr::incubator::scheduler::SharedWorkerPool;
+        const std::shared_ptr<SharedWorkerPool> two   = SharedWorkerPool::named("qa_keyed", 2UZ);
+        const std::shared_ptr<SharedWorkerPool> three = SharedWorkerPool::named("qa_keyed", 3UZ);
+        expect(two == SharedWorkerPool::named("qa_keyed", 2UZ));
+        expect(two != three) << "a different thread count must not silently reuse the existing pool";
+        expect(eq(two->nThreads(), 2UZ));
+        expect(eq(three->nThreads(), 3UZ));
+    };
+
+    "graphs sharing a pool complete concurrently"_test = [] {
+        constexpr std::size_t nGraphs = 4UZ;
+
+        std::vector<std::unique_ptr<gr::incubator::scheduler::BlockingBackoff<>>> schedulers;
+        std::vector<gr::testing::CountingSink<float>*>                             sinks;
+        for (std::size_t i = 0UZ; i < nGraphs; ++i) {
+            gr::Graph graph;
+            auto&     source = graph.emplaceBlock<gr::testing::CountingSource<float>>(gr::property_map{{"n_samples_max", gr::Size_t(4096)}});
+            auto&     copy   = graph.emplaceBlock<gr::testing::Copy<float>>();
+            auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", gr::Size_t(4096)}});
+            expect(graph.connect<"out", "in">(source, copy).has_value());
+            expect(graph.connect<"out", "in">(copy, sink).has_value());
+            sinks.push_back(&sink);
+
+            auto& scheduler               = *schedulers.emplace_back(std::make_unique<gr::incubator::scheduler::BlockingBackoff<>>());
+            scheduler.shared_pool         = std::string("qa_shared");
+            scheduler.shared_pool_threads = gr::Size_t(2);
+            scheduler.graph_priority      = static_cast<float>(i + 1UZ);
+            if (auto result = scheduler.exchange(std::move(graph)); !result) {
+                expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+            }
+        }
+
+        std::vector<std::thread> runners;
+        for (const auto& scheduler : schedulers) {
+            runners.emplace_back([&scheduler] { expect(scheduler->runAndWait().has_value()); });
+        }
+        for (std::thread& runner : runners) {
+            runner.join();
+        }
+
+        for (const auto* sink : sinks) {
+            expect(eq(sink->count.value, gr::Size_t(4096)));
+        }
+        expect(schedulers.front()->sharedPool() != nullptr);
+        expect(schedulers.front()->sharedPool() == schedulers.back()->sharedPool()) << "one pool per name";
+        expect(eq(schedulers.front()->sharedPool()->nThreads(), 2UZ));
+        expect(eq(schedulers.front()->partitionInfo().blocks.size(), 1UZ)) << "one job per graph";
+    };
+
+    "rebalancing picks the block that best halves the load gap"_test = [] {
+        using namespace gr::incubator::scheduler::detail;
+        const std::vector<bool> none(3UZ, false);
+
+        // worker 0 busy 90 %, worker 2 idle: saturated and far above the mean
+        const std::optional<WorkerPair> pair = overloadedWorker(std::vector{0.9, 0.4, 0.1}, none, 0.5, 0.25);
+        expect(pair.has_value()) << fatal;
+        expect(eq(pair->hot, 0UZ));
+        expect(eq(pair->cold, 2UZ));
+
+        expect(!overloadedWorker(std::vector{0.4, 0.3, 0.2}, none, 0.5, 0.25).has_value()) << "below saturation";
+        expect(!overloadedWorker(std::vector{0.9, 0.85, 0.8}, none, 0.5, 0.25).has_value()) << "within the even share";
+        const std::optional<WorkerPair> retiredCold = overloadedWorker(std::vector{0.9, 0.4, 0.1}, std::vector{false, false, true}, 0.5, 0.25);
+        expect(retiredCold.has_value()) << fatal;
+        expect(eq(retiredCold->cold, 1UZ)) << "retired workers receive no blocks";
+
+        // gap 0.8: the 0.35 block lands closest to half of it; 0.85 would only move the hot spot
+        expect(eq(migrationCandidate(std::vector{0.1, 0.35, 0.85}, 0.8).value_or(99UZ), 1UZ));
+        expect(!migrationCandidate(std::vector{0.0, 0.9}, 0.8).has_value());
+    };
+
+    "runtime rebalancing migrates blocks without losing samples"_test = [] {
+        using namespace std::chrono_literals;
+        constexpr gr::Size_t nSamples = 256U * 400U; // one chunk per ms, about 400 ms of streaming
+
+        // paced chain A: source -> heavy1 -> heavy2 -> sink next to chain B: source -> sink, weighted so that traffic_aware
+        // gives each chain a worker of its own. Both are cheap until the heavy blocks get expensive mid-run.
+        gr::Graph graph;
+        auto&     sourceA = graph.emplaceBlock<ChunkedSource<float>>(gr::property_map{{"n_samples", nSamples}, {"chunk", gr::Size_t(256)}, {"period_us", gr::Size_t(1000)}});
+        auto&     heavy1  = graph.emplaceBlock<SpinningCopy<float>>();
+        auto&     heavy2  = graph.emplaceBlock<SpinningCopy<float>>();
+        auto&     sinkA   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+        auto&     sourceB = graph.emplaceBlock<ChunkedSource<float>>(gr::property_map{{"n_samples", nSamples}, {"chunk", gr::Size_t(256)}, {"period_us", gr::Size_t(1000)}});
+        auto&     sinkB   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+        expect(graph.connect<"out", "in">(sourceA, heavy1).has_value());
+        expect(graph.connect<"out", "in">(heavy1, heavy2).has_value());
+        expect(graph.connect<"out", "in">(heavy2, sinkA).has_value());
+        expect(graph.connect<"out", "in">(sourceB, sinkB).has_value());
+
+        gr::property_map costs;
+        costs.insert_or_assign(std::pmr::string(sourceB.unique_name), gr::pmt::Value(2.0));
+        costs.insert_or_assign(std::pmr::string(sinkB.unique_name), gr::pmt::Value(2.0));
+
+        gr::incubator::scheduler::BlockingBackoff<> scheduler;
+        scheduler.worker_threads        = gr::Size_t(2);
+        scheduler.partition_strategy    = std::string("traffic_aware");
+        scheduler.block_costs           = costs;
+        scheduler.rebalance_interval_ms = gr::Size_t(5);
+        if (auto result = scheduler.exchange(std::move(graph)); !result) {
+            expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+        }
+
+        std::ignore = scheduler.changeStateTo(gr::lifecycle::State::INITIALISED);
+
+        const auto&       partition   = scheduler.partitionInfo();
+        const auto        ownerOf     = [&partition](const std::string& name) { return static_cast<std::size_t>(std::distance(partition.blocks.begin(), std::ranges::find_if(partition.blocks, [&name](const auto& names) { return std::ranges::find(names, name) != names.end(); }))); };
+        const std::string heavyName1(heavy1.unique_name);
+        const std::string heavyName2(heavy2.unique_name);
+        const std::size_t heavyWorker = ownerOf(heavyName1);
+        expect(eq(partition.blocks.size(), 2UZ)) << fatal;
+        expect(eq(ownerOf(heavyName2), heavyWorker)) << "both heavy blocks start on one worker" << fatal;
+        expect(neq(ownerOf(std::string(sourceB.unique_name)), heavyWorker)) << "chain B starts on the other worker" << fatal;
+
+        // 2 x 1.5 us per sample at 256 samples per ms: the heavy worker turns about 77 % busy, the other one stays idle
+        std::size_t  migrationsWhileCheap = 0UZ;
+        std::jthread load([&] {
+            std::this_thread::sleep_for(50ms);
+            migrationsWhileCheap = scheduler.migrations().size();
+            heavy1.costNsPerSample.store(1500U, std::memory_order_relaxed);
+            heavy2.costNsPerSample.store(1500U, std::memory_order_relaxed);
+        });
+        expect(scheduler.runAndWait().has_value());
+        load.join();
+
+        expect(eq(sinkA.count.value, nSamples));
+        expect(eq(sinkB.count.value, nSamples));
+        expect(eq(migrationsWhileCheap, 0UZ)) << "paced cheap chains saturate no worker";
+
+        const auto migrations = scheduler.migrations();
+        expect(!migrations.empty()) << "the saturated worker must hand a block over" << fatal;
+        const auto& first = migrations.front();
+        expect(first.block == heavyName1 || first.block == heavyName2) << std::format("moved {}, expected one of the blocks that got expensive", first.block);
+        expect(eq(first.from, heavyWorker));
+        expect(neq(first.to, heavyWorker)) << "the block must move to the other worker";
+    };
+
+    "work quantum batches small inputs into fewer, larger work calls"_test = [] {
+        using Scheduler               = gr::incubator::scheduler::BlockingBackoff<>;
+        constexpr gr::Size_t nSamples = 100'000U; // not a multiple of the quantum, the tail is flushed by the deadline
+
+        struct CopyStats {
+            std::uint64_t workCalls     = 0U;
+            std::uint64_t performedWork = 0U;
+        };
+        const auto run = [](bool batched) {
+            gr::Graph graph;
+            auto&     source = graph.emplaceBlock<ChunkedSource<float>>(gr::property_map{{"n_samples", nSamples}, {"chunk", gr::Size_t(64)}});
+            auto&     copy   = graph.emplaceBlock<gr::testing::Copy<float>>();
+            auto&     sink   = graph.emplaceBlock<gr::testing::CountingSink<float>>(gr::property_map{{"n_samples_max", nSamples}});
+
+            expect(graph.connect<"out", "in">(source, copy).has_value());
+            expect(graph.connect<"out", "in">(copy, sink).has_value());
+
+            gr::property_map minWorkItems;
+            if (batched) {
+                minWorkItems.insert_or_assign(std::pmr::string(copy.unique_name), gr::pmt::Value(gr::Size_t(1024)));
+                minWorkItems.insert_or_assign(std::pmr::string(sink.unique_name), gr::pmt::Value(gr::Size_t(1024)));
+            }
+
+            Scheduler scheduler;
+            scheduler.worker_threads    = gr::Size_t(1); // one pass runs source, copy and sink in turn, so unbatched copies see single source chunks
+            scheduler.enable_telemetry  = true;
+            scheduler.min_work_items    = minWorkItems;
+            scheduler.max_work_delay_us = gr::Size_t(200);
+            if (auto result = scheduler.exchange(std::move(graph)); !result) {
+                expect(false) << std::format("could not initialise scheduler: {}", result.error()) << fatal;
+            }
+
+            expect(scheduler.runAndWait().has_value());
+            expect(eq(sink.count.value, nSamples));
+
+            const auto telemetry = scheduler.telemetry();
+            const auto entry     = std::ranges::find(telemetry.blocks, std::string(copy.unique_name), &Scheduler::BlockTelemetry::name);
+            expect(entry != telemetry.blocks.end()) << fatal;
+            return CopyStats{.workCalls = entry->workCalls, .performedWork = entry->performedWork};
+        };
+
+        const CopyStats unbatched = run(false);
+        const CopyStats batched   = run(true);
+        expect(gt(batched.workCalls, 0U));
+        expect(lt(batched.workCalls, unbatched.workCalls)) << "held-back inputs must be merged into fewer work() calls";
+        const double unbatchedSize = static_cast<double>(unbatched.performedWork) / static_cast<double>(unbatched.workCalls);
+        const double batchedSize   = static_cast<double>(batched.performedWork) / static_cast<double>(batched.workCalls);
+        expect(gt(batchedSize, 4.0 * unbatchedSize)) << std::format("samples per work() call: {} batched vs {} unbatched", batchedSize, unbatchedSize);
+    };
 };
 
 int main() { return boost::ut::cfg<boost::ut::override>.run(); }